@@ -1,6 +1,9 @@
 #ifndef ZFINDER_ACCEPTANCESETTER_H_
 #define ZFINDER_ACCEPTANCESETTER_H_
 
+// Standard Library
+#include <string>  // std::string
+
 // ZFinder Code
 #include "SetterBase.h"  // SetterBase
 
@@ -15,6 +18,10 @@ namespace zf {
             // all electrons using the SetCut_ method
             void SetCuts(ZFinderEvent* zf_event);
 
+            // The largest |eta| that passes the acceptance cut CUT (for
+            // example "acc(MUON_TIGHT)"), or -1 if it does not limit eta
+            static double MaximumAbsEta(const std::string& CUT);
+
         protected:
             void SetCut_(ZFinderElectron* zf_elec);
 
@@ -0,0 +1,95 @@
+#ifndef ZFINDER_ASYNCTREEWRITER_H_
+#define ZFINDER_ASYNCTREEWRITER_H_
+
+// Standard Library
+#include <atomic>  // std::atomic
+#include <condition_variable>  // std::condition_variable
+#include <cstddef>  // size_t
+#include <functional>  // std::function
+#include <mutex>  // std::mutex
+#include <thread>  // std::thread
+#include <vector>  // std::vector
+
+// ROOT
+#include "TFile.h"  // TFile
+#include "TTree.h"  // TTree
+
+
+namespace zf {
+    /* Moves TTree::Fill, and with it the basket compression and file
+     * writes, off of the event loop. Each tree registers the block of memory
+     * its branches read from. Fill copies that block into a fixed size ring
+     * buffer and returns; a single I/O thread copies it back and calls
+     * TTree::Fill. Fill only waits if the ring is full.
+     *
+     * Data whose size changes from row to row can be queued with the row as
+     * a block of bytes. The I/O thread passes it to the function given to
+     * AddTree, which copies it to wherever the branches read it from, before
+     * filling the tree.
+     *
+     * After the first call to Fill, the registered trees must only be
+     * touched by the I/O thread until Flush returns.
+     */
+    class AsyncTreeWriter {
+        public:
+            // Constructor; N_SLOTS rows are buffered at most
+            explicit AsyncTreeWriter(const size_t N_SLOTS = 1024);
+
+            // destructor, calls Flush
+            ~AsyncTreeWriter();
+
+            // Called on the I/O thread with the extra data of a row
+            typedef std::function<void(const std::vector<char>&)> extra_function;
+
+            // Register a tree whose branches read from the ROW_SIZE bytes at
+            // tree_row, and optionally a function for the extra data of its
+            // rows. Returns the ID to pass to Fill. Must be called before the
+            // first Fill.
+            int AddTree(TTree* tree, void* tree_row, const size_t ROW_SIZE, const extra_function& SET_EXTRA = extra_function());
+
+            // Queue a copy of ROW (ROW_SIZE bytes, as given to AddTree), and
+            // of EXTRA if it is not null, to be filled into the tree TREE_ID
+            void Fill(const int TREE_ID, const void* ROW, const std::vector<char>* EXTRA = nullptr);
+
+            // Wait until every queued row has been filled and stop the I/O
+            // thread. Later calls to Fill are done synchronously.
+            void Flush();
+
+        protected:
+            struct tree_info {
+                TTree* tree;
+                void* tree_row;
+                size_t row_size;
+                extra_function set_extra;
+            };
+            std::vector<tree_info> trees_;
+
+            // The ring buffer. Slot i starts at buffer_[i * slot_size_] and
+            // holds the tree ID followed by its row. head_ is only written by
+            // the event thread and tail_ only by the I/O thread.
+            static constexpr size_t HEADER_SIZE_ = 8;
+            const size_t N_SLOTS_;
+            size_t slot_size_;
+            std::vector<char> buffer_;
+            // The extra data of each slot. The vectors keep their memory, so
+            // once they have grown copying into them does not allocate.
+            std::vector<std::vector<char> > extras_;
+            std::atomic<size_t> head_;
+            std::atomic<size_t> tail_;
+
+            // Used to sleep when the ring is empty (I/O thread) or full
+            // (event thread)
+            std::mutex mutex_;
+            std::condition_variable not_empty_;
+            std::condition_variable not_full_;
+            std::atomic<bool> stop_;
+            bool running_;
+            bool flushed_;
+            std::thread thread_;
+
+            void Start();
+            void Run();
+            void FillTree(const int TREE_ID, const void* ROW, const std::vector<char>& EXTRA);
+    };
+}  // namespace zf
+#endif  // ZFINDER_ASYNCTREEWRITER_H_
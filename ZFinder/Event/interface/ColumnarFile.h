@@ -0,0 +1,594 @@
+#ifndef ZFINDER_COLUMNARFILE_H_
+#define ZFINDER_COLUMNARFILE_H_
+
+// Standard Library
+#include <algorithm>  // std::min, std::stable_sort, std::upper_bound
+#include <cstdint>  // uint32_t, uint64_t
+#include <cstdio>  // FILE, fopen, fwrite, tmpfile
+#include <cstring>  // memcmp, memcpy, strncpy
+#include <stdexcept>  // std::runtime_error
+#include <string>  // std::string
+#include <vector>  // std::vector
+
+// POSIX
+#include <fcntl.h>  // open
+#include <sys/mman.h>  // mmap, munmap, madvise
+#include <sys/stat.h>  // fstat
+#include <unistd.h>  // close
+
+
+namespace zf {
+
+    /* A simple columnar file for ZDefinition tuples, which can be read by
+     * mapping it into memory and does not need ROOT. It is written by
+     * ZDefinitionTree (with tree_columnar_dir set) and by
+     * scripts/columnar/zdef_to_columns.
+     *
+     * The file starts with a columnar_header, then n_columns
+     * columnar_column descriptions, then n_row_groups columnar_row_group.
+     * The data of each column follows, starting on a 64 byte boundary: one
+     * contiguous array of n_values values of its type. A column with a
+     * width of N has N values per row, so row i is values [i * N, (i + 1) *
+     * N). A column with a width of 0 has a variable number of values per
+     * row, and also an array of n_rows + 1 uint64_t offsets; row i is values
+     * [offsets[i], offsets[i + 1]).
+     *
+     * If the file was written grouped by run, its rows are sorted by run and
+     * each row group holds the rows of one run. Otherwise there are no row
+     * groups.
+     *
+     * Numbers are stored in the byte order of the machine that wrote the
+     * file; the reader refuses files with the other byte order.
+     */
+    static const char COLUMNAR_MAGIC[8] = {'Z', 'F', 'C', 'O', 'L', 'U', 'M', 'N'};
+    static constexpr uint32_t COLUMNAR_VERSION = 1;
+    static constexpr uint32_t COLUMNAR_BYTE_ORDER = 0x01020304;
+    static constexpr uint64_t COLUMNAR_ALIGNMENT = 64;
+
+    enum ColumnType {
+        COLUMN_DOUBLE = 0,
+        COLUMN_FLOAT = 1,
+        COLUMN_INT = 2,
+        COLUMN_UINT = 3,
+        COLUMN_BOOL = 4,
+        COLUMN_LONG = 5
+    };
+
+    template <typename T> struct ColumnTraits;
+    template <> struct ColumnTraits<double> { static constexpr uint32_t TYPE = COLUMN_DOUBLE; };
+    template <> struct ColumnTraits<float> { static constexpr uint32_t TYPE = COLUMN_FLOAT; };
+    template <> struct ColumnTraits<int32_t> { static constexpr uint32_t TYPE = COLUMN_INT; };
+    template <> struct ColumnTraits<uint32_t> { static constexpr uint32_t TYPE = COLUMN_UINT; };
+    template <> struct ColumnTraits<bool> { static constexpr uint32_t TYPE = COLUMN_BOOL; };
+    template <> struct ColumnTraits<int64_t> { static constexpr uint32_t TYPE = COLUMN_LONG; };
+
+    struct columnar_header {
+        char magic[8];
+        uint32_t version;
+        uint32_t byte_order;
+        uint64_t n_rows;
+        uint32_t n_columns;
+        uint32_t n_row_groups;
+    };
+
+    struct columnar_column {
+        char name[64];
+        uint32_t type;  // ColumnType
+        uint32_t width;  // Values per row, 0 if variable
+        uint64_t n_values;
+        uint64_t data_offset;  // From the start of the file
+        uint64_t row_offsets_offset;  // 0 if the width is not 0
+    };
+
+    struct columnar_row_group {
+        uint32_t run;
+        uint32_t padding;
+        uint64_t first_row;
+        uint64_t n_rows;
+    };
+
+    static_assert(sizeof(columnar_header) == 32, "columnar_header is not packed");
+    static_assert(sizeof(columnar_column) == 96, "columnar_column is not packed");
+    static_assert(sizeof(columnar_row_group) == 24, "columnar_row_group is not packed");
+
+    inline size_t ColumnTypeSize(const uint32_t TYPE) {
+        switch (TYPE) {
+            case COLUMN_DOUBLE: return sizeof(double);
+            case COLUMN_FLOAT: return sizeof(float);
+            case COLUMN_INT: return sizeof(int32_t);
+            case COLUMN_UINT: return sizeof(uint32_t);
+            case COLUMN_BOOL: return sizeof(bool);
+            case COLUMN_LONG: return sizeof(int64_t);
+        }
+        throw std::runtime_error("Unknown column type");
+    }
+
+    /* Writes a columnar file. Rows are collected in memory, one buffer per
+     * column, and every CHUNK_SIZE bytes the buffers are appended to a
+     * temporary file as a chunk, so the memory used does not grow with the
+     * number of rows. Write copies each column out of the chunks into the
+     * file.
+     */
+    class ColumnarWriter {
+        public:
+            explicit ColumnarWriter(const size_t CHUNK_SIZE = 16 << 20) :
+                CHUNK_SIZE_(CHUNK_SIZE),
+                n_rows_(0),
+                spilled_rows_(0),
+                chunk_bytes_(0),
+                spill_(nullptr),
+                spill_size_(0)
+            {}
+
+            ~ColumnarWriter() {
+                if (spill_ != nullptr) {
+                    fclose(spill_);
+                }
+            }
+
+            // Add a column with WIDTH values per row, or a variable number if
+            // WIDTH is 0. Returns the index used by Append.
+            template <typename T>
+            int AddColumn(const std::string& NAME, const uint32_t WIDTH = 1) {
+                if (n_rows_ != 0) {
+                    throw std::runtime_error("Columns can not be added after the first row");
+                }
+                if (NAME.size() >= sizeof(columnar_column().name)) {
+                    throw std::runtime_error("The column name " + NAME + " is too long");
+                }
+                column col;
+                col.name = NAME;
+                col.type = ColumnTraits<T>::TYPE;
+                col.width = WIDTH;
+                col.n_values = 0;
+                col.row_values = 0;
+                columns_.push_back(col);
+                return columns_.size() - 1;
+            }
+
+            // Add N values to the current row of a column
+            template <typename T>
+            void Append(const int COLUMN, const T* VALUES, const size_t N = 1) {
+                column& col = columns_.at(COLUMN);
+                if (col.type != ColumnTraits<T>::TYPE) {
+                    throw std::runtime_error("Wrong type for the column " + col.name);
+                }
+                const char* BYTES = reinterpret_cast<const char*>(VALUES);
+                col.data.insert(col.data.end(), BYTES, BYTES + N * sizeof(T));
+                col.row_values += N;
+                chunk_bytes_ += N * sizeof(T);
+            }
+
+            template <typename T>
+            void Append(const int COLUMN, const T VALUE) {
+                Append(COLUMN, &VALUE, 1);
+            }
+
+            // Finish the current row, which belongs to RUN
+            void EndRow(const uint32_t RUN = 0) {
+                for (auto& i_col : columns_) {
+                    if (i_col.width != 0 && i_col.row_values != i_col.width) {
+                        throw std::runtime_error("Wrong number of values in the column " + i_col.name);
+                    }
+                    if (i_col.width == 0) {
+                        i_col.row_starts.push_back(i_col.n_values);
+                        chunk_bytes_ += sizeof(uint64_t);
+                    }
+                    i_col.n_values += i_col.row_values;
+                    i_col.row_values = 0;
+                }
+                // Consecutive rows of the same run are kept as one segment
+                if (segments_.empty() || segments_.back().run != RUN) {
+                    columnar_row_group segment;
+                    segment.run = RUN;
+                    segment.padding = 0;
+                    segment.first_row = n_rows_;
+                    segment.n_rows = 0;
+                    segments_.push_back(segment);
+                }
+                ++segments_.back().n_rows;
+                ++n_rows_;
+                if (chunk_bytes_ >= CHUNK_SIZE_) {
+                    SpillChunk();
+                }
+            }
+
+            uint64_t NRows() const { return n_rows_; }
+
+            // Write the file. With GROUP_BY_RUN the rows are sorted by run
+            // (keeping their order within a run) and a row group is written
+            // for every run.
+            void Write(const std::string& PATH, const bool GROUP_BY_RUN = false) {
+                SpillChunk();
+
+                // The order to write the segments of rows in
+                std::vector<columnar_row_group> order = segments_;
+                std::vector<columnar_row_group> groups;
+                if (GROUP_BY_RUN) {
+                    std::stable_sort(order.begin(), order.end(), RunLess);
+                    uint64_t row = 0;
+                    for (auto& i_segment : order) {
+                        if (groups.empty() || groups.back().run != i_segment.run) {
+                            columnar_row_group group;
+                            group.run = i_segment.run;
+                            group.padding = 0;
+                            group.first_row = row;
+                            group.n_rows = 0;
+                            groups.push_back(group);
+                        }
+                        groups.back().n_rows += i_segment.n_rows;
+                        row += i_segment.n_rows;
+                    }
+                }
+
+                // Lay out the data
+                columnar_header header;
+                memcpy(header.magic, COLUMNAR_MAGIC, sizeof(header.magic));
+                header.version = COLUMNAR_VERSION;
+                header.byte_order = COLUMNAR_BYTE_ORDER;
+                header.n_rows = n_rows_;
+                header.n_columns = columns_.size();
+                header.n_row_groups = groups.size();
+
+                uint64_t offset = sizeof(header)
+                    + columns_.size() * sizeof(columnar_column)
+                    + groups.size() * sizeof(columnar_row_group);
+                std::vector<columnar_column> descriptions;
+                for (auto& i_col : columns_) {
+                    columnar_column desc;
+                    memset(desc.name, 0, sizeof(desc.name));
+                    strncpy(desc.name, i_col.name.c_str(), sizeof(desc.name) - 1);
+                    desc.type = i_col.type;
+                    desc.width = i_col.width;
+                    desc.n_values = i_col.n_values;
+                    offset = Align(offset);
+                    desc.data_offset = offset;
+                    offset += i_col.n_values * ColumnTypeSize(i_col.type);
+                    desc.row_offsets_offset = 0;
+                    if (i_col.width == 0) {
+                        offset = Align(offset);
+                        desc.row_offsets_offset = offset;
+                        offset += (n_rows_ + 1) * sizeof(uint64_t);
+                    }
+                    descriptions.push_back(desc);
+                }
+
+                FILE* file = fopen(PATH.c_str(), "wb");
+                if (file == nullptr) {
+                    throw std::runtime_error("Can not open " + PATH + " for writing");
+                }
+                uint64_t position = 0;
+                WriteBytes(file, &header, sizeof(header), &position);
+                if (!descriptions.empty()) {
+                    WriteBytes(file, &descriptions[0], descriptions.size() * sizeof(columnar_column), &position);
+                }
+                if (!groups.empty()) {
+                    WriteBytes(file, &groups[0], groups.size() * sizeof(columnar_row_group), &position);
+                }
+                std::vector<char> buffer(COPY_SIZE_);
+                for (size_t i_col = 0; i_col < columns_.size(); ++i_col) {
+                    const column& COL = columns_[i_col];
+                    Pad(file, descriptions[i_col].data_offset, &position);
+                    // The values of a segment are contiguous
+                    for (auto& i_segment : order) {
+                        const uint64_t FIRST = RowStart(COL, i_segment.first_row);
+                        const uint64_t LAST = RowStart(COL, i_segment.first_row + i_segment.n_rows);
+                        CopyValues(COL, FindChunk(i_segment.first_row), FIRST, LAST, file, &position, &buffer);
+                    }
+                    if (COL.width == 0) {
+                        // The offsets of the rows in their new order
+                        Pad(file, descriptions[i_col].row_offsets_offset, &position);
+                        uint64_t start = 0;
+                        std::vector<uint64_t> offsets;
+                        for (auto& i_segment : order) {
+                            const uint64_t SHIFT = RowStart(COL, i_segment.first_row);
+                            for (uint64_t i_row = 0; i_row < i_segment.n_rows; i_row += offsets.size()) {
+                                ReadRowStarts(COL, i_segment.first_row + i_row, i_segment.n_rows - i_row, &offsets);
+                                for (auto& i_offset : offsets) {
+                                    i_offset = i_offset - SHIFT + start;
+                                }
+                                WriteBytes(file, &offsets[0], offsets.size() * sizeof(uint64_t), &position);
+                            }
+                            start += RowStart(COL, i_segment.first_row + i_segment.n_rows) - SHIFT;
+                        }
+                        WriteBytes(file, &start, sizeof(start), &position);
+                    }
+                }
+                if (fclose(file) != 0) {
+                    throw std::runtime_error("Failed to write " + PATH);
+                }
+            }
+
+        protected:
+            // The most bytes read from the temporary file at once
+            static const size_t COPY_SIZE_ = 1 << 20;
+
+            // Where a column's part of a chunk is in the temporary file
+            struct chunk_piece {
+                uint64_t first_value;
+                uint64_t n_values;
+                uint64_t data_position;
+                uint64_t row_starts_position;  // Only for a variable width
+            };
+
+            struct column {
+                std::string name;
+                uint32_t type;
+                uint32_t width;
+                uint64_t n_values;  // In finished rows
+                uint64_t row_values;  // In the current row
+                // The values of the chunk in memory, and for a variable
+                // width the index of the first value of each of its rows
+                std::vector<char> data;
+                std::vector<uint64_t> row_starts;
+                std::vector<chunk_piece> pieces;
+            };
+            const size_t CHUNK_SIZE_;
+            std::vector<column> columns_;
+            // Runs of consecutive rows with the same run number
+            std::vector<columnar_row_group> segments_;
+            uint64_t n_rows_;
+            // The first row of each chunk in the temporary file
+            std::vector<uint64_t> chunk_rows_;
+            uint64_t spilled_rows_;
+            uint64_t chunk_bytes_;
+            FILE* spill_;
+            uint64_t spill_size_;
+
+            // The temporary file belongs to the writer
+            ColumnarWriter(const ColumnarWriter&);
+            ColumnarWriter& operator=(const ColumnarWriter&);
+
+            static bool RunLess(const columnar_row_group& A, const columnar_row_group& B) { return A.run < B.run; }
+
+            void SpillChunk() {
+                if (spilled_rows_ == n_rows_) {
+                    return;
+                }
+                if (spill_ == nullptr) {
+                    spill_ = tmpfile();
+                    if (spill_ == nullptr) {
+                        throw std::runtime_error("Can not open a temporary file for a columnar file");
+                    }
+                }
+                chunk_rows_.push_back(spilled_rows_);
+                for (auto& i_col : columns_) {
+                    chunk_piece piece;
+                    piece.n_values = i_col.data.size() / ColumnTypeSize(i_col.type);
+                    piece.first_value = i_col.n_values - piece.n_values;
+                    piece.data_position = spill_size_;
+                    if (!i_col.data.empty()) {
+                        WriteBytes(spill_, &i_col.data[0], i_col.data.size(), &spill_size_);
+                    }
+                    piece.row_starts_position = spill_size_;
+                    if (!i_col.row_starts.empty()) {
+                        WriteBytes(spill_, &i_col.row_starts[0], i_col.row_starts.size() * sizeof(uint64_t), &spill_size_);
+                    }
+                    i_col.pieces.push_back(piece);
+                    i_col.data.clear();
+                    i_col.row_starts.clear();
+                }
+                chunk_bytes_ = 0;
+                spilled_rows_ = n_rows_;
+            }
+
+            uint64_t ChunkRows(const size_t CHUNK) const {
+                return (CHUNK + 1 < chunk_rows_.size() ? chunk_rows_[CHUNK + 1] : n_rows_) - chunk_rows_[CHUNK];
+            }
+
+            // The chunk holding ROW
+            size_t FindChunk(const uint64_t ROW) const {
+                return std::upper_bound(chunk_rows_.begin(), chunk_rows_.end(), ROW) - chunk_rows_.begin() - 1;
+            }
+
+            // The index of the first value of ROW, or the number of values
+            // if ROW is the number of rows
+            uint64_t RowStart(const column& COL, const uint64_t ROW) const {
+                if (COL.width != 0) {
+                    return ROW * COL.width;
+                }
+                if (ROW == n_rows_) {
+                    return COL.n_values;
+                }
+                std::vector<uint64_t> start;
+                ReadRowStarts(COL, ROW, 1, &start);
+                return start[0];
+            }
+
+            // The starts of up to N rows from FIRST, within one chunk
+            void ReadRowStarts(const column& COL, const uint64_t FIRST, const uint64_t N, std::vector<uint64_t>* starts) const {
+                const size_t CHUNK = FindChunk(FIRST);
+                const uint64_t IN_CHUNK = FIRST - chunk_rows_[CHUNK];
+                const uint64_t COUNT = std::min<uint64_t>(std::min<uint64_t>(N, ChunkRows(CHUNK) - IN_CHUNK), COPY_SIZE_ / sizeof(uint64_t));
+                starts->resize(COUNT);
+                ReadAt(COL.pieces[CHUNK].row_starts_position + IN_CHUNK * sizeof(uint64_t), &(*starts)[0], COUNT * sizeof(uint64_t));
+            }
+
+            // Copy the values [FIRST, LAST) of a column, which start in
+            // CHUNK or later, to FILE
+            void CopyValues(const column& COL, size_t chunk, uint64_t first, const uint64_t LAST, FILE* file, uint64_t* position, std::vector<char>* buffer) const {
+                const size_t VALUE_SIZE = ColumnTypeSize(COL.type);
+                while (first < LAST) {
+                    while (first >= COL.pieces[chunk].first_value + COL.pieces[chunk].n_values) {
+                        ++chunk;
+                    }
+                    const chunk_piece& PIECE = COL.pieces[chunk];
+                    const uint64_t END = std::min(LAST, PIECE.first_value + PIECE.n_values);
+                    const uint64_t N = std::min<uint64_t>(END - first, buffer->size() / VALUE_SIZE);
+                    ReadAt(PIECE.data_position + (first - PIECE.first_value) * VALUE_SIZE, &(*buffer)[0], N * VALUE_SIZE);
+                    WriteBytes(file, &(*buffer)[0], N * VALUE_SIZE, position);
+                    first += N;
+                }
+            }
+
+            void ReadAt(const uint64_t POSITION, void* data, const size_t SIZE) const {
+                if (fseeko(spill_, POSITION, SEEK_SET) != 0 || fread(data, 1, SIZE, spill_) != SIZE) {
+                    throw std::runtime_error("Failed to read the temporary file of a columnar file");
+                }
+            }
+
+            static uint64_t Align(const uint64_t OFFSET) {
+                return (OFFSET + COLUMNAR_ALIGNMENT - 1) / COLUMNAR_ALIGNMENT * COLUMNAR_ALIGNMENT;
+            }
+
+            static void WriteBytes(FILE* file, const void* data, const size_t SIZE, uint64_t* position) {
+                if (fwrite(data, 1, SIZE, file) != SIZE) {
+                    throw std::runtime_error("Failed to write a columnar file");
+                }
+                *position += SIZE;
+            }
+
+            static void Pad(FILE* file, const uint64_t OFFSET, uint64_t* position) {
+                static const char ZEROS[COLUMNAR_ALIGNMENT] = {0};
+                if (OFFSET > *position) {
+                    WriteBytes(file, ZEROS, OFFSET - *position, position);
+                }
+            }
+    };
+
+    /* The values of one column in a mapped file. For a column with a
+     * variable width, Row and RowSize use the row offsets.
+     */
+    template <typename T>
+    struct column_span {
+        const T* data;
+        uint64_t size;  // Number of values
+        uint32_t width;
+        const uint64_t* row_offsets;  // nullptr unless width is 0
+
+        const T* begin() const { return data; }
+        const T* end() const { return data + size; }
+        const T& operator[](const uint64_t I) const { return data[I]; }
+
+        // The values of row I
+        const T* Row(const uint64_t I) const {
+            return data + (row_offsets != nullptr ? row_offsets[I] : I * width);
+        }
+        uint64_t RowSize(const uint64_t I) const {
+            return row_offsets != nullptr ? row_offsets[I + 1] - row_offsets[I] : width;
+        }
+    };
+
+    /* Maps a file written by ColumnarWriter read only into memory. The
+     * spans returned by Column point into the mapping, so they are valid
+     * while the ColumnarFile exists.
+     */
+    class ColumnarFile {
+        public:
+            explicit ColumnarFile(const std::string& PATH) : path_(PATH), base_(nullptr), size_(0) {
+                const int FD = open(PATH.c_str(), O_RDONLY);
+                if (FD < 0) {
+                    throw std::runtime_error("Can not open " + PATH);
+                }
+                struct stat info;
+                if (fstat(FD, &info) != 0 || static_cast<uint64_t>(info.st_size) < sizeof(columnar_header)) {
+                    close(FD);
+                    throw std::runtime_error(PATH + " is not a columnar file");
+                }
+                size_ = info.st_size;
+                void* mapping = mmap(nullptr, size_, PROT_READ, MAP_SHARED, FD, 0);
+                close(FD);
+                if (mapping == MAP_FAILED) {
+                    throw std::runtime_error("Can not map " + PATH);
+                }
+                base_ = static_cast<const char*>(mapping);
+                // Columns are usually scanned from start to end
+                madvise(mapping, size_, MADV_SEQUENTIAL);
+
+                header_ = reinterpret_cast<const columnar_header*>(base_);
+                if (memcmp(header_->magic, COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC)) != 0
+                        || header_->byte_order != COLUMNAR_BYTE_ORDER
+                        || header_->version != COLUMNAR_VERSION) {
+                    Unmap();
+                    throw std::runtime_error(PATH + " is not a columnar file of this version and byte order");
+                }
+                const uint64_t TABLES_SIZE = sizeof(columnar_header)
+                    + header_->n_columns * sizeof(columnar_column)
+                    + header_->n_row_groups * sizeof(columnar_row_group);
+                if (TABLES_SIZE > size_) {
+                    Unmap();
+                    throw std::runtime_error(PATH + " is truncated");
+                }
+                columns_ = reinterpret_cast<const columnar_column*>(base_ + sizeof(columnar_header));
+                groups_ = reinterpret_cast<const columnar_row_group*>(columns_ + header_->n_columns);
+                for (uint32_t i = 0; i < header_->n_columns; ++i) {
+                    const columnar_column& COL = columns_[i];
+                    const uint64_t DATA_END = COL.data_offset + COL.n_values * ColumnTypeSize(COL.type);
+                    const uint64_t OFFSETS_END = COL.row_offsets_offset + (header_->n_rows + 1) * sizeof(uint64_t);
+                    if (DATA_END > size_ || (COL.width == 0 && OFFSETS_END > size_)) {
+                        Unmap();
+                        throw std::runtime_error(PATH + " is truncated");
+                    }
+                }
+            }
+
+            ~ColumnarFile() {
+                Unmap();
+            }
+
+            uint64_t NRows() const { return header_->n_rows; }
+            uint32_t NColumns() const { return header_->n_columns; }
+            const columnar_column& ColumnInfo(const uint32_t I) const { return columns_[I]; }
+
+            bool HasColumn(const std::string& NAME) const {
+                return Find(NAME) != nullptr;
+            }
+
+            // Throws if there is no such column, or it has another type
+            template <typename T>
+            column_span<T> Column(const std::string& NAME) const {
+                const columnar_column* col = Find(NAME);
+                if (col == nullptr) {
+                    throw std::runtime_error(path_ + " has no column " + NAME);
+                }
+                if (col->type != ColumnTraits<T>::TYPE) {
+                    throw std::runtime_error("Wrong type for the column " + NAME);
+                }
+                column_span<T> span;
+                span.data = reinterpret_cast<const T*>(base_ + col->data_offset);
+                span.size = col->n_values;
+                span.width = col->width;
+                span.row_offsets = nullptr;
+                if (col->width == 0) {
+                    span.row_offsets = reinterpret_cast<const uint64_t*>(base_ + col->row_offsets_offset);
+                }
+                return span;
+            }
+
+            // Empty if the file was not grouped by run
+            std::vector<columnar_row_group> RowGroups() const {
+                return std::vector<columnar_row_group>(groups_, groups_ + header_->n_row_groups);
+            }
+
+        protected:
+            const std::string path_;
+            const char* base_;
+            uint64_t size_;
+            const columnar_header* header_;
+            const columnar_column* columns_;
+            const columnar_row_group* groups_;
+
+            const columnar_column* Find(const std::string& NAME) const {
+                for (uint32_t i = 0; i < header_->n_columns; ++i) {
+                    if (strncmp(columns_[i].name, NAME.c_str(), sizeof(columns_[i].name)) == 0) {
+                        return &columns_[i];
+                    }
+                }
+                return nullptr;
+            }
+
+            void Unmap() {
+                if (base_ != nullptr) {
+                    munmap(const_cast<char*>(base_), size_);
+                    base_ = nullptr;
+                }
+            }
+
+        private:
+            // The mapping can not be shared
+            ColumnarFile(const ColumnarFile&);
+            ColumnarFile& operator=(const ColumnarFile&);
+    };
+
+}  // namespace zf
+#endif  // ZFINDER_COLUMNARFILE_H_
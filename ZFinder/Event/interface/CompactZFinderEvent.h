@@ -0,0 +1,128 @@
+#ifndef ZFINDER_COMPACTZFINDEREVENT_H_
+#define ZFINDER_COMPACTZFINDEREVENT_H_
+
+// Standard Library
+#include <string>  // std::string
+#include <vector>  // std::vector
+
+// ZFinder
+#include "ZFinder/Event/interface/CutBits.h"  // CUT_BIT_NAMES, CutBitIndex
+
+
+namespace zf {
+
+    /*
+     * A flat copy of a ZFinderElectron that can be stored in the edm::Event.
+     * Cut results are stored as bitmasks over CUT_BIT_NAMES (see CutBits.h),
+     * so cuts that are not in that table are not kept.
+     */
+    struct CompactElectron {
+        CompactElectron() :
+            type(-1), charge(0),
+            pt(-1), eta(-10), phi(-10),
+            born_pt(-1), born_eta(-10), born_phi(-10),
+            naked_pt(-1), naked_eta(-10), naked_phi(-10),
+            sc_eta(-10), sc_phi(-10), r9(-1),
+            sigma_ieta_ieta(-1), h_over_e(-1), deta_in(-1), dphi_in(-1),
+            track_iso(-1), ecal_iso(-1), hcal_iso(-1),
+            one_over_e_mins_one_over_p(-1),
+            d0(-1), dz(-1), pf_iso(-1), missing_hits(-1),
+            has_conversion(false), is_eb(false), is_ee(false),
+            cut_bits(0), cut_known(0),
+            cut_weights(N_WEIGHTED_CUTS, 1.)
+        {}
+
+        // Same return values as ZFinderElectron::CutPassed
+        int CutPassed(const std::string& CUT_NAME) const {
+            const int BIT = CutBitIndex(CUT_BIT_NAMES, CUT_NAME);
+            if (BIT < 0 || !(cut_known & (1ULL << BIT))) {
+                return -1;
+            }
+            return (cut_bits & (1ULL << BIT)) ? 1 : 0;
+        }
+
+        int type;  // ElectronType
+        int charge;
+        double pt;
+        double eta;
+        double phi;
+        double born_pt;
+        double born_eta;
+        double born_phi;
+        double naked_pt;
+        double naked_eta;
+        double naked_phi;
+        double sc_eta;
+        double sc_phi;
+        float r9;
+        float sigma_ieta_ieta;
+        float h_over_e;
+        float deta_in;
+        float dphi_in;
+        float track_iso;
+        float ecal_iso;
+        float hcal_iso;
+        float one_over_e_mins_one_over_p;
+        float d0;
+        float dz;
+        float pf_iso;
+        int missing_hits;
+        bool has_conversion;
+        bool is_eb;
+        bool is_ee;
+        unsigned long long cut_bits;
+        unsigned long long cut_known;
+        std::vector<float> cut_weights;  // Indexed as CUT_BIT_WEIGHTED_NAMES
+    };
+
+    /*
+     * A flat copy of a ZFinderEvent, made once per event by
+     * ZFinderEventProducer and read back with the
+     * ZFinderEvent(const CompactZFinderEvent&) constructor.
+     */
+    struct CompactZFinderEvent {
+        CompactZFinderEvent() :
+            is_real_data(false),
+            run_num(0), lumi_num(0), event_num(0),
+            n_reco_electrons(-1),
+            e0(-1), e1(-1), e0_truth(-1), e1_truth(-1), e0_trig(-1), e1_trig(-1)
+        {}
+
+        bool is_real_data;
+        unsigned int run_num;
+        unsigned int lumi_num;
+        unsigned int event_num;
+
+        // Beamspot x, y, z, and the vertex num, true_num, x, y, z as in
+        // ZFinderEvent
+        std::vector<double> reco_bs;
+        std::vector<double> reco_vert;
+        std::vector<double> truth_vert;
+
+        // The members of ZFinderEvent::ZData in order
+        std::vector<double> reco_z;
+        std::vector<double> truth_z;
+
+        // Weights, in order: event_weight, weight_fsr, weight_vertex,
+        // weight_vertex_plus, weight_vertex_minus, weight_natural_mc
+        std::vector<double> weights;
+        std::vector<double> weights_cteq;
+        std::vector<double> weights_mstw;
+        std::vector<double> weights_nnpdf;
+
+        std::vector<CompactElectron> reco_electrons;
+        std::vector<CompactElectron> truth_electrons;
+        std::vector<CompactElectron> hlt_electrons;
+        int n_reco_electrons;
+
+        // Index of the special electrons in the vectors above, -1 if not set
+        int e0;
+        int e1;
+        int e0_truth;
+        int e1_truth;
+        int e0_trig;
+        int e1_trig;
+    };
+
+}  // namespace zf
+#endif  // ZFINDER_COMPACTZFINDEREVENT_H_
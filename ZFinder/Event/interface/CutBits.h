@@ -0,0 +1,111 @@
+#ifndef ZFINDER_CUTBITS_H_
+#define ZFINDER_CUTBITS_H_
+
+// Standard Library
+#include <string>  // std::string
+#include <vector>  // std::vector
+
+namespace zf {
+
+    /* The position of each cut in the per-electron cut bitmask written by
+     * ZElectronTree. These are all the cuts set by ZFinderEvent and the Setter
+     * classes. The bit for a cut is its index in this vector, so new cuts
+     * must be appended to the end or old tuples will be read incorrectly.
+     */
+    static const std::vector<std::string> CUT_BIT_NAMES = {
+        // Acceptance
+        "acc(ALL)",
+        "acc(DETECTOR)",
+        "acc(EB)",
+        "acc(EB+)",
+        "acc(EB-)",
+        "acc(EE)",
+        "acc(EE+)",
+        "acc(EE-)",
+        "acc(ET)",
+        "acc(ET+)",
+        "acc(ET-)",
+        "acc(HF)",
+        "acc(HF+)",
+        "acc(HF-)",
+        "acc(NT)",
+        "acc(NT+)",
+        "acc(NT-)",
+        "acc(MUON_TIGHT)",
+        "acc(MUON_TIGHT+)",
+        "acc(MUON_TIGHT-)",
+        "acc(MUON_LOOSE)",
+        "acc(MUON_LOOSE+)",
+        "acc(MUON_LOOSE-)",
+        // Truth matching
+        "dr(0.05)",
+        "dr(0.1)",
+        "dr(0.2)",
+        "dr(0.3)",
+        "dr(0.4)",
+        "dr(0.5)",
+        // Type
+        "type_gsf",
+        "type_gen",
+        "type_ecalcandidate",
+        "type_photon",
+        "type_hlt",
+        // Quality
+        "eg_veto",
+        "eg_loose",
+        "eg_medium",
+        "eg_tight",
+        "eg_eop_cut",
+        "eg_trigtight",
+        "eg_trigwp70",
+        "hf_e9e25",
+        "hf_2dtight",
+        "hf_2dmedium",
+        "hf_2dloose",
+        "nt_loose",
+        "nt_corrected",
+        // Trigger
+        "trig(et_et_tight)",
+        "trig(et_et_loose)",
+        "trig(et_et_dz)",
+        "trig(et_nt_etleg)",
+        "trig(et_hf_tight)",
+        "trig(et_hf_loose)",
+        "trig(single_ele)",
+        "trig(hf_loose)",
+        "trig(hf_tight)",
+    };
+
+    /* The cuts that carry a scale factor (see STR_TO_WEIGHTID). Only these
+     * have their weight stored, all others have a weight of 1.
+     */
+    static const std::vector<std::string> CUT_BIT_WEIGHTED_NAMES = {
+        "eg_veto",
+        "eg_loose",
+        "eg_medium",
+        "eg_tight",
+        "trig(single_ele)",
+        "type_gsf",
+    };
+
+    // The bitmask is stored in a 64 bit integer
+    static constexpr int MAX_CUT_BITS = 64;
+    static constexpr int N_WEIGHTED_CUTS = 6;
+
+    /* Return the position of a name in one of the above vectors, or -1 if it
+     * is not in it.
+     */
+    inline int CutBitIndex(
+            const std::vector<std::string>& NAMES,
+            const std::string& CUT_NAME
+            ) {
+        for (unsigned int i = 0; i < NAMES.size(); ++i) {
+            if (NAMES[i] == CUT_NAME) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+}  // namespace zf
+#endif  // ZFINDER_CUTBITS_H_
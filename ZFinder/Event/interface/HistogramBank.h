@@ -0,0 +1,127 @@
+#ifndef ZFINDER_HISTOGRAMBANK_H_
+#define ZFINDER_HISTOGRAMBANK_H_
+
+// Standard Library
+#include <string>  // std::string
+#include <vector>  // std::vector
+
+// CMSSW
+#include "CommonTools/UtilAlgos/interface/TFileService.h"
+
+
+namespace zf {
+    /* Holds a set of 1D and 2D histograms without making ROOT objects for
+     * them. Booking a histogram only saves its name, title, and binning; the
+     * storage for its bins is added to a single contiguous array the first
+     * time it is filled, so histograms that are never filled cost almost
+     * nothing. Write makes the TH1D and TH2D objects one at a time, writes
+     * them, and deletes them.
+     *
+     * Fill follows TH1::Fill and TH2::Fill: under and overflow bins, the
+     * number of entries, the statistics used for the mean and RMS, and the
+     * automatic Sumw2 when a weight other than 1 is used.
+     */
+    class HistogramBank {
+        public:
+            // Constructor
+            HistogramBank() {}
+
+            // Book histograms with the same arguments as the TH1D and TH2D
+            // constructors. Returns the ID used to fill the histogram.
+            int Book1D(
+                    const std::string& NAME,
+                    const std::string& TITLE,
+                    const int NBINS,
+                    const double LOW,
+                    const double HIGH
+                    );
+            int Book1D(
+                    const std::string& NAME,
+                    const std::string& TITLE,
+                    const int NBINS,
+                    const double* EDGES
+                    );
+            int Book2D(
+                    const std::string& NAME,
+                    const std::string& TITLE,
+                    const int NBINS_X,
+                    const double* EDGES_X,
+                    const int NBINS_Y,
+                    const double* EDGES_Y
+                    );
+
+            // Axis titles
+            void SetXTitle(const int ID, const std::string& TITLE);
+            void SetYTitle(const int ID, const std::string& TITLE);
+
+            // The cell an entry goes in, found once so that the same values
+            // can be filled into several histograms with the same binning,
+            // or into several banks that booked the same histograms in the
+            // same order
+            struct entry {
+                int id;
+                int cell;
+                bool in_range;
+                double x;
+                double y;
+            };
+            typedef std::vector<entry> entry_vector;
+            entry MakeEntry(const int ID, const double X) const;
+            entry MakeEntry(const int ID, const double X, const double Y) const;
+
+            // Add an entry
+            void Fill(const int ID, const double X, const double WEIGHT = 1.);
+            void Fill(const int ID, const double X, const double Y, const double WEIGHT);
+            void Fill(const entry& ENTRY, const double WEIGHT);
+            void Fill(const entry_vector& ENTRIES, const double WEIGHT);
+
+            // Make every booked histogram in tdir, write it, and delete it
+            void Write(TFileDirectory& tdir);
+
+            // Release the bin storage, emptying every histogram
+            void Clear();
+
+            // Number of doubles currently allocated for bins
+            size_t AllocatedSize() const { return bins_.size(); }
+
+        protected:
+            struct axis {
+                int nbins;
+                double low;
+                double high;
+                std::vector<double> edges;  // Empty for fixed width bins
+
+                // Same as TAxis::FindBin, 0 is underflow and nbins + 1 is
+                // overflow
+                int FindBin(const double X) const;
+            };
+
+            struct histogram {
+                std::string name;
+                std::string title;
+                std::string x_title;
+                std::string y_title;
+                bool is_2d;
+                axis x;
+                axis y;
+                // Start of the bins in bins_, -1 until the first Fill
+                long offset;
+                double entries;
+                bool has_sumw2;
+            };
+
+            std::vector<histogram> histograms_;
+
+            // Each filled histogram has, starting at its offset: the content
+            // of every cell (including under and overflow), the sum of the
+            // squared weights of every cell, and N_STATS_ statistics (sum w,
+            // w^2, w*x, w*x^2, w*y, w*y^2, w*x*y) as in TH1::GetStats
+            std::vector<double> bins_;
+            static constexpr int N_STATS_ = 7;
+
+            int Book(const histogram& HISTO);
+            int NCells(const histogram& HISTO) const;
+            double* Allocate(histogram& histo);
+    };
+}  // namespace zf
+#endif  // ZFINDER_HISTOGRAMBANK_H_
@@ -0,0 +1,39 @@
+#ifndef ZFINDER_WEIGHTCODING_H_
+#define ZFINDER_WEIGHTCODING_H_
+
+namespace zf {
+
+    /* Fixed point encoding of a systematic weight (for example a PDF
+     * member) as its ratio to a reference weight (the central member),
+     * stored in 16 bits as round(ratio * WEIGHT_RATIO_SCALE).
+     *
+     * Ratios in [0, WEIGHT_RATIO_MAX] are decoded to within
+     * WEIGHT_RATIO_PRECISION (about 3e-5) of their true value, so the
+     * decoded weight is within WEIGHT_RATIO_PRECISION * |reference| of the
+     * original. Ratios outside this range are clamped to it. If the reference
+     * is 0 every ratio is stored as 0.
+     */
+    static constexpr double WEIGHT_RATIO_SCALE = 16384.;  // 2^14
+    static constexpr double WEIGHT_RATIO_MAX = 65535. / WEIGHT_RATIO_SCALE;
+    static constexpr double WEIGHT_RATIO_PRECISION = 0.5 / WEIGHT_RATIO_SCALE;
+
+    inline unsigned short EncodeWeightRatio(const double WEIGHT, const double REFERENCE) {
+        if (REFERENCE == 0.) {
+            return 0;
+        }
+        const double CODE = (WEIGHT / REFERENCE) * WEIGHT_RATIO_SCALE + 0.5;
+        if (!(CODE > 0.)) {  // Also catches NaN
+            return 0;
+        }
+        if (CODE >= 65535.) {
+            return 65535;
+        }
+        return static_cast<unsigned short>(CODE);
+    }
+
+    inline double DecodeWeightRatio(const unsigned short CODE, const double REFERENCE) {
+        return REFERENCE * (CODE / WEIGHT_RATIO_SCALE);
+    }
+
+}  // namespace zf
+#endif  // ZFINDER_WEIGHTCODING_H_
@@ -27,6 +27,20 @@ namespace zf {
 
             void ApplySelection(ZFinderEvent* zf_event);
 
+            // The tightest reco pt requirement in cut set I_CUTSET (0 for
+            // cuts0, 1 for cuts1), or 0 if there is none. An electron must
+            // have at least this pt to pass every level of that cut set.
+            double MinimumPt(const int I_CUTSET) const;
+
+            // The tightest upper bound on the reco |eta| in cut set I_CUTSET
+            // from its acceptance and "aeta" cuts, or -1 if there is none
+            double MaximumAbsEta(const int I_CUTSET) const;
+
+            // A string that is the same for two cut levels if and only if
+            // they apply the same selection. The pass flags and weights at
+            // level I_LEVEL depend only on the keys of levels 0 to I_LEVEL.
+            std::string CutLevelKey(const size_t I_LEVEL) const;
+
             // Making clv and NAME public so that other classes can find out about the
             // cuts it contains.
             cutlevel_vector clv;
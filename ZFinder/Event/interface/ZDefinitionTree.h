@@ -4,6 +4,7 @@
 // Standard Library
 #include <string>  // string
 #include <utility>  // pair
+#include <vector>  // vector
 
 // ROOT
 #include "TBranch.h"  // TBranch
@@ -14,18 +15,62 @@
 #include "CommonTools/UtilAlgos/interface/TFileService.h"
 
 // ZFinder Code
+#include "AsyncTreeWriter.h"  // AsyncTreeWriter
+#include "ColumnarFile.h"  // ColumnarWriter
 #include "ZDefinition.h"  // ZDefinition
 #include "ZFinderEvent.h"  // ZFinderEvent
+#include "ZTreeBranches.h"  // branch_struct, event_branch
 
 
 namespace zf {
     class ZDefinitionTree {
         public:
+            // How the branches are laid out on disk
+            struct TreeLayout {
+                TreeLayout() :
+                    split_branches(false),
+                    basket_size(32000),
+                    compression(-1),
+                    weight_compression(-1),
+                    compact_pdf_weights(false),
+                    event_index(false),
+                    columnar_dir(""),
+                    columnar_group_by_run(false)
+                {}
+
+                // Write one branch per variable ("reco_z_m", "reco_e_pt",
+                // ...) instead of the "reco", "truth", and "event_info"
+                // leaf-list branches
+                bool split_branches;
+                // Buffer size passed to TTree::Branch
+                int basket_size;
+                // TBranch::SetCompressionSettings for the kinematic and event
+                // branches, and for the weight and PDF branches. A negative
+                // value keeps the setting of the file.
+                int compression;
+                int weight_compression;
+                // Store the PDF weights as 16 bit ratios to the central
+                // member ("weights_cteq_ratio", see WeightCoding.h) plus the
+                // central member as a double ("weight_cteq_central")
+                bool compact_pdf_weights;
+                // Also write an "event_index" tree, with the entry of every
+                // event sorted by (run, lumi, event); see
+                // scripts/zdef_tree/event_index.h
+                bool event_index;
+                // If not empty, also write every tuple to a columnar file
+                // (see ColumnarFile.h) in this directory, named after the
+                // ZDefinition, optionally with its rows grouped by run
+                std::string columnar_dir;
+                bool columnar_group_by_run;
+            };
+
             // Constructor
             ZDefinitionTree(
                 const ZDefinition& zdef,
                 TFileDirectory& tdir,
-                const bool IS_MC = false
+                const bool IS_MC = false,
+                const TreeLayout& LAYOUT = TreeLayout(),
+                AsyncTreeWriter* writer = nullptr
             );
 
             // destructor
@@ -34,90 +79,103 @@ namespace zf {
             // Add event
             void Fill(const ZFinderEvent& zf_event);
 
+            // Sort and fill the "event_index" tree, if LAYOUT.event_index is
+            // set. Call once after the last Fill, and after
+            // AsyncTreeWriter::Flush, before the file is written.
+            void WriteIndex();
+
+            // Write the columnar file, if LAYOUT.columnar_dir is set. Call
+            // once after the last Fill.
+            void WriteColumns();
+
             // Wrapper around TTree::GetCurrentFile()
             TFile* GetCurrentFile();
 
+            // Append the (WeightID, weight) pairs of the scale factors used
+            // by a passing ZDefinition to weight_id_vector
+            static void GetCutWeights(
+                    cutlevel_vector const * const CUT_LEVEL_VECTOR,
+                    std::vector<std::pair<int, double>>* weight_id_vector
+                    );
+
         protected:
-            // Structs that map to the branches
-            struct branch_struct {
-                void clear_values() {
-                    z_m = -1;
-                    z_y = -10;
-                    z_phistar_born = -1;
-                    z_phistar_dressed = -1;
-                    z_phistar_naked = -1;
-                    z_phistar_sc = -1;
-                    z_pt = -1;
-                    z_eta = -10;
-                    e_pt[0] = -1;
-                    e_eta[0] = -10;
-                    e_phi[0] = -10;
-                    e_pt[1] = -1;
-                    e_eta[1] = -10;
-                    e_phi[1] = -10;
-                    e_charge[0] = -2;
-                    e_charge[1] = -2;
-                    n_verts = -1;
-                    n_true_pileup = -1;
-                    t0tight = false;
-                    t1tight = false;
-                }
-                // Constructor
-                branch_struct() {
-                    clear_values();
-                }
-                
-                double z_m;
-                double z_y;
-                double z_phistar_born;
-                double z_phistar_dressed;
-                double z_phistar_naked;
-                double z_phistar_sc;
-                double z_pt;
-                double z_eta;
-                double e_pt[2];
-                double e_eta[2];
-                double e_phi[2];
-                double e_rnine[2];
-                double n_true_pileup;
+            // The reco, truth, and event_info branches are the structs of
+            // ZTreeBranches.h, shared with ZEventTable
+
+            // Single precision copy of branch_struct used by the split
+            // layout. The event_info branches are written from event directly.
+            struct split_branch_struct {
+                float z_m;
+                float z_y;
+                float z_phistar_born;
+                float z_phistar_dressed;
+                float z_phistar_naked;
+                float z_phistar_sc;
+                float z_pt;
+                float z_eta;
+                float e_pt[2];
+                float e_eta[2];
+                float e_phi[2];
+                float e_rnine[2];
+                float n_true_pileup;
                 int e_charge[2];
                 int n_verts;
                 bool t0tight;
                 bool t1tight;
-            } reco_, truth_;
-
-            struct event_branch {
-                void clear_values() {
-                    event_number = 0;
-                    run_number = 0;
-                    is_mc = false;
-                }
-
-                // Constructor
-                event_branch() {
-                    clear_values();
-                }
-                unsigned int event_number;
-                unsigned int run_number;
-                bool is_mc;
-            } event_;
-
-            // Set up a variable size branch for the weights
-            int weight_size_;
-            double weight_fsr_;
-            int weight_cteq_size_;
-            int weight_mstw_size_;
-            int weight_nnpdf_size_;
+            };
+
             static constexpr int MAX_SIZE_ = 100;
-            static constexpr int MAX_SIZE_PDF_ = 110;
-            // Although vectors seem like the right solution, since TTrees need
-            // the memory used for the array to be static, an array is
-            // (unfortunately) the best choice
-            double weights_[MAX_SIZE_];
-            int weight_ids_[MAX_SIZE_];
-            double weights_cteq_[MAX_SIZE_PDF_];
-            double weights_mstw_[MAX_SIZE_PDF_];
-            double weights_nnpdf_[MAX_SIZE_PDF_];
+            // The PDF sets: cteq, mstw, and nnpdf
+            static constexpr int N_PDF_SETS_ = 3;
+
+            // Everything saved for one event. It is a single block of plain
+            // data so that AsyncTreeWriter can copy it; the PDF weights, whose
+            // number is only known from the events, are kept in pdf_buffers.
+            struct row_struct {
+                branch_struct reco;
+                branch_struct truth;
+                event_branch event;
+                split_branch_struct split_reco;
+                split_branch_struct split_truth;
+
+                // Set up a variable size branch for the weights
+                int weight_size;
+                double weight_fsr;
+                // Although vectors seem like the right solution, since TTrees
+                // need the memory used for the array to be static, an array
+                // is (unfortunately) the best choice
+                double weights[MAX_SIZE_];
+                int weight_ids[MAX_SIZE_];
+                // The number of members of each PDF set, and with
+                // compact_pdf_weights its central member
+                int weight_pdf_size[N_PDF_SETS_];
+                double weight_pdf_central[N_PDF_SETS_];
+            };
+
+            // The weights of one PDF set, or their ratios to the central
+            // member with compact_pdf_weights. The vectors only grow, and
+            // when one that a branch reads from moves the branch is pointed
+            // at its new memory.
+            struct pdf_buffer {
+                std::string array_name;
+                std::vector<double> weights;
+                std::vector<unsigned short> ratios;
+            };
+
+            // Fill writes to row_. The branches read from row_, or from
+            // tree_row_ if the tree is written by an AsyncTreeWriter, which
+            // copies row_ into tree_row_ on its own thread. The PDF weights
+            // are likewise in row_pdfs_, or tree_pdfs_ with a writer, which
+            // receives them packed in pdf_extra_.
+            row_struct row_;
+            row_struct tree_row_;
+            row_struct* branch_row_;
+            pdf_buffer row_pdfs_[N_PDF_SETS_];
+            pdf_buffer tree_pdfs_[N_PDF_SETS_];
+            pdf_buffer* branch_pdfs_;
+            std::vector<char> pdf_extra_;
+            AsyncTreeWriter* writer_;
+            int writer_id_;
 
             // We insert the weights and the IDs into this vector, and then
             // read it out into the array before filling the tree
@@ -134,6 +192,53 @@ namespace zf {
 
             // The tuples
             TTree* tree_;
+            const TreeLayout LAYOUT_;
+
+            // The (run, lumi, event) of every entry, sorted by WriteIndex
+            struct index_record {
+                unsigned int run_number;
+                unsigned int lumi_number;
+                unsigned int event_number;
+                Long64_t entry;
+                bool operator<(const index_record& OTHER) const;
+            };
+            std::vector<index_record> index_;
+            Long64_t n_entries_;
+            TTree* index_tree_;
+
+            // The same rows as the tree, as columns. Columns are appended in
+            // the order they were added, so AppendColumns must follow
+            // AddColumns.
+            ColumnarWriter* columnar_;
+            void AddColumns();
+            void AddKinematicColumns(const std::string& PREFIX);
+            void AppendColumns(const ZFinderEvent& zf_event);
+            void AppendKinematicColumns(const branch_struct& BRANCH, int* i_col);
+
+            // Make a branch with the basket size and compression of LAYOUT_
+            TBranch* MakeBranch(
+                    const std::string& NAME,
+                    void* address,
+                    const std::string& LEAF_LIST,
+                    const bool IS_WEIGHT = false
+                    );
+            void MakeSplitBranches(const std::string& PREFIX, split_branch_struct* branch);
+            void CopySplitBranch(const branch_struct& FROM, split_branch_struct* to);
+
+            // Make the branches for one PDF set, and copy its weights into
+            // the row and pdf. The buffers of branch_pdfs_ must be grown
+            // with GrowPDFBuffer so that their branches follow them.
+            void MakePDFBranches(const std::string& SET, const int I_SET);
+            void CopyPDFWeights(
+                    const std::vector<double>& PDF_WEIGHTS,
+                    const int I_SET,
+                    pdf_buffer* pdf
+                    );
+            void GrowPDFBuffer(pdf_buffer* pdf, const size_t SIZE);
+            // Pack the PDF weights of row_pdfs_ into pdf_extra_, and unpack
+            // them into tree_pdfs_ on the writer's thread
+            void PackPDFWeights();
+            void UnpackPDFWeights(const std::vector<char>& EXTRA);
 
             // Get the weight of the cuts
             void FillCutWeights(cutlevel_vector const * const CUT_LEVEL_VECTOR);
@@ -0,0 +1,112 @@
+#ifndef ZFINDER_ZDEFINITIONWORKSPACE_H_
+#define ZFINDER_ZDEFINITIONWORKSPACE_H_
+
+// Standard Library
+#include <string>  // string
+#include <vector>  // vector
+
+// ROOT
+#include "TTree.h"  // TTree
+
+// CMSSW
+#include "CommonTools/UtilAlgos/interface/TFileService.h"
+
+// ZFinder Code
+#include "ZDefinition.h"  // ZDefinition
+#include "ZFinderEvent.h"  // ZFinderEvent
+
+
+namespace zf {
+    /* Saves the events selected by a ZDefinition in a RooWorkspace, as
+     * described in docs/ZDefinitionWorkspace.md.
+     *
+     * Events are collected in batches of BATCH_SIZE and appended to a TTree
+     * ("workspace_store") in the output file, so the memory used does not
+     * grow with the number of events. Only this tree is written; the
+     * RooWorkspace is made from it (after merging the job outputs) by
+     * scripts/make_workspace.
+     */
+    class ZDefinitionWorkspace {
+        public:
+            // Constructor
+            ZDefinitionWorkspace(
+                const ZDefinition& zdef,
+                TFileDirectory& tdir,
+                const bool USE_MC = false,
+                const bool IS_MC = false,
+                const int BATCH_SIZE = 1000
+            );
+
+            // destructor
+            ~ZDefinitionWorkspace();
+
+            // Add event
+            void Fill(const ZFinderEvent& zf_event);
+
+            // Append the last batch and write the store. Call once after the
+            // last Fill.
+            void Write();
+
+        protected:
+            // One event in the workspace; the members are the branches of
+            // the store, and the variables of the RooDataSet
+            struct row_struct {
+                double z_mass;
+                double z_eta;
+                double z_y;
+                double z_pt;
+                double phistar;
+                double e0_pt;
+                double e1_pt;
+                double e0_eta;
+                double e1_eta;
+                double e0_charge;
+                double e1_charge;
+                double n_vert;
+                double event_num;
+                double weight;
+                int data_type;
+                int numerator;
+                int degenerate;
+                int pass_all;
+            };
+
+            // Values of the data_type category
+            enum DataType {
+                DATA = 0,
+                RECO_MC = 1,
+                TRUTH_MC = 2
+            };
+
+            // Values of the degenerate category
+            enum Degenerate {
+                NOT_DEGENERATE = 0,
+                DEGENERATE_DENOMINATOR = 1,
+                DEGENERATE_NUMERATOR = 2
+            };
+
+            // Name
+            std::string zdef_name_;
+
+            // Use the MC or reco data
+            const bool USE_MC_;
+            const int DATA_TYPE_;
+
+            // The cut level that selects events (-1 for all events with a
+            // Z), and the one that sets the numerator flag
+            int denominator_level_;
+            int numerator_level_;
+
+            // Events waiting to be appended to the store
+            const size_t BATCH_SIZE_;
+            std::vector<row_struct> batch_;
+            void AppendBatch();
+
+            // The on disk store, and the row its branches read from
+            TTree* tree_;
+            row_struct tree_row_;
+            TFileDirectory tdir_;
+            bool written_;
+    };
+}  // namespace zf
+#endif  // ZFINDER_ZDEFINITIONWORKSPACE_H_
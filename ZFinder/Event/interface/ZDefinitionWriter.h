@@ -2,10 +2,12 @@
 #define ZFINDER_ZDEFINITIONWRITER_H_
 
 // Standard Library
-#include <map>  // std::map
 #include <string>  // string
 #include <vector>  // std::vector
 
+// ROOT
+#include "TTree.h"  // Long64_t
+
 // CMSSW
 #include "CommonTools/UtilAlgos/interface/TFileService.h"
 
@@ -19,10 +21,23 @@ namespace zf {
     class ZDefinitionWriter{
         public:
             // Constructor
+            //
+            // If the first cut levels of zdef are the same as those of one of
+            // the writers in previous with the same USE_MC, the plotters for
+            // those levels (and the "0 All Events" plotter) are shared with
+            // it: they are only filled by that writer, and written to the
+            // directories of both. All writers must then be filled with the
+            // same events and electron order.
+            //
+            // PREFILTERED marks the titles of the "0 All Events" directory
+            // and the cutflow tree when events were skipped before reaching
+            // the writer, so that they do not hold all events.
             ZDefinitionWriter(
                     const ZDefinition& zdef,
                     TFileDirectory& tdir,
-                    const bool USE_MC = false
+                    const bool USE_MC = false,
+                    const std::vector<ZDefinitionWriter*>& previous = std::vector<ZDefinitionWriter*>(),
+                    const bool PREFILTERED = false
                     );
 
             ~ZDefinitionWriter();
@@ -33,6 +48,10 @@ namespace zf {
                     const int second_electron = 1
                     );
 
+            // Write the histograms of every ZFinderPlotter this writer owns,
+            // and the cutflow table
+            void Write();
+
         protected:
             // Name
             std::string zdef_name;
@@ -40,11 +59,41 @@ namespace zf {
             // Use the MC or reco data
             const bool USE_MC_;
 
-            // A Vector of our ZFinderPlotters
-            std::map<std::string, ZFinderPlotter> zf_plotters;
+            // Events were skipped by the ZFinder prefilter
+            const bool PREFILTERED_;
+
+            // Our ZFinderPlotters, indexed by cut level
+            std::vector<ZFinderPlotter*> zf_plotters_;
+
+            // CutLevelKey of each cut level
+            std::vector<std::string> level_keys_;
+
+            // The first n_shared_levels_ plotters, and the all events plotter
+            // if owns_all_events_plot_ is false, belong to another writer
+            size_t n_shared_levels_;
+            bool owns_all_events_plot_;
 
             // Space for our 0th plot of all events
             ZFinderPlotter* all_events_plot_;
+
+            // Histogram entries of the current event, shared by all plotters
+            HistogramBank::entry_vector entries_;
+
+            // Number of events that reached each cut level, and their
+            // weights. Index 0 is "0 All Events", index i is cut level i - 1.
+            // These are always kept by this writer, even for shared levels.
+            struct cutflow_counter {
+                cutflow_counter() : n_raw(0), sum_weight(0.), sum_full_weight(0.), sum_full_weight2(0.) {}
+                Long64_t n_raw;
+                double sum_weight;  // event_weight only
+                double sum_full_weight;  // With the scale factors
+                double sum_full_weight2;
+            };
+            std::vector<cutflow_counter> cutflow_;
+            std::vector<std::string> level_names_;
+            TFileDirectory tdir_;
+
+            void Count(const size_t I_LEVEL, const double WEIGHT, const double FULL_WEIGHT);
     };
 }  // namespace zf
 #endif  // ZFINDER_ZDEFINITIONWRITER_H_
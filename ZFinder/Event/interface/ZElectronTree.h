@@ -0,0 +1,121 @@
+#ifndef ZFINDER_ZELECTRONTREE_H_
+#define ZFINDER_ZELECTRONTREE_H_
+
+// ROOT
+#include "TTree.h"  // TTree
+
+// CMSSW
+#include "CommonTools/UtilAlgos/interface/TFileService.h"
+
+// ZFinder Code
+#include "CutBits.h"  // N_WEIGHTED_CUTS
+#include "ZFinderElectron.h"  // ZFinderElectron
+#include "ZFinderEvent.h"  // ZFinderEvent
+
+
+namespace zf {
+    /* Saves the electrons that the ZDefinitions look at (e0, e1, and their
+     * truth and trigger partners) along with a bitmask of every cut they
+     * passed and the scale factors of the weighted cuts. This allows new
+     * ZDefinitions to be applied to the output without rerunning over the
+     * AOD; see scripts/reselect.
+     */
+    class ZElectronTree {
+        public:
+            // Constructor
+            ZElectronTree(TFileDirectory& tdir, const bool IS_MC = false);
+
+            // destructor
+            ~ZElectronTree();
+
+            // Add event
+            void Fill(const ZFinderEvent& zf_event);
+
+            // Wrapper around TTree::GetCurrentFile()
+            TFile* GetCurrentFile();
+
+        protected:
+            // Reco, truth, and trigger electrons; the ZDefinition comparison
+            // cuts (pt, gpt, tpt, etc.) read from these
+            struct electron_branch {
+                void clear_values() {
+                    for (int i = 0; i < 2; ++i) {
+                        pt[i] = -1;
+                        eta[i] = -10;
+                        phi[i] = -10;
+                        rnine[i] = -1;
+                        charge[i] = -2;
+                    }
+                }
+                // Constructor
+                electron_branch() {
+                    clear_values();
+                }
+
+                float pt[2];
+                float eta[2];
+                float phi[2];
+                float rnine[2];
+                int charge[2];
+            } reco_, truth_, trig_;
+
+            struct z_branch {
+                void clear_values() {
+                    z_m = -1;
+                    z_y = -10;
+                    z_phistar = -1;
+                    z_pt = -1;
+                }
+                // Constructor
+                z_branch() {
+                    clear_values();
+                }
+
+                float z_m;
+                float z_y;
+                float z_phistar;
+                float z_pt;
+            } reco_z_, truth_z_;
+
+            struct event_branch {
+                void clear_values() {
+                    event_number = 0;
+                    run_number = 0;
+                    lumi_number = 0;
+                    is_mc = false;
+                }
+
+                // Constructor
+                event_branch() {
+                    clear_values();
+                }
+                unsigned int event_number;
+                unsigned int run_number;
+                unsigned int lumi_number;
+                bool is_mc;
+            } event_;
+
+            // The cut results of the reco electrons. A bit in cut_bits_ is set
+            // if the cut at that position in CUT_BIT_NAMES passed, a bit in
+            // cut_known_ is set if the electron has a result for that cut.
+            ULong64_t cut_bits_[2];
+            ULong64_t cut_known_[2];
+            float cut_weights_[2][N_WEIGHTED_CUTS];
+            double event_weight_;
+
+            // Use the MC or reco data
+            const bool IS_MC_;
+
+            // The tuple
+            TTree* tree_;
+
+            // Read the cuts from an electron into slot I_ELEC
+            void FillCuts(const ZFinderElectron& ZF_ELEC, const int I_ELEC);
+            void FillElectron(
+                    const ZFinderElectron& ZF_ELEC,
+                    const int I_ELEC,
+                    electron_branch* branch
+                    );
+    };
+}  // namespace zf
+#endif  // ZFINDER_ZELECTRONTREE_H_
@@ -0,0 +1,96 @@
+#ifndef ZFINDER_ZEVENTTABLE_H_
+#define ZFINDER_ZEVENTTABLE_H_
+
+// Standard Library
+#include <string>  // string
+#include <utility>  // pair
+#include <vector>  // vector
+
+// ROOT
+#include "TTree.h"  // TTree
+
+// CMSSW
+#include "CommonTools/UtilAlgos/interface/TFileService.h"
+
+// ZFinder Code
+#include "ZDefinition.h"  // ZDefinition
+#include "ZFinderEvent.h"  // ZFinderEvent
+#include "ZTreeBranches.h"  // branch_struct, event_branch
+
+
+namespace zf {
+    /* Saves each event once, no matter how many ZDefinitions it passes,
+     * instead of once per ZDefinition as ZDefinitionTree does. The "reco",
+     * "truth", "event_info", pileup, PDF, and FSR branches have the same
+     * layout as ZDefinitionTree. Bit i of "zdef_pass" is set if the event
+     * passed the ZDefinition at entry i of the "zdefs" tree, and the scale
+     * factor weights of every passing ZDefinition are stored in
+     * "zdef_weights" tagged with that index. See scripts/event_table for a
+     * reader that presents one ZDefinition at a time.
+     */
+    class ZEventTable {
+        public:
+            // Constructor
+            ZEventTable(
+                const std::vector<ZDefinition*>& zdefs,
+                TFileDirectory& tdir,
+                const bool IS_MC = false
+            );
+
+            // destructor
+            ~ZEventTable();
+
+            // Add event
+            void Fill(const ZFinderEvent& zf_event);
+
+            // Wrapper around TTree::GetCurrentFile()
+            TFile* GetCurrentFile();
+
+        protected:
+            // The branches of ZTreeBranches.h, as in ZDefinitionTree.
+            // t0tight and t1tight depend on the ZDefinition and so are always
+            // false here; they are stored in zdef_t0p1_ and zdef_t1p0_
+            // instead.
+            branch_struct reco_, truth_;
+            event_branch event_;
+
+            // ZDefinition pass flags, one bit per ZDefinition
+            static constexpr int MAX_ZDEFS_ = 64;
+            ULong64_t zdef_pass_;
+            ULong64_t zdef_t0p1_;
+            ULong64_t zdef_t1p0_;
+
+            // Event weights that do not depend on the ZDefinition
+            int weight_size_;
+            double weight_fsr_;
+            int weight_cteq_size_;
+            int weight_mstw_size_;
+            int weight_nnpdf_size_;
+            static constexpr int MAX_SIZE_ = 100;
+            double weights_[MAX_SIZE_];
+            int weight_ids_[MAX_SIZE_];
+            // The number of PDF members and scale factors is only known from
+            // the events, so these grow to the largest seen and their
+            // branches are pointed at them again when they do
+            std::vector<double> weights_cteq_;
+            std::vector<double> weights_mstw_;
+            std::vector<double> weights_nnpdf_;
+
+            // Scale factor weights, with the index of the ZDefinition they
+            // belong to
+            int zdef_weight_size_;
+            std::vector<int> zdef_weight_zdefs_;
+            std::vector<int> zdef_weight_ids_;
+            std::vector<double> zdef_weights_;
+
+            // Names of the ZDefinitions, in bit order
+            std::vector<std::string> zdef_names_;
+
+            // Use the MC or reco data
+            const bool IS_MC_;
+
+            // The tuple
+            TTree* tree_;
+    };
+}  // namespace zf
+#endif  // ZFINDER_ZEVENTTABLE_H_
@@ -14,6 +14,9 @@
 #include "DataFormats/HepMCCandidate/interface/GenParticle.h"  // reco::GenParticle
 #include "DataFormats/RecoCandidate/interface/RecoEcalCandidate.h"  // reco::RecoEcalCandidate
 
+// ZFinder
+#include "ZFinder/Event/interface/CompactZFinderEvent.h"  // CompactElectron
+
 namespace zf {
 
     enum ElectronType {
@@ -43,6 +46,10 @@ namespace zf {
             ZFinderElectron(reco::RecoEcalCandidate input_electron);
             ZFinderElectron(reco::Photon input_electron);
             ZFinderElectron(trigger::TriggerObject input_electron);
+            ZFinderElectron(const CompactElectron& COMPACT);
+
+            // Flat copy for storing in the edm::Event
+            CompactElectron GetCompact() const;
 
             // Handling cuts
             const CutResult* GetCutResult(const std::string& cut_name) const;
@@ -80,9 +87,20 @@ namespace zf {
             double ecal_iso() const { return ecal_iso_; }
             double hcal_iso() const { return hcal_iso_; }
             double one_over_e_mins_one_over_p() { return one_over_e_mins_one_over_p_; }
+            double d0() const { return d0_; }
+            double dz() const { return dz_; }
+            double pf_iso() const { return pf_iso_; }
+            int missing_hits() const { return missing_hits_; }
+            bool has_conversion() const { return has_conversion_; }
+            bool is_eb() const { return is_eb_; }
+            bool is_ee() const { return is_ee_; }
 
             //Setters
             void set_phi(double new_phi) { phi_ = new_phi; }
+            void set_d0(double new_d0) { d0_ = new_d0; }
+            void set_dz(double new_dz) { dz_ = new_dz; }
+            void set_pf_iso(double new_pf_iso) { pf_iso_ = new_pf_iso; }
+            void set_has_conversion(bool new_has_conversion) { has_conversion_ = new_has_conversion; }
 
         protected:
             std::map<std::string, CutResult> cutresults_;
@@ -128,6 +146,16 @@ namespace zf {
             double hcal_iso_;
             double one_over_e_mins_one_over_p_;
 
+            // Track and isolation variables, relative to the first primary
+            // vertex. These need the event, so ZFinderEvent sets them.
+            double d0_;
+            double dz_;
+            double pf_iso_;  // Rho corrected, divided by pt
+            int missing_hits_;
+            bool has_conversion_;
+            bool is_eb_;
+            bool is_ee_;
+
             // Other physical properties
             int charge_;
 
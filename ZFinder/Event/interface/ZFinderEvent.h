@@ -19,6 +19,7 @@
 #include "PhysicsTools/Utilities/interface/LumiReWeighting.h"  // edm::LumiReWeighting
 
 // ZFinder
+#include "ZFinder/Event/interface/CompactZFinderEvent.h"  // CompactZFinderEvent
 #include "ZFinder/Event/interface/ZFinderElectron.h"  // ZFinderElectron, ZFinderElectron
 #include "ZFinder/Event/interface/CutLevel.h"  // CutLevel, cutlevel_pair, cutlevel_vector
 
@@ -38,6 +39,8 @@ namespace zf {
                     const edm::EventSetup& iSetup,
                     const edm::ParameterSet& iConfig
                     );
+            // Rebuild from the output of ZFinderEventProducer
+            explicit ZFinderEvent(const CompactZFinderEvent& COMPACT);
             // Destructor
             ~ZFinderEvent();
 
@@ -135,6 +138,9 @@ namespace zf {
             bool ZDefPassed(const std::string& NAME) const;
             void PrintZDefs(const bool VERBOSE = false) const;
 
+            // Flat copy for storing in the edm::Event
+            CompactZFinderEvent GetCompact() const;
+
         protected:
             // These variables are defined at the top of ZFinderEvent.cc to
             // avoid compilation issues
@@ -156,6 +162,13 @@ namespace zf {
             // Update the Z Info from e0, e1
             void InitZ();
 
+            // Convert between electron pointers and CompactZFinderEvent
+            // indices, and unpack the flattened structs
+            static int ElectronIndex(const std::vector<ZFinderElectron*>& ELECTRONS, const ZFinderElectron* const ELECTRON);
+            static ZFinderElectron* ElectronAt(const std::vector<ZFinderElectron*>& ELECTRONS, const int INDEX);
+            static void SetVertexes(const std::vector<double>& VALUES, Vertexes* vert);
+            static void SetZData(const std::vector<double>& VALUES, ZData* zdata);
+
             // Initialize all variables to safe values
             void InitVariables();
 
@@ -1,14 +1,14 @@
 #ifndef ZFINDER_ZFINDERPLOTTER_H_
 #define ZFINDER_ZFINDERPLOTTER_H_
 
-// Root
-#include <TH1D.h>  // TH1D
-#include <TH2D.h>  // TH2D
+// Standard Library
+#include <vector>  // std::vector
 
 // CMSSW
 #include "CommonTools/UtilAlgos/interface/TFileService.h"
 
 // ZFinder Code
+#include "HistogramBank.h"  // HistogramBank
 #include "ZFinderEvent.h"  // ZFinderEvent
 
 
@@ -26,67 +26,101 @@ namespace zf {
                     const double EVENT_WEIGHT = 1.
                     );
 
+            // Find the histogram entries of an event once, and then fill
+            // them into several plotters, for example one per cut level,
+            // with different weights
+            void MakeEntries(
+                    const ZFinderEvent& ZF_EVENT,
+                    const int FIRST_ELECTRON,
+                    const int SECOND_ELECTRON,
+                    HistogramBank::entry_vector* entries
+                    ) const;
+            void Fill(
+                    const ZFinderEvent& ZF_EVENT,
+                    const HistogramBank::entry_vector& ENTRIES,
+                    const double EVENT_WEIGHT
+                    );
+
+            // Also write the histograms to tdir, for a plotter that is shared
+            // by several cut levels
+            void AddDirectory(TFileDirectory& tdir);
+
+            // Make the histograms in the TFileDirectory given to the
+            // constructor, and any added with AddDirectory, and write them.
+            // Must be called once at the end of the job, before the
+            // TFileService closes the file.
+            void Write();
+
         protected:
-            // Histograms
-            TH1D* z0_mass_all_;
-            TH1D* z0_mass_coarse_;
-            TH1D* z0_mass_fine_;
-            TH1D* z0_rapidity_;
-            TH1D* z0_pt_;
-            TH1D* e0_pt_;
-            TH1D* e0_pt_naked_;
-            TH1D* e0_pt_born_;
-            TH1D* e1_pt_;
-            TH1D* e1_pt_naked_;
-            TH1D* e1_pt_born_;
-            TH1D* e0_eta_;
-            TH1D* e0_eta_naked_;
-            TH1D* e0_eta_born_;
-            TH1D* e1_eta_;
-            TH1D* e1_eta_naked_;
-            TH1D* e1_eta_born_;
-            TH1D* e0_phi_;
-            TH1D* e0_phi_naked_;
-            TH1D* e0_phi_born_;
-            TH1D* e1_phi_;
-            TH1D* e1_phi_naked_;
-            TH1D* e1_phi_born_;
-            TH1D* e0_charge_;
-            TH1D* e1_charge_;
-            TH1D* e0_r9_;
-            TH1D* e1_r9_;
-            TH1D* e0_sigma_ieta_ieta_;
-            TH1D* e1_sigma_ieta_ieta_;
-            TH1D* e0_h_over_e_;
-            TH1D* e1_h_over_e_;
-            TH1D* e0_deta_in_;
-            TH1D* e1_deta_in_;
-            TH1D* e0_dphi_in_;
-            TH1D* e1_dphi_in_;
-            TH1D* e0_track_iso_;
-            TH1D* e1_track_iso_;
-            TH1D* e0_ecal_iso_;
-            TH1D* e1_ecal_iso_;
-            TH1D* e0_hcal_iso_;
-            TH1D* e1_hcal_iso_;
-            TH1D* e0_one_over_e_mins_one_over_p_;
-            TH1D* e1_one_over_e_mins_one_over_p_;
-            TH1D* phistar_;
-            TH1D* phistar_born_;
-            TH1D* phistar_naked_;
-            TH1D* phistar_supercluster_;
-            TH1D* pileup_;
-            TH1D* true_vert_;
-            TH1D* nelectrons_;
-            TH1D* baseweights_;
-            TH1D* fullweights_;
-            TH1D* e0_pt_vs_trig_;
-            TH1D* e1_pt_vs_trig_;
-            TH1D* phistar_vs_truth_;
-            TH1D* deltaR_;
-            TH1D* other_phistar_;
-            TH1D* other_y_;
-            TH2D* phistar_vs_sc_phistar_;
+            // Histogram IDs in bank_
+            int z0_mass_all_;
+            int z0_mass_coarse_;
+            int z0_mass_fine_;
+            int z0_rapidity_;
+            int z0_pt_;
+            int e0_pt_;
+            int e0_pt_naked_;
+            int e0_pt_born_;
+            int e1_pt_;
+            int e1_pt_naked_;
+            int e1_pt_born_;
+            int e0_eta_;
+            int e0_eta_naked_;
+            int e0_eta_born_;
+            int e1_eta_;
+            int e1_eta_naked_;
+            int e1_eta_born_;
+            int e0_phi_;
+            int e0_phi_naked_;
+            int e0_phi_born_;
+            int e1_phi_;
+            int e1_phi_naked_;
+            int e1_phi_born_;
+            int e0_charge_;
+            int e1_charge_;
+            int e0_r9_;
+            int e1_r9_;
+            int e0_sigma_ieta_ieta_;
+            int e1_sigma_ieta_ieta_;
+            int e0_h_over_e_;
+            int e1_h_over_e_;
+            int e0_deta_in_;
+            int e1_deta_in_;
+            int e0_dphi_in_;
+            int e1_dphi_in_;
+            int e0_track_iso_;
+            int e1_track_iso_;
+            int e0_ecal_iso_;
+            int e1_ecal_iso_;
+            int e0_hcal_iso_;
+            int e1_hcal_iso_;
+            int e0_one_over_e_mins_one_over_p_;
+            int e1_one_over_e_mins_one_over_p_;
+            int phistar_;
+            int phistar_born_;
+            int phistar_naked_;
+            int phistar_supercluster_;
+            int pileup_;
+            int true_vert_;
+            int nelectrons_;
+            int baseweights_;
+            int fullweights_;
+            int e0_pt_vs_trig_;
+            int e1_pt_vs_trig_;
+            int phistar_vs_truth_;
+            int deltaR_;
+            int other_phistar_;
+            int other_y_;
+            int phistar_vs_sc_phistar_;
+
+            // Bins of all histograms, which only use memory once filled
+            HistogramBank bank_;
+
+            // Reused by Fill to avoid an allocation per event
+            HistogramBank::entry_vector entries_;
+
+            // Directories to write the histograms to
+            std::vector<TFileDirectory> tdirs_;
 
             // Use the MC or reco data
             const bool USE_MC_;
@@ -0,0 +1,126 @@
+#ifndef ZFINDER_ZTREEBRANCHES_H_
+#define ZFINDER_ZTREEBRANCHES_H_
+
+// ZFinder Code
+#include "ZFinderEvent.h"  // ZFinderEvent, ZFinderElectron
+
+
+namespace zf {
+    /* The "reco", "truth", and "event_info" branches shared by
+     * ZDefinitionTree and ZEventTable, so that both trees have the same
+     * layout and are filled the same way.
+     */
+
+    // The leaf list of a branch_struct branch
+    const char BRANCH_STRUCT_CODE[] = "z_m/D:z_y:z_phistar_born:z_phistar_dressed:z_phistar_naked:z_phistar_sc:z_pt:z_eta:e_pt0:e_pt1:e_eta0:e_eta1:e_phi0:e_phi1:e_rnine0:e_rnine1:n_true_pileup:e_charge0/I:e_charge1:n_verts:t0tight/O:t1tight";
+
+    // The Z and electron quantities of the reco or truth event
+    struct branch_struct {
+        void clear_values() {
+            z_m = -1;
+            z_y = -10;
+            z_phistar_born = -1;
+            z_phistar_dressed = -1;
+            z_phistar_naked = -1;
+            z_phistar_sc = -1;
+            z_pt = -1;
+            z_eta = -10;
+            for (int i = 0; i < 2; ++i) {
+                e_pt[i] = -1;
+                e_eta[i] = -10;
+                e_phi[i] = -10;
+                e_rnine[i] = -1;
+                e_charge[i] = -2;
+            }
+            n_verts = -1;
+            n_true_pileup = -1;
+            t0tight = false;
+            t1tight = false;
+        }
+        // Constructor
+        branch_struct() {
+            clear_values();
+        }
+
+        // Copy the quantities of the reco (or truth) Z, its electrons, and
+        // the vertexes. t0tight and t1tight depend on the ZDefinition and are
+        // left for the caller to set.
+        void fill(const ZFinderEvent& zf_event, const bool USE_TRUTH) {
+            const ZFinderEvent::ZData* zdata = USE_TRUTH ? &zf_event.truth_z : &zf_event.reco_z;
+            const ZFinderElectron* elecs[2] = {
+                USE_TRUTH ? zf_event.e0_truth : zf_event.e0,
+                USE_TRUTH ? zf_event.e1_truth : zf_event.e1
+            };
+
+            z_m = zdata->m;
+            z_y = zdata->y;
+            z_phistar_dressed = zdata->phistar;
+            z_phistar_born = zdata->bornPhistar;
+            z_phistar_naked = zdata->nakedPhistar;
+            z_phistar_sc = zdata->scPhistar;
+            z_pt = zdata->pt;
+            z_eta = zdata->eta;
+            if (USE_TRUTH) {
+                n_verts = zf_event.truth_vert.num;
+                n_true_pileup = zf_event.truth_vert.true_num;
+            }
+            else {
+                n_verts = zf_event.reco_vert.num;
+            }
+            for (int i = 0; i < 2; ++i) {
+                if (elecs[i] != nullptr) {
+                    e_pt[i] = elecs[i]->pt();
+                    e_eta[i] = elecs[i]->eta();
+                    e_phi[i] = elecs[i]->phi();
+                    e_rnine[i] = elecs[i]->r9();
+                    e_charge[i] = elecs[i]->charge();
+                }
+            }
+        }
+
+        double z_m;
+        double z_y;
+        double z_phistar_born;
+        double z_phistar_dressed;
+        double z_phistar_naked;
+        double z_phistar_sc;
+        double z_pt;
+        double z_eta;
+        double e_pt[2];
+        double e_eta[2];
+        double e_phi[2];
+        double e_rnine[2];
+        double n_true_pileup;
+        int e_charge[2];
+        int n_verts;
+        bool t0tight;
+        bool t1tight;
+    };
+
+    // The leaf list of an event_branch branch
+    const char EVENT_BRANCH_CODE[] = "event_number/i:run_number:is_mc/O";
+
+    struct event_branch {
+        void clear_values() {
+            event_number = 0;
+            run_number = 0;
+            is_mc = false;
+        }
+
+        // Constructor
+        event_branch() {
+            clear_values();
+        }
+
+        void fill(const ZFinderEvent& zf_event) {
+            is_mc = !zf_event.is_real_data;
+            event_number = zf_event.id.event_num;
+            run_number = zf_event.id.run_num;
+        }
+
+        unsigned int event_number;
+        unsigned int run_number;
+        bool is_mc;
+    };
+}  // namespace zf
+#endif  // ZFINDER_ZTREEBRANCHES_H_
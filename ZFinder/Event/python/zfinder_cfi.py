@@ -51,4 +51,70 @@ ZFinder = cms.EDAnalyzer('ZFinder',
         # Dressed is the default if no answer is provided, or an incorrect one
         # is used.
         gen_electrons = cms.string("Dressed"),
+        # Save e0, e1 (and their truth and trigger partners) with a bitmask of
+        # all their cut results in "Electron Cuts/electrons". New ZDefinitions
+        # can then be applied to the output with scripts/reselect instead of
+        # rerunning over the AOD.
+        store_electron_cuts = cms.untracked.bool(False),
+        # In data, skip events whose raw electron candidates can not pass the
+        # pt and eta requirements of any ZDefinition before building the
+        # ZFinderEvent. Skipped events are counted in "prefiltered_counter".
+        # The "All Events" and early cut level plots, and the cutflow, will
+        # only contain events that pass the prefilter; their titles say so.
+        use_prefilter = cms.untracked.bool(False),
+        # Save each event once in "Event Table/events" with a bitmask of the
+        # ZDefinitions it passed, instead of one tree per ZDefinition. Use
+        # scripts/event_table to read it back one ZDefinition at a time. The
+        # table has a fixed layout, so the tree_* options below must be left
+        # at their defaults; ZFinder throws otherwise.
+        use_event_table = cms.untracked.bool(False),
+        # Write the ZDefinition trees with one single precision branch per
+        # variable ("reco_z_phistar_dressed", ...) instead of the "reco",
+        # "truth", and "event_info" leaf-list branches, so that readers only
+        # decompress the variables they use. scripts/zdef_tree reads both
+        # layouts.
+        tree_split_branches = cms.untracked.bool(False),
+        # Buffer size of each branch, and the ROOT compression settings
+        # (100 * algorithm + level, e.g. 207 for LZMA level 7) of the
+        # kinematic and of the weight/PDF branches. -1 keeps the file default.
+        tree_basket_size = cms.untracked.int32(32000),
+        tree_compression = cms.untracked.int32(-1),
+        tree_weight_compression = cms.untracked.int32(-1),
+        # Store each PDF weight as a 16 bit fixed point ratio to the central
+        # member instead of a double. The decoded weights are within 3.1e-5
+        # times the central weight of the original for ratios below 4; see
+        # interface/WeightCoding.h.
+        tree_compact_pdf_weights = cms.untracked.bool(False),
+        # Write an "event_index" tree next to each ZDefinition tree with the
+        # entry of every event sorted by (run, lumi, event), for fast lookups
+        # with scripts/zdef_tree/event_index.h. It stays valid after hadd.
+        tree_event_index = cms.untracked.bool(False),
+        # If not empty, also write each ZDefinition tuple to
+        # "<tree_columnar_dir>/<ZDefinition name>.zcol", a columnar file that
+        # can be memory mapped without ROOT (see interface/ColumnarFile.h).
+        # With tree_columnar_group_by_run its rows are sorted into one row
+        # group per run.
+        tree_columnar_dir = cms.untracked.string(""),
+        tree_columnar_group_by_run = cms.untracked.bool(False),
+        # If greater than 0, the ZDefinition trees are filled and compressed
+        # on a separate thread. Each event is copied into a buffer holding at
+        # most this many events (about 5 kB each); analyze only waits if the
+        # buffer is full. Not used with store_workspaces or
+        # store_electron_cuts, whose trees are filled in the event loop and
+        # share the output file.
+        tree_writer_slots = cms.untracked.int32(0),
+        # Save the events selected by each ZDefinition for a RooWorkspace (see
+        # docs/ZDefinitionWorkspace.md). Events are appended to a tree in the
+        # output file in batches of workspace_batch_size; the RooWorkspace is
+        # made from it by scripts/make_workspace.
+        store_workspaces = cms.untracked.bool(False),
+        workspace_batch_size = cms.untracked.int32(1000),
+        )
+
+# Builds the ZFinderEvent once per event and stores it in the edm::Event, so
+# that ZFinder, TrigEff, and IDPlotter do not each rebuild the electrons and
+# recompute their IDs. To use it, put it in the path before the analyzers and
+# set their zfinderEventInputTag to cms.untracked.InputTag("ZFinderEventProducer").
+ZFinderEventProducer = cms.EDProducer('ZFinderEventProducer',
+        **ZFinder.parameters_()
         )
@@ -1,75 +1,484 @@
 // Standard Library
-#include <stdexcept>
+#include <algorithm>  // std::sort, std::swap
+#include <cstdio>  // std::remove
+#include <cstdlib>  // atoi, atof
+#include <fstream>
+#include <functional>  // std::greater
 #include <iostream>
+#include <map>
+#include <queue>  // std::priority_queue
 #include <sstream>
+#include <stdexcept>  // std::runtime_error
+#include <stdint.h>  // uint32_t, uint64_t
+#include <string>
+#include <vector>
+
+// POSIX
+#include <unistd.h>  // getpid
 
 // ROOT
 #include <TFile.h>
-#include <TBranch.h>
-#include <TCanvas.h>
-#include <TMath.h>
-#include <TLeaf.h>
-
 #include <TTree.h>
-#include "TSystem.h"
 
-#include <set>
+// ZFinder
+#include "../zdef_tree/event_index.h"  // EventIndex
+#include "../zdef_tree/zdef_tree_reader.h"  // ExpandFileLists
 
-using namespace std; // yeah I am evil, get over it
+/*
+ * Find events that appear more than once in a dataset, and events that are
+ * in more than one dataset, for example the SingleElectron and
+ * DoubleElectron samples.
+ *
+ * Usage:
+ *
+ *     EventDupFind.exe [options] -d NAME input.root [...] [-d NAME input.root [...]] ...
+ *
+ * Options, which apply to the datasets after them:
+ *
+ *     -z ZDEF     the ZDefinition tree to read (default "Combined Single Reco")
+ *
+ * Options for the whole run:
+ *
+ *     -m MB       the memory for sorting, in MB (default 1024)
+ *     -w DIR      the directory for the sorted runs spilled to disk (default .)
+ *     -o FILE     write every event duplicated in a dataset to FILE
+ *     -p N        print the first N of them (default 20)
+ *
+ * An input starting with "@" is a text file with one input file per line.
+ * The same file may be given to several datasets with different ZDefinitions,
+ * for example to compare "Combined Single Reco" with "Combined Single
+ * Lowered Threshold Reco".
+ *
+ * Each entry is a record of a 64 bit key, run (32 bits) and event (32
+ * bits), its lumi section, and the file and entry it came from. The lumi
+ * sections are read from the event_index trees; a tree without one has lumi
+ * 0, which is unknown. Records are collected until the memory is full, radix
+ * sorted by key, and written to disk, and the sorted runs are then merged, so
+ * the number of events is only limited by the disk.
+ *
+ * An event is a run, lumi, and event number. The records with the same run
+ * and event number are split by their known lumi sections, and the records
+ * with an unknown lumi join the one known lumi section if there is exactly
+ * one. If there are several, the records with an unknown lumi can not be
+ * placed; they are counted as one more event and reported as a conflict.
+ */
 
-TTree* GetTTree(const std::string TFILE, const std::string TTREE) {
-  // Open the TFiles
-  TFile* mc_tfile = new TFile(TFILE.c_str(), "READ");
-  if (!mc_tfile || mc_tfile->IsZombie()) {
-    const std::string ERR = "Could not open the file " + TFILE;
-    throw std::runtime_error(ERR);
-  }
+namespace {
+    // 24 bytes with no padding left to the compiler, so the runs on disk
+    // are plain arrays
+    struct key_record {
+        uint64_t key;  // Run and event
+        uint32_t lumi;
+        uint32_t file;
+        uint32_t entry;
+        uint32_t unused;
+    };
 
-  // Load the tree
-  TTree* tree = new TTree();
-  mc_tfile->GetObject(TTREE.c_str(), tree);
-  if (!tree || tree->IsZombie()) {
-    const std::string ERR = "Could not open the TTree " + TTREE;
-    throw std::runtime_error(ERR);
-  }
+    uint64_t PackKey(const unsigned int RUN, const unsigned int EVENT) {
+        return (uint64_t(RUN) << 32) | EVENT;
+    }
 
-  return tree;
-}
+    unsigned int KeyRun(const uint64_t KEY) { return KEY >> 32; }
+    unsigned int KeyEvent(const uint64_t KEY) { return KEY & 0xffffffff; }
+
+    // Orders the records of one run and event number by lumi
+    bool LumiLess(const key_record& A, const key_record& B) { return A.lumi < B.lumi; }
+
+    /*
+     * LSD radix sort of the records by key, 16 bits per pass. Passes where
+     * every key has the same digit (for example the high bits of the run
+     * number) are skipped. BUFFER must have the same size as RECORDS.
+     */
+    void RadixSort(std::vector<key_record>* records, std::vector<key_record>* buffer) {
+        const size_t N = records->size();
+        buffer->resize(N);
+        std::vector<size_t> counts(1 << 16);
+        for (int shift = 0; shift < 64; shift += 16) {
+            std::fill(counts.begin(), counts.end(), 0);
+            for (size_t i = 0; i < N; ++i) {
+                ++counts[((*records)[i].key >> shift) & 0xffff];
+            }
+            if (N == 0 || counts[((*records)[0].key >> shift) & 0xffff] == N) {
+                continue;
+            }
+            size_t total = 0;
+            for (auto& i_count : counts) {
+                const size_t COUNT = i_count;
+                i_count = total;
+                total += COUNT;
+            }
+            for (size_t i = 0; i < N; ++i) {
+                const key_record& RECORD = (*records)[i];
+                (*buffer)[counts[(RECORD.key >> shift) & 0xffff]++] = RECORD;
+            }
+            records->swap(*buffer);
+        }
+    }
+
+    // A sorted run on disk, read back in blocks
+    class RunReader {
+        public:
+            RunReader(const std::string& PATH) : file_(PATH.c_str(), std::ios::binary), pos_(0) {
+                if (!file_) {
+                    throw std::runtime_error("Failed to read " + PATH);
+                }
+                Fill();
+            }
+
+            bool Done() const { return pos_ >= block_.size(); }
+            const key_record& Current() const { return block_[pos_]; }
+            void Next() {
+                if (++pos_ >= block_.size()) {
+                    Fill();
+                }
+            }
+
+        protected:
+            static const size_t BLOCK_SIZE = 65536;
+            std::ifstream file_;
+            std::vector<key_record> block_;
+            size_t pos_;
+
+            void Fill() {
+                block_.resize(BLOCK_SIZE);
+                file_.read(reinterpret_cast<char*>(&block_[0]), BLOCK_SIZE * sizeof(key_record));
+                block_.resize(file_.gcount() / sizeof(key_record));
+                pos_ = 0;
+            }
+    };
+
+    struct dataset {
+        std::string name;
+        std::string zdef;
+        std::vector<std::string> files;
+        Long64_t n_events;
+        Long64_t n_duplicated_events;  // Events in it more than once
+        Long64_t n_extra_entries;  // Entries beyond the first of each event
+    };
+
+    /*
+     * Reads the sorted stream of records, one group of records with the same
+     * run and event number at a time, and counts the duplicates.
+     */
+    class DuplicateCounter {
+        public:
+            DuplicateCounter(
+                    std::vector<dataset>* datasets,
+                    const std::vector<std::string>& FILES,
+                    const std::vector<size_t>& FILE_DATASET,
+                    const int N_PRINT,
+                    std::ostream* out
+                    ) :
+                datasets_(datasets),
+                FILES_(FILES),
+                FILE_DATASET_(FILE_DATASET),
+                n_print_(N_PRINT),
+                out_(out),
+                n_print_conflicts_(N_PRINT),
+                n_conflicts_(0),
+                overlaps_(datasets->size() * datasets->size(), 0)
+            {}
+
+            void Add(const key_record& RECORD) {
+                if (!group_.empty() && group_[0].key != RECORD.key) {
+                    Flush();
+                }
+                group_.push_back(RECORD);
+            }
+
+            void Flush();
+
+            Long64_t Conflicts() const { return n_conflicts_; }
+            // The number of events in both datasets I and J
+            Long64_t Overlap(const size_t I, const size_t J) const { return overlaps_[I * datasets_->size() + J]; }
+
+        protected:
+            std::vector<dataset>* datasets_;
+            const std::vector<std::string>& FILES_;
+            const std::vector<size_t>& FILE_DATASET_;
+            int n_print_;
+            std::ostream* out_;
+            int n_print_conflicts_;
+            Long64_t n_conflicts_;
+            std::vector<Long64_t> overlaps_;
+            std::vector<key_record> group_;
+            std::vector<int> per_dataset_;
+
+            // Count the records [BEGIN, END) as one event
+            void CountEvent(const size_t BEGIN, const size_t END);
+            void Print(std::ostream& stream, const size_t BEGIN, const size_t END) const;
+    };
+
+    void DuplicateCounter::Flush() {
+        if (group_.empty()) {
+            return;
+        }
+
+        // Lumi 0 is unknown and sorts first; split the rest by lumi
+        std::sort(group_.begin(), group_.end(), LumiLess);
+        size_t n_unknown = 0;
+        while (n_unknown < group_.size() && group_[n_unknown].lumi == 0) {
+            ++n_unknown;
+        }
+        std::vector<size_t> starts;  // Of each known lumi
+        for (size_t i = n_unknown; i < group_.size(); ++i) {
+            if (i == n_unknown || group_[i].lumi != group_[i - 1].lumi) {
+                starts.push_back(i);
+            }
+        }
+        starts.push_back(group_.size());
+
+        if (starts.size() <= 2) {
+            // At most one known lumi, which the unknown ones join
+            CountEvent(0, group_.size());
+        }
+        else {
+            for (size_t i = 0; i + 1 < starts.size(); ++i) {
+                CountEvent(starts[i], starts[i + 1]);
+            }
+            if (n_unknown > 0) {
+                CountEvent(0, n_unknown);
+                ++n_conflicts_;
+                if (n_print_conflicts_ > 0) {
+                    --n_print_conflicts_;
+                    std::cout << "Unknown lumi section for run " << KeyRun(group_[0].key);
+                    std::cout << " event " << KeyEvent(group_[0].key) << ", which is in ";
+                    std::cout << starts.size() - 1 << " lumi sections" << std::endl;
+                }
+            }
+        }
+        group_.clear();
+    }
+
+    void DuplicateCounter::CountEvent(const size_t BEGIN, const size_t END) {
+        per_dataset_.assign(datasets_->size(), 0);
+        for (size_t i = BEGIN; i < END; ++i) {
+            ++per_dataset_[FILE_DATASET_[group_[i].file]];
+        }
+        bool duplicated = false;
+        for (size_t i = 0; i < per_dataset_.size(); ++i) {
+            if (per_dataset_[i] == 0) {
+                continue;
+            }
+            dataset& data = (*datasets_)[i];
+            ++data.n_events;
+            if (per_dataset_[i] > 1) {
+                ++data.n_duplicated_events;
+                data.n_extra_entries += per_dataset_[i] - 1;
+                duplicated = true;
+            }
+            for (size_t j = i + 1; j < per_dataset_.size(); ++j) {
+                if (per_dataset_[j] != 0) {
+                    ++overlaps_[i * per_dataset_.size() + j];
+                    ++overlaps_[j * per_dataset_.size() + i];
+                }
+            }
+        }
+
+        if (duplicated) {
+            if (n_print_ > 0) {
+                --n_print_;
+                Print(std::cout, BEGIN, END);
+            }
+            if (out_ != nullptr) {
+                Print(*out_, BEGIN, END);
+            }
+        }
+    }
+
+    void DuplicateCounter::Print(std::ostream& stream, const size_t BEGIN, const size_t END) const {
+        // run:lumi:event dataset file entry, one line per entry
+        for (size_t i = BEGIN; i < END; ++i) {
+            const key_record& RECORD = group_[i];
+            stream << KeyRun(RECORD.key) << ":" << RECORD.lumi << ":" << KeyEvent(RECORD.key);
+            stream << " " << (*datasets_)[FILE_DATASET_[RECORD.file]].name;
+            stream << " " << FILES_[RECORD.file] << " " << RECORD.entry << std::endl;
+        }
+    }
+
+    std::string SpillPath(const std::string& WORK_DIR, const size_t N) {
+        std::ostringstream path;
+        path << WORK_DIR << "/EventDupFind_" << getpid() << "_" << N << ".bin";
+        return path.str();
+    }
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string zdef = "Combined Single Reco";
+    size_t memory_mb = 1024;
+    std::string work_dir = ".";
+    std::string output_name;
+    int n_print = 20;
+    std::vector<dataset> datasets;
+    for (int i = 1; i < argc; ++i) {
+        const std::string ARG = argv[i];
+        const bool HAS_VALUE = (i + 1 < argc);
+        if (ARG == "-z" && HAS_VALUE) {
+            zdef = argv[++i];
+        }
+        else if (ARG == "-m" && HAS_VALUE) {
+            memory_mb = atoi(argv[++i]);
+        }
+        else if (ARG == "-w" && HAS_VALUE) {
+            work_dir = argv[++i];
+        }
+        else if (ARG == "-o" && HAS_VALUE) {
+            output_name = argv[++i];
+        }
+        else if (ARG == "-p" && HAS_VALUE) {
+            n_print = atoi(argv[++i]);
+        }
+        else if (ARG == "-d" && HAS_VALUE) {
+            dataset data;
+            data.name = argv[++i];
+            data.zdef = zdef;
+            data.n_events = 0;
+            data.n_duplicated_events = 0;
+            data.n_extra_entries = 0;
+            datasets.push_back(data);
+        }
+        else if (!datasets.empty() && ARG[0] != '-') {
+            const std::vector<std::string> FILES = ExpandFileLists(std::vector<std::string>(1, ARG));
+            datasets.back().files.insert(datasets.back().files.end(), FILES.begin(), FILES.end());
+        }
+        else {
+            datasets.clear();
+            break;
+        }
+    }
+    if (datasets.empty() || memory_mb == 0) {
+        std::cout << "Not enough arguments." << std::endl;
+        std::cout << "Usage: EventDupFind.exe [-z ZDEF] [-m MB] [-w DIR] [-o FILE] [-p N] -d NAME input.root [...] [-d NAME input.root [...]] ..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Half of the memory holds the records, the other half the radix sort
+    // buffer
+    const size_t MAX_RECORDS = memory_mb * 1024 * 1024 / (2 * sizeof(key_record));
+    std::vector<key_record> records;
+    std::vector<key_record> buffer;
+    records.reserve(MAX_RECORDS);
+    std::vector<std::string> spills;
+    std::vector<std::string> files;  // Every input, in the order read
+    std::vector<size_t> file_dataset;
+
+    for (size_t i_data = 0; i_data < datasets.size(); ++i_data) {
+        const dataset& DATA = datasets[i_data];
+        const std::string TREE_NAME = "ZFinder/" + DATA.zdef + "/" + DATA.zdef;
+        for (auto& i_file : DATA.files) {
+            TFile file(i_file.c_str(), "READ");
+            TTree* tree = nullptr;
+            file.GetObject(TREE_NAME.c_str(), tree);
+            if (!tree) {
+                throw std::runtime_error("Failed to load the tree " + TREE_NAME + " from " + i_file);
+            }
+            if (tree->GetEntries() > 0xffffffffLL) {
+                throw std::runtime_error("Too many entries in " + i_file);
+            }
+            const uint32_t FILE_NUMBER = files.size();
+            files.push_back(i_file);
+            file_dataset.push_back(i_data);
 
-int main() {
-    // Get a map of the histograms of the Z Masses
-    const std::string Tree_HighCut = "ZFinder/Combined Single Reco/Combined Single Reco";
-    const std::string Tree_LowCut = "ZFinder/Combined Single Lowered Threshold Reco/Combined Single Lowered Threshold Reco";
-    const std::string file_name = "/data/whybee0a/user/gude_2/Data/20150324_SingleElectron_2012ALL/hadded.root";
-    // Open the file and load the tree
-    TTree* treeH = GetTTree(file_name, Tree_HighCut);
-    TBranch* event_infoH = treeH->GetBranch("event_info");
-    TLeaf* EVNumbH = event_infoH->GetLeaf("event_number");
-    // Pack into a hitogram
-    std::set<int> eventnumber;
-    std::set<int> eventnumberLow;
-    for (int i = 0; i < treeH->GetEntries(); i++) {
-        treeH->GetEntry(i);
-        if (eventnumber.find(EVNumbH->GetValue()) == eventnumber.end()) {
-            eventnumber.insert(EVNumbH->GetValue());
-        } else {
-            cout << "multiple events numbered :" << EVNumbH->GetValue()<<" in higher cuts" << endl;
+            const EventIndex INDEX(tree);
+            if (!INDEX.HasLumi()) {
+                std::cout << i_file << ": no event_index tree, lumi sections not compared" << std::endl;
+            }
+            for (auto& i_rec : INDEX) {
+                key_record record;
+                record.key = PackKey(i_rec.run, i_rec.event);
+                record.lumi = i_rec.lumi;
+                record.file = FILE_NUMBER;
+                record.entry = i_rec.entry;
+                record.unused = 0;
+                records.push_back(record);
+                if (records.size() >= MAX_RECORDS) {
+                    RadixSort(&records, &buffer);
+                    const std::string PATH = SpillPath(work_dir, spills.size());
+                    std::ofstream spill(PATH.c_str(), std::ios::binary);
+                    spill.write(reinterpret_cast<const char*>(&records[0]), records.size() * sizeof(key_record));
+                    if (!spill) {
+                        throw std::runtime_error("Failed to write " + PATH);
+                    }
+                    spills.push_back(PATH);
+                    records.clear();
+                }
+            }
         }
+        std::cout << "Read " << DATA.files.size() << " files of " << DATA.name << std::endl;
+    }
 
+    std::ofstream output;
+    if (!output_name.empty()) {
+        output.open(output_name.c_str());
+        if (!output) {
+            throw std::runtime_error("Failed to write " + output_name);
+        }
     }
+    DuplicateCounter counter(&datasets, files, file_dataset, n_print, output_name.empty() ? nullptr : &output);
 
-    TTree* TreeLow = GetTTree(file_name, Tree_LowCut);
-    TBranch* event_infoL = TreeLow->GetBranch("event_info");
-    TLeaf* EVNumbLow = event_infoL->GetLeaf("event_number");
-    for (int i = 0; i < TreeLow->GetEntries(); i++) {
-        TreeLow->GetEntry(i);
-        eventnumberLow.insert(EVNumbLow->GetValue());
-        if (eventnumberLow.find(EVNumbLow->GetValue()) == eventnumber.end()) {
-            eventnumberLow.insert(EVNumbLow->GetValue());
-        } else {
-cout << "multiple events numbered :" << EVNumbLow->GetValue()<<" in lowered cuts" << endl;
+    RadixSort(&records, &buffer);
+    std::vector<key_record>().swap(buffer);
+    if (spills.empty()) {
+        for (auto& i_record : records) {
+            counter.Add(i_record);
+        }
+    }
+    else {
+        // Merge the runs on disk and the one in memory, smallest key first
+        std::cout << "Merging " << spills.size() + 1 << " sorted runs" << std::endl;
+        std::vector<RunReader*> readers;
+        for (auto& i_spill : spills) {
+            readers.push_back(new RunReader(i_spill));
         }
+        typedef std::pair<uint64_t, size_t> head;  // key, reader (or readers.size() for memory)
+        std::priority_queue<head, std::vector<head>, std::greater<head> > heads;
+        for (size_t i = 0; i < readers.size(); ++i) {
+            if (!readers[i]->Done()) {
+                heads.push(head(readers[i]->Current().key, i));
+            }
+        }
+        size_t memory_pos = 0;
+        if (!records.empty()) {
+            heads.push(head(records[0].key, readers.size()));
+        }
+        while (!heads.empty()) {
+            const size_t SOURCE = heads.top().second;
+            heads.pop();
+            if (SOURCE == readers.size()) {
+                counter.Add(records[memory_pos]);
+                if (++memory_pos < records.size()) {
+                    heads.push(head(records[memory_pos].key, SOURCE));
+                }
+            }
+            else {
+                RunReader* reader = readers[SOURCE];
+                counter.Add(reader->Current());
+                reader->Next();
+                if (!reader->Done()) {
+                    heads.push(head(reader->Current().key, SOURCE));
+                }
+            }
+        }
+        for (size_t i = 0; i < readers.size(); ++i) {
+            delete readers[i];
+            std::remove(spills[i].c_str());
+        }
+    }
+    counter.Flush();
 
+    // Summary
+    for (auto& i_data : datasets) {
+        std::cout << i_data.name << " (" << i_data.zdef << "): " << i_data.n_events << " events, ";
+        std::cout << i_data.n_duplicated_events << " duplicated, " << i_data.n_extra_entries << " extra entries" << std::endl;
+    }
+    for (size_t i = 0; i < datasets.size(); ++i) {
+        for (size_t j = i + 1; j < datasets.size(); ++j) {
+            std::cout << "In both " << datasets[i].name << " and " << datasets[j].name << ": ";
+            std::cout << counter.Overlap(i, j) << std::endl;
+        }
+    }
+    if (counter.Conflicts() > 0) {
+        std::cout << counter.Conflicts() << " events with an unknown lumi section that is ambiguous" << std::endl;
     }
 
     return EXIT_SUCCESS;
@@ -1,106 +1,305 @@
 // Standard Library
-#include <stdexcept>
+#include <cstdlib>  // atoi
+#include <functional>  // std::cref
 #include <iostream>
-#include <sstream>
+#include <stdexcept>  // std::runtime_error
+#include <string>
+#include <thread>  // std::thread
+#include <vector>
 
 // ROOT
+#include <TDirectory.h>
 #include <TFile.h>
-#include <TBranch.h>
-#include <TCanvas.h>
-#include <TMath.h>
-#include <TLeaf.h>
-
-#include "TH1.h"
+#include <TH1D.h>
 #include <TTree.h>
-#include "TSystem.h"
 
-#include <algorithm>
-#include <set>
-#include <vector>
-using namespace std; // yeah I am evil, get over it
-
-TTree* GetTTree(const std::string TFILE, const std::string TTREE) {
-  // Open the TFiles
-  TFile* mc_tfile = new TFile(TFILE.c_str(), "READ");
-  if (!mc_tfile || mc_tfile->IsZombie()) {
-    const std::string ERR = "Could not open the file " + TFILE;
-    throw std::runtime_error(ERR);
-  }
-
-  // Load the tree
-  TTree* tree = new TTree();
-  mc_tfile->GetObject(TTREE.c_str(), tree);
-  if (!tree || tree->IsZombie()) {
-    const std::string ERR = "Could not open the TTree " + TTREE;
-    throw std::runtime_error(ERR);
-  }
-
-  return tree;
-}
+// ZFinder
+#include "../zdef_tree/event_index.h"  // EventIndex
+#include "../zdef_tree/tuple_binning.h"  // tuple_axis, ParseBinning, FindBin
+#include "../zdef_tree/tuple_expression.h"  // TupleExpression
+#include "../zdef_tree/zdef_tree_reader.h"  // ZDefTreeReader, GetTTree
+
+/*
+ * Compare the events of two ZDefinition trees, for example "Combined Single
+ * Reco" and "Combined Single Lowered Threshold Reco".
+ *
+ * Usage:
+ *
+ *     TreeComp.exe [options] output.root left.root [right.root]
+ *
+ * Options:
+ *
+ *     -l ZDEF                  the left ZDefinition (default "Combined Single Reco")
+ *     -r ZDEF                  the right ZDefinition (default "Combined Single
+ *                              Lowered Threshold Reco")
+ *     -h NAME:EXPRESSION:BINS  a histogram for each category
+ *     -d NAME:EXPRESSION:BINS  a histogram of right - left for matched events
+ *     -j N                     the number of filling threads (default 4)
+ *
+ * Without right.root both trees are read from left.root. Without -h, the
+ * electron pt and eta are plotted (E_Pt0, E_Pt1, E_Eta0, E_Eta1). EXPRESSION
+ * is a TupleExpression, and BINS are as in fill_histograms ("N LOW HIGH",
+ * "edges E0 E1 ...", or "atlas_phistar").
+ *
+ * The events are joined on (run, lumi, event) with the EventIndex of each
+ * tree (on (run, event) if either has no event_index tree), with one merge
+ * of the two sorted indexes. Then each tree is read once in batches: the
+ * right tree fills the right_only histograms and stores the values of the
+ * -d expressions of its matched events, and the left tree fills the
+ * left_only and both histograms and the residuals. The histograms are in the
+ * directories left_only, right_only, both, and residuals of the output.
+ */
+
+namespace {
+    struct histogram_spec {
+        std::string name;
+        std::string expression;
+        tuple_axis bins;
+    };
+
+    histogram_spec ParseHistogram(const std::string& ARG) {
+        const size_t FIRST = ARG.find(':');
+        const size_t SECOND = (FIRST == std::string::npos) ? FIRST : ARG.find(':', FIRST + 1);
+        if (SECOND == std::string::npos || FIRST == 0) {
+            throw std::runtime_error("The histogram \"" + ARG + "\" is not NAME:EXPRESSION:BINS");
+        }
+        histogram_spec spec;
+        spec.name = ARG.substr(0, FIRST);
+        spec.expression = ARG.substr(FIRST + 1, SECOND - FIRST - 1);
+        spec.bins = ParseBinning(ARG.substr(SECOND + 1));
+        return spec;
+    }
+
+    enum category {
+        LEFT_ONLY = 0,
+        RIGHT_ONLY = 1,
+        BOTH = 2,
+        RESIDUAL = 3,
+        N_CATEGORIES = 4
+    };
+    const char* const CATEGORY_NAMES[] = {"left_only", "right_only", "both", "residuals"};
+
+    // What to do with the entries of one tree
+    struct side {
+        bool is_left;
+        std::vector<TupleExpression*> histograms;
+        std::vector<TupleExpression*> residuals;
+        std::vector<Long64_t> matches;  // The match number of each entry, or -1
+    };
+
+    // One thread's bin counts, [category][histogram][bin]
+    typedef std::vector<std::vector<std::vector<double> > > counts;
+
+    void FillRows(
+            const side& SIDE,
+            const std::vector<histogram_spec>& HISTOGRAMS,
+            const std::vector<histogram_spec>& RESIDUALS,
+            const ZDefTreeReader::batch& BATCH,
+            const size_t FIRST,
+            const size_t LAST,
+            std::vector<double>* right_values,
+            counts* out
+            ) {
+        const size_t N_RESIDUALS = RESIDUALS.size();
+        for (size_t row = FIRST; row < LAST; ++row) {
+            const Long64_t MATCH = SIDE.matches[BATCH.first + row];
+            // The right tree only stores its values of matched events, one
+            // slot per match, so threads never write the same element
+            if (!SIDE.is_left && MATCH >= 0) {
+                for (size_t i = 0; i < N_RESIDUALS; ++i) {
+                    (*right_values)[MATCH * N_RESIDUALS + i] = SIDE.residuals[i]->Evaluate(BATCH, row);
+                }
+                continue;
+            }
+
+            const category CATEGORY = !SIDE.is_left ? RIGHT_ONLY : (MATCH >= 0 ? BOTH : LEFT_ONLY);
+            for (size_t i = 0; i < HISTOGRAMS.size(); ++i) {
+                ++(*out)[CATEGORY][i][FindBin(HISTOGRAMS[i].bins, SIDE.histograms[i]->Evaluate(BATCH, row))];
+            }
+            if (CATEGORY == BOTH) {
+                for (size_t i = 0; i < N_RESIDUALS; ++i) {
+                    const double DELTA = (*right_values)[MATCH * N_RESIDUALS + i] - SIDE.residuals[i]->Evaluate(BATCH, row);
+                    ++(*out)[RESIDUAL][i][FindBin(RESIDUALS[i].bins, DELTA)];
+                }
+            }
+        }
+    }
+
+    // Reads every entry of the tree of READER and fills the histograms
+    void ReadSide(
+            ZDefTreeReader* reader,
+            const side& SIDE,
+            const std::vector<histogram_spec>& HISTOGRAMS,
+            const std::vector<histogram_spec>& RESIDUALS,
+            const int N_THREADS,
+            std::vector<double>* right_values,
+            std::vector<counts>* thread_counts
+            ) {
+        // Fill one batch while the next one is read
+        const Long64_t BATCH_SIZE = 20000;
+        ZDefTreeReader::batch batches[2];
+        int current = 0;
+        Long64_t first = 0;
+        reader->ReadBatch(first, BATCH_SIZE, &batches[current]);
+        while (batches[current].size > 0) {
+            const ZDefTreeReader::batch& BATCH = batches[current];
+            const size_t SIZE = BATCH.size;
+            std::vector<std::thread> workers;
+            for (int i = 0; i < N_THREADS; ++i) {
+                const size_t BEGIN = SIZE * i / N_THREADS;
+                const size_t END = SIZE * (i + 1) / N_THREADS;
+                workers.push_back(std::thread(
+                            FillRows, std::cref(SIDE), std::cref(HISTOGRAMS), std::cref(RESIDUALS),
+                            std::cref(BATCH), BEGIN, END, right_values, &(*thread_counts)[i]
+                            ));
+            }
+
+            first += BATCH.size;
+            reader->ReadBatch(first, BATCH_SIZE, &batches[1 - current]);
+
+            for (auto& i_worker : workers) {
+                i_worker.join();
+            }
+            current = 1 - current;
+        }
+    }
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string left_zdef = "Combined Single Reco";
+    std::string right_zdef = "Combined Single Lowered Threshold Reco";
+    std::vector<histogram_spec> histograms;
+    std::vector<histogram_spec> residuals;
+    int n_threads = 4;
+    int arg = 1;
+    while (arg + 1 < argc && argv[arg][0] == '-') {
+        const std::string OPTION = argv[arg];
+        const std::string VALUE = argv[arg + 1];
+        if (OPTION == "-l") {
+            left_zdef = VALUE;
+        }
+        else if (OPTION == "-r") {
+            right_zdef = VALUE;
+        }
+        else if (OPTION == "-h") {
+            histograms.push_back(ParseHistogram(VALUE));
+        }
+        else if (OPTION == "-d") {
+            residuals.push_back(ParseHistogram(VALUE));
+        }
+        else if (OPTION == "-j") {
+            n_threads = atoi(VALUE.c_str());
+        }
+        else {
+            std::cout << "Unknown option " << OPTION << std::endl;
+            return EXIT_FAILURE;
+        }
+        arg += 2;
+    }
+    if (argc - arg < 2 || argc - arg > 3 || n_threads < 1) {
+        std::cout << "Not enough arguments." << std::endl;
+        std::cout << "Usage: TreeComp.exe [-l ZDEF] [-r ZDEF] [-h NAME:EXPRESSION:BINS] [-d NAME:EXPRESSION:BINS] [-j N] output.root left.root [right.root]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::string OUTPUT_FILE = argv[arg];
+    const std::string LEFT_FILE = argv[arg + 1];
+    const std::string RIGHT_FILE = (argc - arg == 3) ? argv[arg + 2] : LEFT_FILE;
+    if (histograms.empty()) {
+        histograms.push_back(ParseHistogram("E_Pt0:reco.e_pt0:700 0 700"));
+        histograms.push_back(ParseHistogram("E_Pt1:reco.e_pt1:700 0 700"));
+        histograms.push_back(ParseHistogram("E_Eta0:reco.e_eta0:200 -10 10"));
+        histograms.push_back(ParseHistogram("E_Eta1:reco.e_eta1:200 -10 10"));
+    }
+
+    // Join the two trees. The indexes are built before the readers, which
+    // switch off the branches they do not use.
+    TTree* left_tree = GetTTree(LEFT_FILE, "ZFinder/" + left_zdef + "/" + left_zdef);
+    TTree* right_tree = GetTTree(RIGHT_FILE, "ZFinder/" + right_zdef + "/" + right_zdef);
+    side left;
+    side right;
+    left.is_left = true;
+    right.is_left = false;
+    Long64_t n_matched = 0;
+    {
+        const EventIndex LEFT_INDEX(left_tree);
+        const EventIndex RIGHT_INDEX(right_tree);
+        if (!LEFT_INDEX.HasLumi() || !RIGHT_INDEX.HasLumi()) {
+            std::cout << "No event_index tree, events are matched by run and event number" << std::endl;
+        }
+        const std::vector<std::pair<Long64_t, Long64_t> > MATCHES = LEFT_INDEX.Match(RIGHT_INDEX);
+        left.matches.assign(left_tree->GetEntries(), -1);
+        right.matches.assign(right_tree->GetEntries(), -1);
+        for (size_t i = 0; i < MATCHES.size(); ++i) {
+            left.matches[MATCHES[i].first] = i;
+            right.matches[MATCHES[i].second] = i;
+        }
+        n_matched = MATCHES.size();
+    }
+
+    ZDefTreeReader left_reader(left_tree);
+    ZDefTreeReader right_reader(right_tree);
+    for (auto& i_histo : histograms) {
+        left.histograms.push_back(new TupleExpression(i_histo.expression, &left_reader));
+        right.histograms.push_back(new TupleExpression(i_histo.expression, &right_reader));
+    }
+    for (auto& i_residual : residuals) {
+        left.residuals.push_back(new TupleExpression(i_residual.expression, &left_reader));
+        right.residuals.push_back(new TupleExpression(i_residual.expression, &right_reader));
+    }
+
+    std::vector<counts> thread_counts(n_threads, counts(N_CATEGORIES));
+    for (auto& i_thread : thread_counts) {
+        for (int i_cat = 0; i_cat < N_CATEGORIES; ++i_cat) {
+            const std::vector<histogram_spec>& SPECS = (i_cat == RESIDUAL) ? residuals : histograms;
+            for (auto& i_spec : SPECS) {
+                i_thread[i_cat].push_back(std::vector<double>(i_spec.bins.NBins() + 2, 0.));
+            }
+        }
+    }
+
+    // The right tree first, so the left tree can take the residuals
+    std::vector<double> right_values(n_matched * residuals.size());
+    ReadSide(&right_reader, right, histograms, residuals, n_threads, &right_values, &thread_counts);
+    ReadSide(&left_reader, left, histograms, residuals, n_threads, &right_values, &thread_counts);
+
+    TFile output(OUTPUT_FILE.c_str(), "RECREATE");
+    for (int i_cat = 0; i_cat < N_CATEGORIES; ++i_cat) {
+        TDirectory* dir = output.mkdir(CATEGORY_NAMES[i_cat]);
+        dir->cd();
+        const std::vector<histogram_spec>& SPECS = (i_cat == RESIDUAL) ? residuals : histograms;
+        for (size_t i_histo = 0; i_histo < SPECS.size(); ++i_histo) {
+            const histogram_spec& SPEC = SPECS[i_histo];
+            const std::string TITLE = (i_cat == RESIDUAL) ? "right - left: " + SPEC.expression : SPEC.expression;
+            TH1D* histo = new TH1D(SPEC.name.c_str(), TITLE.c_str(), SPEC.bins.NBins(), &SPEC.bins.edges[0]);
+            double entries = 0;
+            for (size_t i_bin = 0; i_bin < SPEC.bins.NBins() + 2; ++i_bin) {
+                double sum = 0;
+                for (auto& i_thread : thread_counts) {
+                    sum += i_thread[i_cat][i_histo][i_bin];
+                }
+                histo->SetBinContent(i_bin, sum);
+                entries += sum;
+            }
+            histo->SetEntries(entries);
+        }
+    }
+    output.Write();
+    output.Close();
+
+    std::cout << left_zdef << ": " << left_tree->GetEntries() << " entries" << std::endl;
+    std::cout << right_zdef << ": " << right_tree->GetEntries() << " entries" << std::endl;
+    std::cout << "Both: " << n_matched << std::endl;
+    std::cout << "Only " << left_zdef << ": " << left_tree->GetEntries() - n_matched << std::endl;
+    std::cout << "Only " << right_zdef << ": " << right_tree->GetEntries() - n_matched << std::endl;
+
+    for (size_t i = 0; i < histograms.size(); ++i) {
+        delete left.histograms[i];
+        delete right.histograms[i];
+    }
+    for (size_t i = 0; i < residuals.size(); ++i) {
+        delete left.residuals[i];
+        delete right.residuals[i];
+    }
 
-int main() {
-  // Get a map of the histograms of the Z Masses
-  const std::string Tree_HighCut = "ZFinder/Combined Single Reco/Combined Single Reco";
-  const std::string Tree_LowCut = "ZFinder/Combined Single Lowered Threshold Reco/Combined Single Lowered Threshold Reco";
-  const std::string file_name = "/data/whybee0a/user/gude_2/Data/20150324_SingleElectron_2012ALL/hadded.root";
-  // Open the file and load the tree
-  TTree* treeH = GetTTree(file_name, Tree_HighCut);
-  TBranch* event_infoH = treeH->GetBranch("event_info");
-  TLeaf* EVNumbH = event_infoH->GetLeaf("event_number");
-  // Pack into a hitogram
-  std::set<int> eventnumber;
-  std::set<int> eventnumberLow;
-  for (int i = 0; i < treeH->GetEntries(); i++) {
-    treeH->GetEntry(i);
-    eventnumber.insert(EVNumbH->GetValue());
-
-  }
-
-  TH1 *EPt0Hist = new TH1F("E_Pt0", "PT of e0", 700, 0, 700);
-  TH1 *EPt1Hist = new TH1F("E_Pt1", "PT of e1", 700, 0, 700);
-
-  TH1 *EEta0Hist = new TH1F("E_Eta0", "Eta of e0", 200, -10, 10);
-  TH1 *EEta1Hist = new TH1F("E_Eta1", "Eta of e1", 200, -10, 10);
-
-  TTree* TreeLow = GetTTree(file_name, Tree_LowCut);
-  TBranch* event_infoL = TreeLow->GetBranch("event_info");
-  TLeaf* EVNumbLow = event_infoL->GetLeaf("event_number");
-  TBranch* RecoLow = TreeLow->GetBranch("reco");
-  TLeaf* EPt0 = RecoLow->GetLeaf("e_pt0");
-  TLeaf* EPt1 = RecoLow->GetLeaf("e_pt1");
-  TLeaf* EEta0 = RecoLow->GetLeaf("e_eta0");
-  TLeaf* EEta1 = RecoLow->GetLeaf("e_eta1");
-  int j=0;
-  for (int i = 0; i < TreeLow->GetEntries(); i++) {
-    TreeLow->GetEntry(i);
-
-    if (!(i % 50000))cout << " still going :" << i << endl;
-    eventnumberLow.insert(EVNumbLow->GetValue());
-    if (eventnumber.find(EVNumbLow->GetValue()) == eventnumber.end()) {
-      EPt0Hist->Fill(EPt0->GetValue());
-      EPt1Hist->Fill(EPt1->GetValue());
-      EEta0Hist->Fill(EEta0->GetValue());
-      EEta1Hist->Fill(EEta1->GetValue());
-      j++;
-    } 
-
-  }
-  TFile *theFile = new TFile("Diffevents.root", "RECREATE");
-  theFile->cd();
-  EPt0Hist->Write();
-  EPt1Hist->Write();
-  EEta0Hist->Write();
-  EEta1Hist->Write();
-
-  EPt0Hist->Delete();
-  EPt1Hist->Delete();
-  EEta0Hist->Delete();
-  EEta1Hist->Delete();
-  cout<<" NUMBER IN THE HIGH :"<<treeH->GetEntries()<<endl;
-  cout<<"Number of things in High :"<<eventnumber.size()<<endl;
-  cout<<"NUmber in Low :"<<TreeLow->GetEntries()<<endl;
-  cout<<"NUMBER THAT is in low :"<<eventnumberLow.size()<<endl;
-  cout<<"NUMBER THAT WE SHOULD HAVE :"<<TreeLow->GetEntries()-treeH->GetEntries()<<endl;
-  cout<<"HOW MANY DO WE HAVE :"<<j<<endl;
-  return EXIT_SUCCESS;
+    return EXIT_SUCCESS;
 }
@@ -3,30 +3,11 @@
 #include <iostream>
 
 // ROOT
-#include <TFile.h>
 #include <TTree.h>
-#include <TBranch.h>
-#include <TLeaf.h>
 
+// ZFinder
+#include "../zdef_tree/zdef_tree_reader.h"  // ZDefTreeReader, GetTTree
 
-TTree* GetTTree(const std::string TFILE, const std::string TTREE) {
-    // Open the TFiles
-    TFile* mc_tfile = new TFile(TFILE.c_str(), "READ");
-    if (!mc_tfile || mc_tfile->IsZombie()) {
-        const std::string ERR = "Could not open the file " + TFILE;
-        throw std::runtime_error(ERR);
-    }
-
-    // Load the tree
-    TTree* tree = new TTree();
-    mc_tfile->GetObject(TTREE.c_str(), tree);
-    if (!tree || tree->IsZombie()) {
-        const std::string ERR = "Could not open the TTree " + TTREE;
-        throw std::runtime_error(ERR);
-    }
-
-    return tree;
-}
 
 int main() {
     // Input Files
@@ -40,16 +21,20 @@ int main() {
     // Load the tree
     TTree* tree = GetTTree(DATA_FILE, TREE_NAME);
 
-    // Get the branch
-    TBranch* reco_branch = tree->GetBranch("reco");
-    TLeaf* z_pt = reco_branch->GetLeaf("z_pt");
+    // Get the variable; it is read a block of entries at a time
+    ZDefTreeReader reader(tree);
+    const size_t Z_PT = reader.Column("reco", "z_pt");
 
     double sum = 0;
     int counter = 0;
-    for (int i = 0; i < tree->GetEntries(); i++) {
-        tree->GetEntry(i);
-        sum += z_pt->GetValue();
-        counter++;
+    const Long64_t BATCH_SIZE = 10000;
+    ZDefTreeReader::batch batch;
+    for (Long64_t i = 0; i < reader.GetEntries(); i += BATCH_SIZE) {
+        reader.ReadBatch(i, BATCH_SIZE, &batch);
+        for (auto& i_z_pt : batch.columns[Z_PT]) {
+            sum += i_z_pt;
+            counter++;
+        }
     }
 
     std::cout << "Sum of Pt: " << sum << std::endl;
@@ -0,0 +1,91 @@
+// Standard Library
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+// ZFinder
+#include "../../interface/ColumnarFile.h"  // ColumnarFile
+
+/*
+ * Prints the columns and row groups of a columnar file written by
+ * ZDefinitionTree or zdef_to_columns, and the mean of every single value
+ * column. It does not need ROOT, and is a small example of reading the
+ * columns through zf::ColumnarFile.
+ *
+ * Usage:
+ *
+ *     columnar_info.exe file.zcol
+ */
+
+namespace {
+    const char* TypeName(const uint32_t TYPE) {
+        switch (TYPE) {
+            case zf::COLUMN_DOUBLE: return "double";
+            case zf::COLUMN_FLOAT: return "float";
+            case zf::COLUMN_INT: return "int";
+            case zf::COLUMN_UINT: return "uint";
+            case zf::COLUMN_BOOL: return "bool";
+            case zf::COLUMN_LONG: return "long";
+        }
+        return "unknown";
+    }
+
+    template <typename T>
+    double Mean(const zf::ColumnarFile& INPUT, const std::string& NAME) {
+        const zf::column_span<T> COLUMN = INPUT.Column<T>(NAME);
+        double sum = 0;
+        for (auto& i_value : COLUMN) {
+            sum += i_value;
+        }
+        return COLUMN.size > 0 ? sum / COLUMN.size : 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::cout << "Not enough arguments." << std::endl;
+        std::cout << "Usage: columnar_info.exe file.zcol" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        const zf::ColumnarFile INPUT(argv[1]);
+        std::cout << INPUT.NRows() << " rows" << std::endl;
+        for (uint32_t i = 0; i < INPUT.NColumns(); ++i) {
+            const zf::columnar_column& COL = INPUT.ColumnInfo(i);
+            std::cout << COL.name << " " << TypeName(COL.type);
+            if (COL.width == 0) {
+                std::cout << "[]";
+            }
+            else if (COL.width > 1) {
+                std::cout << "[" << COL.width << "]";
+            }
+            std::cout << " " << COL.n_values << " values";
+            if (COL.width == 1) {
+                double mean = 0;
+                switch (COL.type) {
+                    case zf::COLUMN_DOUBLE: mean = Mean<double>(INPUT, COL.name); break;
+                    case zf::COLUMN_FLOAT: mean = Mean<float>(INPUT, COL.name); break;
+                    case zf::COLUMN_INT: mean = Mean<int32_t>(INPUT, COL.name); break;
+                    case zf::COLUMN_UINT: mean = Mean<uint32_t>(INPUT, COL.name); break;
+                    case zf::COLUMN_BOOL: mean = Mean<bool>(INPUT, COL.name); break;
+                    case zf::COLUMN_LONG: mean = Mean<int64_t>(INPUT, COL.name); break;
+                }
+                std::cout << ", mean " << mean;
+            }
+            std::cout << std::endl;
+        }
+        for (auto& i_group : INPUT.RowGroups()) {
+            std::cout << "Run " << i_group.run << ": rows " << i_group.first_row;
+            std::cout << " to " << i_group.first_row + i_group.n_rows - 1 << std::endl;
+        }
+    }
+    catch (const std::exception& ERR) {
+        std::cout << ERR.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
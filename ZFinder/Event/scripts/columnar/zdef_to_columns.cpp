@@ -0,0 +1,210 @@
+// Standard Library
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// ROOT
+#include <TFile.h>
+#include <TTree.h>
+
+// ZFinder
+#include "../zdef_tree/zdef_tree_reader.h"  // ZDefTreeReader
+#include "../../interface/ColumnarFile.h"  // ColumnarWriter
+
+/*
+ * Converts a ZDefinition tree (either layout) to a columnar file, with the
+ * same columns that ZDefinitionTree writes with tree_columnar_dir set. See
+ * interface/ColumnarFile.h for the format, and columnar_info for a reader.
+ *
+ * Usage:
+ *
+ *     zdef_to_columns.exe [-r] input.root "ZFinder/<zdef>/<zdef>" output.zcol
+ *
+ * With -r the rows are sorted into one row group per run.
+ */
+
+namespace {
+    // The kinematic variables of one prefix ("reco" or "truth"), read
+    // through ZDefTreeReader and written as the split layout names
+    class KinematicColumns {
+        public:
+            KinematicColumns(ZDefTreeReader* reader, zf::ColumnarWriter* writer, const std::string& PREFIX) : writer_(writer) {
+                const std::string P = PREFIX + "_";
+                const std::string Z_NAMES[] = {
+                    "z_m", "z_y", "z_phistar_born", "z_phistar_dressed",
+                    "z_phistar_naked", "z_phistar_sc", "z_pt", "z_eta"
+                };
+                for (auto& i_name : Z_NAMES) {
+                    z_values_.push_back(&reader->Variable(PREFIX, i_name));
+                    z_columns_.push_back(writer_->AddColumn<float>(P + i_name));
+                }
+                const std::string E_NAMES[] = {"e_pt", "e_eta", "e_phi", "e_rnine"};
+                for (auto& i_name : E_NAMES) {
+                    e_values_.push_back(&reader->Variable(PREFIX, i_name + "0"));
+                    e_values_.push_back(&reader->Variable(PREFIX, i_name + "1"));
+                    e_columns_.push_back(writer_->AddColumn<float>(P + i_name, 2));
+                }
+                n_true_pileup_ = &reader->Variable(PREFIX, "n_true_pileup");
+                n_true_pileup_column_ = writer_->AddColumn<float>(P + "n_true_pileup");
+                e_charge_[0] = &reader->Variable(PREFIX, "e_charge0");
+                e_charge_[1] = &reader->Variable(PREFIX, "e_charge1");
+                e_charge_column_ = writer_->AddColumn<int32_t>(P + "e_charge", 2);
+                n_verts_ = &reader->Variable(PREFIX, "n_verts");
+                n_verts_column_ = writer_->AddColumn<int32_t>(P + "n_verts");
+                t0tight_ = &reader->Variable(PREFIX, "t0tight");
+                t0tight_column_ = writer_->AddColumn<bool>(P + "t0tight");
+                t1tight_ = &reader->Variable(PREFIX, "t1tight");
+                t1tight_column_ = writer_->AddColumn<bool>(P + "t1tight");
+            }
+
+            void Append() {
+                for (size_t i = 0; i < z_columns_.size(); ++i) {
+                    writer_->Append<float>(z_columns_[i], *z_values_[i]);
+                }
+                for (size_t i = 0; i < e_columns_.size(); ++i) {
+                    const float VALUES[2] = {
+                        static_cast<float>(*e_values_[2 * i]),
+                        static_cast<float>(*e_values_[2 * i + 1])
+                    };
+                    writer_->Append<float>(e_columns_[i], VALUES, 2);
+                }
+                writer_->Append<float>(n_true_pileup_column_, *n_true_pileup_);
+                const int32_t CHARGES[2] = {
+                    static_cast<int32_t>(*e_charge_[0]),
+                    static_cast<int32_t>(*e_charge_[1])
+                };
+                writer_->Append<int32_t>(e_charge_column_, CHARGES, 2);
+                writer_->Append<int32_t>(n_verts_column_, *n_verts_);
+                writer_->Append<bool>(t0tight_column_, *t0tight_ != 0);
+                writer_->Append<bool>(t1tight_column_, *t1tight_ != 0);
+            }
+
+        private:
+            zf::ColumnarWriter* writer_;
+            std::vector<const double*> z_values_;
+            std::vector<int> z_columns_;
+            std::vector<const double*> e_values_;
+            std::vector<int> e_columns_;
+            const double* n_true_pileup_;
+            int n_true_pileup_column_;
+            const double* e_charge_[2];
+            int e_charge_column_;
+            const double* n_verts_;
+            int n_verts_column_;
+            const double* t0tight_;
+            int t0tight_column_;
+            const double* t1tight_;
+            int t1tight_column_;
+    };
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    bool group_by_run = false;
+    if (!args.empty() && args[0] == "-r") {
+        group_by_run = true;
+        args.erase(args.begin());
+    }
+    if (args.size() != 3) {
+        std::cout << "Not enough arguments." << std::endl;
+        std::cout << "Usage: zdef_to_columns.exe [-r] input.root tree_path output.zcol" << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::string INPUT_FILE = args[0];
+    const std::string TREE_NAME = args[1];
+    const std::string OUTPUT_FILE = args[2];
+
+    TFile* tfile = new TFile(INPUT_FILE.c_str(), "READ");
+    if (!tfile || tfile->IsZombie()) {
+        std::cout << "Failed to read TFile: " << INPUT_FILE << std::endl;
+        return EXIT_FAILURE;
+    }
+    TTree* tree;
+    tfile->GetObject(TREE_NAME.c_str(), tree);
+    if (!tree) {
+        std::cout << "Failed to load the tree: " << TREE_NAME << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        ZDefTreeReader reader(tree);
+        zf::ColumnarWriter writer;
+
+        // Columns in the same order as ZDefinitionTree::AddColumns
+        KinematicColumns reco(&reader, &writer, "reco");
+        KinematicColumns* truth = nullptr;
+        if (reader.IsMC()) {
+            truth = new KinematicColumns(&reader, &writer, "truth");
+        }
+        const double& event_number = reader.Variable("event_info", "event_number");
+        const double& run_number = reader.Variable("event_info", "run_number");
+        const double& is_mc = reader.Variable("event_info", "is_mc");
+        const int EVENT_NUMBER = writer.AddColumn<uint32_t>("event_number");
+        const int RUN_NUMBER = writer.AddColumn<uint32_t>("run_number");
+        const int IS_MC = writer.AddColumn<bool>("is_mc");
+
+        // Weights, if the tree has them
+        const bool HAS_WEIGHTS = (tree->GetBranch("weight_size") != nullptr);
+        int weights_column = -1;
+        int weight_ids_column = -1;
+        if (HAS_WEIGHTS) {
+            reader.UseWeights();
+            weights_column = writer.AddColumn<double>("weights", 0);
+            weight_ids_column = writer.AddColumn<int32_t>("weight_ids", 0);
+        }
+        std::vector<std::string> pdf_sets;
+        std::vector<int> pdf_columns;
+        const std::string SETS[] = {"cteq", "mstw", "nnpdf"};
+        for (auto& i_set : SETS) {
+            if (tree->GetBranch(("weight_" + i_set + "_size").c_str()) != nullptr) {
+                reader.UsePDFWeights(i_set);
+                pdf_sets.push_back(i_set);
+                pdf_columns.push_back(writer.AddColumn<double>("weights_" + i_set, 0));
+            }
+        }
+        // weight_fsr is a branch of its own in both layouts, which the
+        // split layout reader finds under "event_info"
+        const double* weight_fsr = nullptr;
+        int weight_fsr_column = -1;
+        if (tree->GetBranch("weight_fsr") != nullptr) {
+            weight_fsr = &reader.Variable(reader.IsSplit() ? "event_info" : "weight_fsr", "weight_fsr");
+            weight_fsr_column = writer.AddColumn<double>("weight_fsr");
+        }
+
+        for (Long64_t i = 0; i < reader.GetEntries(); ++i) {
+            reader.GetEntry(i);
+            reco.Append();
+            if (truth != nullptr) {
+                truth->Append();
+            }
+            writer.Append<uint32_t>(EVENT_NUMBER, static_cast<uint32_t>(event_number));
+            writer.Append<uint32_t>(RUN_NUMBER, static_cast<uint32_t>(run_number));
+            writer.Append<bool>(IS_MC, is_mc != 0);
+            if (HAS_WEIGHTS) {
+                writer.Append<double>(weights_column, reader.weights, reader.weight_size);
+                writer.Append<int32_t>(weight_ids_column, reader.weight_ids, reader.weight_size);
+            }
+            for (size_t i_set = 0; i_set < pdf_sets.size(); ++i_set) {
+                const std::vector<double>& PDF_WEIGHTS = reader.PDFWeights(pdf_sets[i_set]);
+                writer.Append<double>(pdf_columns[i_set], PDF_WEIGHTS.data(), PDF_WEIGHTS.size());
+            }
+            if (weight_fsr != nullptr) {
+                writer.Append<double>(weight_fsr_column, *weight_fsr);
+            }
+            writer.EndRow(static_cast<uint32_t>(run_number));
+        }
+        delete truth;
+
+        writer.Write(OUTPUT_FILE, group_by_run);
+        std::cout << "Wrote " << writer.NRows() << " rows to " << OUTPUT_FILE << std::endl;
+    }
+    catch (const std::exception& ERR) {
+        std::cout << ERR.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
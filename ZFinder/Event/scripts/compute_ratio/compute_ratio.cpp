@@ -5,43 +5,12 @@
 // ROOT
 #include <TFile.h>
 #include <TTree.h>
-#include <TBranch.h>
 #include <TH1D.h>
-#include <TLeaf.h>
 
 // ZFinder
-#include "../../interface/WeightID.h"
+#include "../zdef_tree/zdef_tree_reader.h"  // ZDefTreeReader, GetTTree
 
 
-double GetWeight(
-        const int& WEIGHT_SIZE,
-        const double WEIGHTS[],
-        const int WEIGHTIDS[]
-        ) {
-    double weight = 1.;
-
-    // Loop over the weights and use it if it is one of correct
-    for (int i = 0; i < WEIGHT_SIZE; ++i) {
-        switch (WEIGHTIDS[i]) {
-            case zf::WeightID::GEN_MC:
-            case zf::WeightID::PILEUP:
-            case zf::WeightID::VETO:
-            case zf::WeightID::LOOSE:
-            case zf::WeightID::MEDIUM:
-            case zf::WeightID::TIGHT:
-            case zf::WeightID::SINGLE_TRIG:
-            case zf::WeightID::DOUBLE_TRIG:
-            case zf::WeightID::GSF_RECO:
-                weight *= WEIGHTS[i];
-                break;
-            default:
-                break;
-        }
-    }
-
-    return weight;
-}
-
 double GetOverallNormalization(const std::string NAME) {
     const double DATA_LUMI = 19712;
     const std::map<std::string, double> NORM = {
@@ -58,25 +27,6 @@ double GetOverallNormalization(const std::string NAME) {
     return WEIGHT;
 }
 
-TTree* GetTTree(const std::string TFILE, const std::string TTREE) {
-    // Open the TFiles
-    TFile* mc_tfile = new TFile(TFILE.c_str(), "READ");
-    if (!mc_tfile || mc_tfile->IsZombie()) {
-        const std::string ERR = "Could not open the file " + TFILE;
-        throw std::runtime_error(ERR);
-    }
-
-    // Load the tree
-    TTree* tree = new TTree();
-    mc_tfile->GetObject(TTREE.c_str(), tree);
-    if (!tree || tree->IsZombie()) {
-        const std::string ERR = "Could not open the TTree " + TTREE;
-        throw std::runtime_error(ERR);
-    }
-
-    return tree;
-}
-
 int main() {
     // Variable to read
     const std::string VAR_NAME = "z_y";
@@ -95,11 +45,12 @@ int main() {
     TTree* data_tree = GetTTree(DATA_FILE, DATA_TREE_NAME);
     TTree* mc_tree = GetTTree(MC_FILE, MC_TREE_NAME);
 
-    // Get the branch
-    TBranch* data_reco_branch = data_tree->GetBranch("reco");
-    TBranch* mc_reco_branch = mc_tree->GetBranch("reco");
-    TLeaf* data_variable = data_reco_branch->GetLeaf(VAR_NAME.c_str());
-    TLeaf* mc_variable = mc_reco_branch->GetLeaf(VAR_NAME.c_str());
+    // Get the variable
+    ZDefTreeReader data_reader(data_tree);
+    ZDefTreeReader mc_reader(mc_tree);
+    const double& data_variable = data_reader.Variable("reco", VAR_NAME);
+    const double& mc_variable = mc_reader.Variable("reco", VAR_NAME);
+    mc_reader.UseWeights();
 
     // Open an output file
     TFile output("ratio.root", "RECREATE");
@@ -107,27 +58,17 @@ int main() {
 
     // Fill the data histogram
     TH1D* data_histo = new TH1D("data", "data", 60, -3, 3);
-    for (int i = 0; i < data_tree->GetEntries(); i++) {
-        data_tree->GetEntry(i);
-        data_histo->Fill(data_variable->GetValue());
+    for (int i = 0; i < data_reader.GetEntries(); i++) {
+        data_reader.GetEntry(i);
+        data_histo->Fill(data_variable);
     }
 
-    // We have to grab the first entry to learn how many weights there are
-    int nweights = 0;
-    mc_tree->SetBranchAddress("weight_size", &nweights);
-    mc_tree->GetEntry(0);
-
-    double weights[nweights];
-    int weightid[nweights];
-    mc_tree->SetBranchAddress("weights", &weights);
-    mc_tree->SetBranchAddress("weight_ids", &weightid);
-
     // Fill the MC histogram
     TH1D* mc_histo = new TH1D("mc", "mc", 60, -3, 3);
-    for (int i = 0; i < mc_tree->GetEntries(); i++) {
-        mc_tree->GetEntry(i);
-        const double WEIGHT = GetOverallNormalization("Signal") * GetWeight(nweights, weights, weightid);
-        mc_histo->Fill(mc_variable->GetValue(), WEIGHT);
+    for (int i = 0; i < mc_reader.GetEntries(); i++) {
+        mc_reader.GetEntry(i);
+        const double WEIGHT = GetOverallNormalization("Signal") * mc_reader.Weight();
+        mc_histo->Fill(mc_variable, WEIGHT);
     }
 
     // Make the ratio
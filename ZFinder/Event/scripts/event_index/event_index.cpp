@@ -0,0 +1,107 @@
+// Standard Library
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>  // std::runtime_error
+#include <string>
+#include <vector>
+
+// ROOT
+#include <TFile.h>
+#include <TTree.h>
+
+// ZFinder
+#include "../zdef_tree/event_index.h"  // EventIndex
+
+/*
+ * Look up events in the ZDefinition trees of a ZFinder output file using
+ * their (run, lumi, event) index.
+ *
+ * Usage:
+ *
+ *     event_index.exe file.root "zdef name"
+ *         Print the number of events, runs, and duplicated events
+ *     event_index.exe file.root "zdef name" run:lumi:event
+ *     event_index.exe file.root "zdef name" run:event
+ *         Print the entry of the event, or -1
+ *     event_index.exe file.root "zdef name" "other zdef name"
+ *         Print the number of events in both, and in only one
+ */
+
+TTree* GetTree(TFile* file, const std::string& ZDEF_NAME) {
+    const std::string TREE_NAME = "ZFinder/" + ZDEF_NAME + "/" + ZDEF_NAME;
+    TTree* tree = nullptr;
+    file->GetObject(TREE_NAME.c_str(), tree);
+    if (!tree) {
+        throw std::runtime_error("Failed to load the tree: " + TREE_NAME);
+    }
+    return tree;
+}
+
+bool ParseEventID(const std::string& ARG, std::vector<unsigned int>* numbers) {
+    // Split "run:lumi:event" or "run:event" into numbers
+    numbers->clear();
+    size_t start = 0;
+    while (start <= ARG.size()) {
+        size_t end = ARG.find(':', start);
+        if (end == std::string::npos) {
+            end = ARG.size();
+        }
+        const std::string PART = ARG.substr(start, end - start);
+        if (PART.empty() || PART.find_first_not_of("0123456789") != std::string::npos) {
+            return false;
+        }
+        numbers->push_back(strtoul(PART.c_str(), nullptr, 10));
+        start = end + 1;
+    }
+    return numbers->size() == 2 || numbers->size() == 3;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cout << "Not enough arguments.";
+        std::cout << " Usage: event_index.exe file.root \"zdef name\" [run:lumi:event | \"other zdef name\"]";
+        std::cout << std::endl;
+        return EXIT_FAILURE;
+    }
+    TFile file(argv[1], "READ");
+    const std::string ZDEF_NAME(argv[2]);
+    const EventIndex INDEX(GetTree(&file, ZDEF_NAME));
+
+    // Summary
+    if (argc == 3) {
+        size_t n_runs = 0;
+        for (auto it = INDEX.begin(); it != INDEX.end(); it = INDEX.Run(it->run).second) {
+            ++n_runs;
+        }
+        std::cout << ZDEF_NAME << ": " << INDEX.size() << " events in " << n_runs << " runs";
+        std::cout << ", " << INDEX.Duplicates().size() << " duplicated entries";
+        if (!INDEX.HasLumi()) {
+            std::cout << " (no event_index tree, lumi sections not compared)";
+        }
+        std::cout << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    // Single event
+    const std::string ARG(argv[3]);
+    std::vector<unsigned int> numbers;
+    if (ParseEventID(ARG, &numbers)) {
+        Long64_t entry = -1;
+        if (numbers.size() == 3) {
+            entry = INDEX.Find(numbers[0], numbers[1], numbers[2]);
+        }
+        else {
+            entry = INDEX.Find(numbers[0], numbers[1]);
+        }
+        std::cout << entry << std::endl;
+        return (entry >= 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // Compare two ZDefinitions
+    const EventIndex OTHER(GetTree(&file, ARG));
+    std::cout << "Both: " << INDEX.Intersection(OTHER).size() << std::endl;
+    std::cout << "Only " << ZDEF_NAME << ": " << INDEX.Difference(OTHER).size() << std::endl;
+    std::cout << "Only " << ARG << ": " << OTHER.Difference(INDEX).size() << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,142 @@
+// Interface
+#include "event_table_reader.h"
+
+// Standard Library
+#include <stdexcept>  // std::runtime_error
+
+
+EventTableReader::EventTableReader(TFile* tfile, const std::string DIR) :
+    is_mc_(false),
+    current_zdef_(-1),
+    entry_(-1)
+{
+    if (!tfile || tfile->IsZombie()) {
+        throw std::runtime_error("EventTableReader was given a bad TFile");
+    }
+
+    // Read the names of the ZDefinitions
+    TTree* zdef_tree = nullptr;
+    const std::string ZDEF_TREE = DIR + "/zdefs";
+    tfile->GetObject(ZDEF_TREE.c_str(), zdef_tree);
+    if (!zdef_tree) {
+        const std::string ERR = "Could not open the TTree " + ZDEF_TREE;
+        throw std::runtime_error(ERR);
+    }
+    int index;
+    char name[256];
+    zdef_tree->SetBranchAddress("index", &index);
+    zdef_tree->SetBranchAddress("name", name);
+    zdef_names_.resize(zdef_tree->GetEntries());
+    for (Long64_t i = 0; i < zdef_tree->GetEntries(); ++i) {
+        zdef_tree->GetEntry(i);
+        if (index >= 0 && index < static_cast<int>(zdef_names_.size())) {
+            zdef_names_[index] = name;
+        }
+    }
+
+    // Set up the event tree
+    const std::string EVENT_TREE = DIR + "/events";
+    tfile->GetObject(EVENT_TREE.c_str(), tree_);
+    if (!tree_) {
+        const std::string ERR = "Could not open the TTree " + EVENT_TREE;
+        throw std::runtime_error(ERR);
+    }
+    is_mc_ = (tree_->GetBranch("truth") != nullptr);
+    tree_->SetBranchAddress("reco", &reco);
+    tree_->SetBranchAddress("event_info", &event_info);
+    tree_->SetBranchAddress("zdef_pass", &zdef_pass_);
+    tree_->SetBranchAddress("zdef_t0p1", &zdef_t0p1_);
+    tree_->SetBranchAddress("zdef_t1p0", &zdef_t1p0_);
+    weight_size_ = 0;
+    zdef_weight_size_ = 0;
+    weight_fsr = 1;
+    weight_cteq_size = 0;
+    weight_mstw_size = 0;
+    weight_nnpdf_size = 0;
+    if (is_mc_) {
+        weights_cteq.resize(MaxSize("weight_cteq_size"));
+        weights_mstw.resize(MaxSize("weight_mstw_size"));
+        weights_nnpdf.resize(MaxSize("weight_nnpdf_size"));
+        const size_t ZDEF_WEIGHTS = MaxSize("zdef_weight_size");
+        zdef_weight_zdefs_.resize(ZDEF_WEIGHTS);
+        zdef_weight_ids_.resize(ZDEF_WEIGHTS);
+        zdef_weights_.resize(ZDEF_WEIGHTS);
+        tree_->SetBranchAddress("truth", &truth);
+        tree_->SetBranchAddress("weight_size", &weight_size_);
+        tree_->SetBranchAddress("weights", weights_);
+        tree_->SetBranchAddress("weight_ids", weight_ids_);
+        tree_->SetBranchAddress("weight_cteq_size", &weight_cteq_size);
+        tree_->SetBranchAddress("weights_cteq", &weights_cteq[0]);
+        tree_->SetBranchAddress("weight_mstw_size", &weight_mstw_size);
+        tree_->SetBranchAddress("weights_mstw", &weights_mstw[0]);
+        tree_->SetBranchAddress("weight_nnpdf_size", &weight_nnpdf_size);
+        tree_->SetBranchAddress("weights_nnpdf", &weights_nnpdf[0]);
+        tree_->SetBranchAddress("weight_fsr", &weight_fsr);
+        tree_->SetBranchAddress("zdef_weight_size", &zdef_weight_size_);
+        tree_->SetBranchAddress("zdef_weight_zdefs", &zdef_weight_zdefs_[0]);
+        tree_->SetBranchAddress("zdef_weight_ids", &zdef_weight_ids_[0]);
+        tree_->SetBranchAddress("zdef_weights", &zdef_weights_[0]);
+    }
+}
+
+size_t EventTableReader::MaxSize(const char* NAME) const {
+    const double MAX = tree_->GetMaximum(NAME);
+    return (MAX > 1) ? static_cast<size_t>(MAX) : 1;
+}
+
+void EventTableReader::SetZDefinition(const std::string& NAME) {
+    current_zdef_ = -1;
+    for (unsigned int i = 0; i < zdef_names_.size(); ++i) {
+        if (zdef_names_[i] == NAME) {
+            current_zdef_ = i;
+            break;
+        }
+    }
+    if (current_zdef_ < 0) {
+        const std::string ERR = "The event table has no ZDefinition named " + NAME;
+        throw std::runtime_error(ERR);
+    }
+    entry_ = -1;
+}
+
+bool EventTableReader::Next() {
+    if (current_zdef_ < 0) {
+        throw std::runtime_error("EventTableReader::Next called before SetZDefinition");
+    }
+    const ULong64_t BIT = 1ULL << current_zdef_;
+    // Read only the bitmask until we find a passing event, then read the
+    // rest of the entry
+    TBranch* pass_branch = tree_->GetBranch("zdef_pass");
+    const Long64_t N_ENTRIES = tree_->GetEntries();
+    while (++entry_ < N_ENTRIES) {
+        pass_branch->GetEntry(entry_);
+        if (zdef_pass_ & BIT) {
+            tree_->GetEntry(entry_);
+            // Restore the per ZDefinition tag/probe flags, which
+            // ZDefinitionTree only sets if there is a second electron
+            const bool HAS_E1 = reco.e_pt[1] > -1;
+            reco.t0tight = HAS_E1 && (zdef_t0p1_ & BIT);
+            reco.t1tight = HAS_E1 && (zdef_t1p0_ & BIT);
+            if (is_mc_) {
+                const bool HAS_TRUTH_E1 = truth.e_pt[1] > -1;
+                truth.t0tight = HAS_TRUTH_E1 && (zdef_t0p1_ & BIT);
+                truth.t1tight = HAS_TRUTH_E1 && (zdef_t1p0_ & BIT);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::pair<int, double>> EventTableReader::Weights() const {
+    std::vector<std::pair<int, double>> weights;
+    for (int i = 0; i < weight_size_; ++i) {
+        weights.push_back(std::make_pair(weight_ids_[i], weights_[i]));
+    }
+    for (int i = 0; i < zdef_weight_size_; ++i) {
+        if (zdef_weight_zdefs_[i] == current_zdef_) {
+            weights.push_back(std::make_pair(zdef_weight_ids_[i], zdef_weights_[i]));
+        }
+    }
+    return weights;
+}
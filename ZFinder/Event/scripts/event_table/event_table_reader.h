@@ -0,0 +1,107 @@
+#ifndef EVENT_TABLE_READER_H_
+#define EVENT_TABLE_READER_H_
+
+// Standard Library
+#include <string>
+#include <utility>
+#include <vector>
+
+// ROOT
+#include <TFile.h>
+#include <TTree.h>
+
+/*
+ * The branches written by ZEventTable (and ZDefinitionTree).
+ */
+struct table_branch {
+    double z_m;
+    double z_y;
+    double z_phistar_born;
+    double z_phistar_dressed;
+    double z_phistar_naked;
+    double z_phistar_sc;
+    double z_pt;
+    double z_eta;
+    double e_pt[2];
+    double e_eta[2];
+    double e_phi[2];
+    double e_rnine[2];
+    double n_true_pileup;
+    int e_charge[2];
+    int n_verts;
+    bool t0tight;
+    bool t1tight;
+};
+
+struct table_event_branch {
+    unsigned int event_number;
+    unsigned int run_number;
+    bool is_mc;
+};
+
+/*
+ * Reads the "events" tree written by ZEventTable and presents the events
+ * passing one ZDefinition at a time, with the branches filled the way
+ * ZDefinitionTree would have filled them for that ZDefinition.
+ */
+class EventTableReader {
+    public:
+        EventTableReader(TFile* tfile, const std::string DIR = "ZFinder/Event Table");
+
+        // The ZDefinitions in the table, in bit order
+        const std::vector<std::string>& ZDefinitionNames() const { return zdef_names_; }
+
+        // Select the ZDefinition to read and go back to the first event
+        void SetZDefinition(const std::string& NAME);
+
+        // Advance to the next event passing the current ZDefinition. Returns
+        // false when there are no more.
+        bool Next();
+
+        // The event weights followed by the scale factors of the current
+        // ZDefinition, as (WeightID, weight) pairs
+        std::vector<std::pair<int, double>> Weights() const;
+
+        bool IsMC() const { return is_mc_; }
+
+        // Contents of the current event
+        table_branch reco;
+        table_branch truth;
+        table_event_branch event_info;
+        double weight_fsr;
+        int weight_cteq_size;
+        int weight_mstw_size;
+        int weight_nnpdf_size;
+        // Sized for the largest set in the table when it is opened, so they
+        // do not move while it is read
+        std::vector<double> weights_cteq;
+        std::vector<double> weights_mstw;
+        std::vector<double> weights_nnpdf;
+
+    protected:
+        TTree* tree_;
+        std::vector<std::string> zdef_names_;
+        bool is_mc_;
+        int current_zdef_;
+        Long64_t entry_;
+
+        ULong64_t zdef_pass_;
+        ULong64_t zdef_t0p1_;
+        ULong64_t zdef_t1p0_;
+
+        static const int MAX_SIZE = 100;
+        int weight_size_;
+        int weight_ids_[MAX_SIZE];
+        double weights_[MAX_SIZE];
+
+        int zdef_weight_size_;
+        std::vector<int> zdef_weight_zdefs_;
+        std::vector<int> zdef_weight_ids_;
+        std::vector<double> zdef_weights_;
+
+        // The largest value of the size branch NAME, and at least 1 so the
+        // buffers have an address
+        size_t MaxSize(const char* NAME) const;
+};
+
+#endif  // EVENT_TABLE_READER_H_
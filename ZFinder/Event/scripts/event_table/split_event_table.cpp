@@ -0,0 +1,116 @@
+// Standard Library
+#include <iostream>
+#include <stdexcept>  // std::runtime_error
+#include <string>
+#include <vector>
+
+// ROOT
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TTree.h>
+
+// Event Table
+#include "event_table_reader.h"
+
+/*
+ * Convert the "Event Table" written by ZFinder with use_event_table = True
+ * back into one tree per ZDefinition, with the same directory names and
+ * branches ZDefinitionTree writes. This lets scripts that expect the per
+ * ZDefinition trees run on the new output.
+ *
+ * Usage:
+ *
+ *     split_event_table.exe input.root output.root [zdef name ...]
+ *
+ * If no ZDefinition names are given, every ZDefinition in the table is
+ * written.
+ */
+
+void WriteZDefinition(EventTableReader* reader, const std::string& NAME, TFile* outfile) {
+    reader->SetZDefinition(NAME);
+
+    outfile->cd();
+    TDirectory* zfinder_dir = outfile->GetDirectory("ZFinder");
+    if (!zfinder_dir) {
+        zfinder_dir = outfile->mkdir("ZFinder");
+    }
+    TDirectory* zdef_dir = zfinder_dir->mkdir(NAME.c_str());
+    zdef_dir->cd();
+
+    // Same branches as ZDefinitionTree. The weight buffers grow with the
+    // number of weights, and their branches are pointed at them again.
+    int weight_size;
+    std::vector<double> weights(1);
+    std::vector<int> weight_ids(1);
+
+    TTree* tree = new TTree(NAME.c_str(), NAME.c_str());
+    const std::string CODE = "z_m/D:z_y:z_phistar_born:z_phistar_dressed:z_phistar_naked:z_phistar_sc:z_pt:z_eta:e_pt0:e_pt1:e_eta0:e_eta1:e_phi0:e_phi1:e_rnine0:e_rnine1:n_true_pileup:e_charge0/I:e_charge1:n_verts:t0tight/O:t1tight";
+    tree->Branch("reco", &reader->reco, CODE.c_str());
+    if (reader->IsMC()) {
+        tree->Branch("truth", &reader->truth, CODE.c_str());
+    }
+    const std::string EVENT_CODE = "event_number/i:run_number:is_mc/O";
+    tree->Branch("event_info", &reader->event_info, EVENT_CODE.c_str());
+    if (reader->IsMC()) {
+        tree->Branch("weight_size", &weight_size, "weight_size/I");
+        tree->Branch("weights", &weights[0], "weights[weight_size]/D");
+        tree->Branch("weight_ids", &weight_ids[0], "weight_ids[weight_size]/I");
+        tree->Branch("weight_cteq_size", &reader->weight_cteq_size, "weight_cteq_size/I");
+        tree->Branch("weights_cteq", &reader->weights_cteq[0], "weights_cteq[weight_cteq_size]/D");
+        tree->Branch("weight_mstw_size", &reader->weight_mstw_size, "weight_mstw_size/I");
+        tree->Branch("weights_mstw", &reader->weights_mstw[0], "weights_mstw[weight_mstw_size]/D");
+        tree->Branch("weight_nnpdf_size", &reader->weight_nnpdf_size, "weight_nnpdf_size/I");
+        tree->Branch("weights_nnpdf", &reader->weights_nnpdf[0], "weights_nnpdf[weight_nnpdf_size]/D");
+        tree->Branch("weight_fsr", &reader->weight_fsr, "weight_fsr/D");
+    }
+
+    while (reader->Next()) {
+        const std::vector<std::pair<int, double>> WEIGHTS = reader->Weights();
+        weight_size = WEIGHTS.size();
+        if (weights.size() < WEIGHTS.size()) {
+            weights.resize(WEIGHTS.size());
+            weight_ids.resize(WEIGHTS.size());
+            tree->SetBranchAddress("weights", &weights[0]);
+            tree->SetBranchAddress("weight_ids", &weight_ids[0]);
+        }
+        for (int i = 0; i < weight_size; ++i) {
+            weight_ids[i] = WEIGHTS[i].first;
+            weights[i] = WEIGHTS[i].second;
+        }
+        tree->Fill();
+    }
+
+    tree->Write();
+    std::cout << NAME << ": " << tree->GetEntries() << " events" << std::endl;
+    delete tree;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cout << "Not enough arguments.";
+        std::cout << " Usage: split_event_table.exe input.root output.root [zdef name ...]";
+        std::cout << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::string INPUT_FILE(argv[1]);
+    const std::string OUTPUT_FILE(argv[2]);
+
+    TFile infile(INPUT_FILE.c_str(), "READ");
+    EventTableReader reader(&infile);
+
+    std::vector<std::string> names;
+    for (int i = 3; i < argc; ++i) {
+        names.push_back(argv[i]);
+    }
+    if (names.empty()) {
+        names = reader.ZDefinitionNames();
+    }
+
+    TFile outfile(OUTPUT_FILE.c_str(), "RECREATE");
+    for (auto& i_name : names) {
+        WriteZDefinition(&reader, i_name, &outfile);
+    }
+    outfile.Close();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,421 @@
+// Standard Library
+#include <cmath>  // sqrt
+#include <cstdlib>  // atoi
+#include <fstream>
+#include <functional>  // std::cref
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>  // std::runtime_error
+#include <string>
+#include <thread>  // std::thread
+#include <vector>
+
+// ROOT
+#include <TFile.h>
+#include <TH1D.h>
+#include <TH2D.h>
+
+// ZFinder
+#include "../../interface/WeightID.h"  // WeightID
+#include "../zdef_tree/tuple_binning.h"  // tuple_axis, ParseBinning, FindBin
+#include "../zdef_tree/tuple_expression.h"  // TupleExpression
+#include "../zdef_tree/zdef_tree_reader.h"  // ZDefTreeReader, ExpandFileLists
+
+/*
+ * Fill many histograms from a ZDefinition tree in a single pass.
+ *
+ * Usage:
+ *
+ *     fill_histograms.exe [-j N] [-b N] spec.txt output.root input.root [input.root ...]
+ *
+ * An input starting with "@" is a text file with one input file per line.
+ * The inputs are read as one chain with ZDefTreeReader, in batches of -b
+ * entries (default 20000). While one batch is read the previous one is
+ * split between -j threads (default 4), each filling its own copy of every
+ * histogram, and the copies are added at the end.
+ *
+ * The spec file has one setting per line; "#" starts a comment:
+ *
+ *     tree ZFinder/Combined Single Reco/Combined Single Reco
+ *     # A selection before the first histogram applies to all of them
+ *     selection reco.z_m > 60 && reco.z_m < 120
+ *
+ *     histogram phistar
+ *     title #phi* of the reconstructed Z
+ *     x reco.z_phistar_dressed
+ *     x_bins atlas_phistar
+ *     weights standard
+ *
+ *     histogram mass_vs_y
+ *     x abs(reco.z_y)
+ *     x_bins 20 0 2.4
+ *     y reco.z_m
+ *     y_bins edges 60 70 80 85 90 95 100 110 120
+ *     selection reco.e_pt0 > 30
+ *     weights GEN_MC PILEUP
+ *
+ * x, y, and selection are TupleExpressions of the tree variables. Bins are
+ * given as "N LOW HIGH", "edges E0 E1 ...", or "atlas_phistar". Histograms
+ * with a y axis are TH2Ds. The axis titles are the expressions, unless the
+ * title sets them ("title;x title;y title"). weights lists the WeightIDs
+ * whose weights are multiplied ("standard" is the set used by GetWeight);
+ * without it entries have a weight of 1. An entry is filled if the
+ * selection is not 0.
+ */
+
+namespace {
+    struct axis_spec {
+        std::string expression;
+        tuple_axis bins;
+    };
+
+    struct histogram_spec {
+        std::string name;
+        std::string title;
+        axis_spec x;
+        axis_spec y;
+        std::string selection;
+        std::vector<std::string> weights;
+    };
+
+    struct spec {
+        std::string tree;
+        std::string selection;
+        std::vector<histogram_spec> histograms;
+    };
+
+    const std::map<std::string, int> WEIGHT_NAMES = {
+        {"GEN_MC", zf::WeightID::GEN_MC},
+        {"PILEUP", zf::WeightID::PILEUP},
+        {"PILEUP_PLUS", zf::WeightID::PILEUP_PLUS},
+        {"PILEUP_MINUS", zf::WeightID::PILEUP_MINUS},
+        {"VETO", zf::WeightID::VETO},
+        {"LOOSE", zf::WeightID::LOOSE},
+        {"MEDIUM", zf::WeightID::MEDIUM},
+        {"TIGHT", zf::WeightID::TIGHT},
+        {"SINGLE_TRIG", zf::WeightID::SINGLE_TRIG},
+        {"DOUBLE_TRIG", zf::WeightID::DOUBLE_TRIG},
+        {"GSF_RECO", zf::WeightID::GSF_RECO},
+    };
+
+    void SpecError(const std::string& PATH, const int LINE, const std::string& WHAT) {
+        std::ostringstream err;
+        err << PATH << ":" << LINE << ": " << WHAT;
+        throw std::runtime_error(err.str());
+    }
+
+    spec ReadSpec(const std::string& PATH) {
+        std::ifstream in(PATH.c_str());
+        if (!in) {
+            throw std::runtime_error("Could not open the spec file " + PATH);
+        }
+
+        spec out;
+        std::string line;
+        int line_number = 0;
+        while (std::getline(in, line)) {
+            ++line_number;
+            std::istringstream words(line);
+            std::string key;
+            if (!(words >> key) || key[0] == '#') {
+                continue;
+            }
+            std::string value;
+            std::getline(words, value);
+            // "#" is also used in ROOT titles, so titles keep theirs
+            const size_t COMMENT = value.find('#');
+            if (COMMENT != std::string::npos && key != "title") {
+                value.erase(COMMENT);
+            }
+            const size_t START = value.find_first_not_of(" \t");
+            value = (START == std::string::npos) ? "" : value.substr(START);
+            const size_t END = value.find_last_not_of(" \t\r");
+            value = (END == std::string::npos) ? "" : value.substr(0, END + 1);
+
+            if (key == "tree") {
+                out.tree = value;
+                continue;
+            }
+            if (key == "histogram") {
+                if (value.empty()) {
+                    SpecError(PATH, line_number, "a histogram needs a name");
+                }
+                histogram_spec histo;
+                histo.name = value;
+                histo.title = value;
+                out.histograms.push_back(histo);
+                continue;
+            }
+            if (out.histograms.empty()) {
+                if (key == "selection") {
+                    out.selection = value;
+                    continue;
+                }
+                SpecError(PATH, line_number, "\"" + key + "\" must follow a histogram line");
+            }
+
+            histogram_spec& histo = out.histograms.back();
+            if (key == "title") {
+                histo.title = value;
+            }
+            else if (key == "x") {
+                histo.x.expression = value;
+            }
+            else if (key == "y") {
+                histo.y.expression = value;
+            }
+            else if (key == "x_bins") {
+                try {
+                    histo.x.bins = ParseBinning(value);
+                }
+                catch (std::runtime_error& e) {
+                    SpecError(PATH, line_number, e.what());
+                }
+            }
+            else if (key == "y_bins") {
+                try {
+                    histo.y.bins = ParseBinning(value);
+                }
+                catch (std::runtime_error& e) {
+                    SpecError(PATH, line_number, e.what());
+                }
+            }
+            else if (key == "selection") {
+                histo.selection = value;
+            }
+            else if (key == "weights") {
+                std::istringstream names(value);
+                std::string name;
+                while (names >> name) {
+                    if (name != "standard" && WEIGHT_NAMES.find(name) == WEIGHT_NAMES.end()) {
+                        SpecError(PATH, line_number, "unknown weight " + name);
+                    }
+                    histo.weights.push_back(name);
+                }
+            }
+            else {
+                SpecError(PATH, line_number, "unknown setting " + key);
+            }
+        }
+
+        if (out.tree.empty()) {
+            throw std::runtime_error("The spec file " + PATH + " does not set the tree");
+        }
+        for (auto& i_histo : out.histograms) {
+            if (i_histo.x.expression.empty() || i_histo.x.bins.edges.empty()) {
+                throw std::runtime_error("The histogram " + i_histo.name + " needs x and x_bins");
+            }
+            if (i_histo.y.expression.empty() != i_histo.y.bins.edges.empty()) {
+                throw std::runtime_error("The histogram " + i_histo.name + " needs both y and y_bins, or neither");
+            }
+        }
+        return out;
+    }
+
+    // A histogram compiled against the reader
+    struct histogram_job {
+        const histogram_spec* spec;
+        TupleExpression* x;
+        TupleExpression* y;
+        TupleExpression* selection;
+        bool standard_weight;
+        unsigned long long weight_mask;  // Bit i set for WeightID i
+        size_t n_bins_x;
+        size_t n_bins_y;
+    };
+
+    // One thread's copy of a histogram, with the ROOT bin numbering
+    // including the underflow and overflow
+    struct accumulator {
+        std::vector<double> sum_weight;
+        std::vector<double> sum_weight2;
+        Long64_t entries;
+    };
+
+    void FillRows(
+            const std::vector<histogram_job>& JOBS,
+            const ZDefTreeReader::batch& BATCH,
+            const size_t FIRST,
+            const size_t LAST,
+            std::vector<accumulator>* accumulators
+            ) {
+        for (size_t i_job = 0; i_job < JOBS.size(); ++i_job) {
+            const histogram_job& JOB = JOBS[i_job];
+            accumulator& acc = (*accumulators)[i_job];
+            for (size_t row = FIRST; row < LAST; ++row) {
+                if (JOB.selection != nullptr && JOB.selection->Evaluate(BATCH, row) == 0) {
+                    continue;
+                }
+
+                double weight = JOB.standard_weight ? BATCH.weights[row] : 1.;
+                if (JOB.weight_mask != 0) {
+                    for (size_t i = BATCH.weight_offsets[row]; i < BATCH.weight_offsets[row + 1]; ++i) {
+                        const int ID = BATCH.weight_ids[i];
+                        if (ID >= 0 && ID < 64 && (JOB.weight_mask >> ID) & 1) {
+                            weight *= BATCH.weight_values[i];
+                        }
+                    }
+                }
+
+                size_t bin = FindBin(JOB.spec->x.bins, JOB.x->Evaluate(BATCH, row));
+                if (JOB.y != nullptr) {
+                    bin += (JOB.n_bins_x + 2) * FindBin(JOB.spec->y.bins, JOB.y->Evaluate(BATCH, row));
+                }
+                acc.sum_weight[bin] += weight;
+                acc.sum_weight2[bin] += weight * weight;
+                ++acc.entries;
+            }
+        }
+    }
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int n_threads = 4;
+    Long64_t batch_size = 20000;
+    int arg = 1;
+    while (arg + 1 < argc && argv[arg][0] == '-') {
+        const std::string OPTION = argv[arg];
+        if (OPTION == "-j") {
+            n_threads = atoi(argv[arg + 1]);
+        }
+        else if (OPTION == "-b") {
+            batch_size = atoi(argv[arg + 1]);
+        }
+        else {
+            std::cout << "Unknown option " << OPTION << std::endl;
+            return EXIT_FAILURE;
+        }
+        arg += 2;
+    }
+    if (argc - arg < 3 || n_threads < 1 || batch_size < 1) {
+        std::cout << "Not enough arguments." << std::endl;
+        std::cout << "Usage: fill_histograms.exe [-j N] [-b N] spec.txt output.root input.root [input.root ...]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::string SPEC_FILE = argv[arg];
+    const std::string OUTPUT_FILE = argv[arg + 1];
+    const std::vector<std::string> INPUTS = ExpandFileLists(std::vector<std::string>(argv + arg + 2, argv + argc));
+
+    const spec SPEC = ReadSpec(SPEC_FILE);
+    ZDefTreeReader reader(INPUTS, SPEC.tree);
+
+    // Compile every expression, which also tells the reader which variables
+    // to read
+    std::vector<histogram_job> jobs;
+    bool use_weights = false;
+    for (auto& i_histo : SPEC.histograms) {
+        histogram_job job;
+        job.spec = &i_histo;
+        job.x = new TupleExpression(i_histo.x.expression, &reader);
+        job.y = i_histo.y.expression.empty() ? nullptr : new TupleExpression(i_histo.y.expression, &reader);
+        std::string selection = i_histo.selection;
+        if (!SPEC.selection.empty()) {
+            selection = selection.empty() ? SPEC.selection : "(" + SPEC.selection + ") && (" + selection + ")";
+        }
+        job.selection = selection.empty() ? nullptr : new TupleExpression(selection, &reader);
+        job.standard_weight = false;
+        job.weight_mask = 0;
+        for (auto& i_weight : i_histo.weights) {
+            if (i_weight == "standard") {
+                job.standard_weight = true;
+            }
+            else {
+                job.weight_mask |= 1ULL << WEIGHT_NAMES.at(i_weight);
+            }
+        }
+        use_weights = use_weights || !i_histo.weights.empty();
+        job.n_bins_x = i_histo.x.bins.NBins();
+        job.n_bins_y = (job.y != nullptr) ? i_histo.y.bins.NBins() : 0;
+        jobs.push_back(job);
+    }
+    if (use_weights) {
+        reader.UseWeights();
+    }
+
+    // Every thread gets its own accumulators
+    std::vector<std::vector<accumulator> > accumulators(n_threads);
+    for (auto& i_thread : accumulators) {
+        for (auto& i_job : jobs) {
+            accumulator acc;
+            const size_t N_CELLS = (i_job.n_bins_x + 2) * ((i_job.y != nullptr) ? i_job.n_bins_y + 2 : 1);
+            acc.sum_weight.assign(N_CELLS, 0.);
+            acc.sum_weight2.assign(N_CELLS, 0.);
+            acc.entries = 0;
+            i_thread.push_back(acc);
+        }
+    }
+
+    // Fill one batch while the next one is read
+    ZDefTreeReader::batch batches[2];
+    int current = 0;
+    Long64_t first = 0;
+    reader.ReadBatch(first, batch_size, &batches[current]);
+    while (batches[current].size > 0) {
+        const ZDefTreeReader::batch& BATCH = batches[current];
+        const size_t SIZE = BATCH.size;
+        std::vector<std::thread> workers;
+        for (int i = 0; i < n_threads; ++i) {
+            const size_t BEGIN = SIZE * i / n_threads;
+            const size_t END = SIZE * (i + 1) / n_threads;
+            workers.push_back(std::thread(FillRows, std::cref(jobs), std::cref(BATCH), BEGIN, END, &accumulators[i]));
+        }
+
+        first += BATCH.size;
+        reader.ReadBatch(first, batch_size, &batches[1 - current]);
+
+        for (auto& i_worker : workers) {
+            i_worker.join();
+        }
+        current = 1 - current;
+    }
+    std::cout << "Read " << first << " entries" << std::endl;
+
+    // Add the threads' accumulators into the histograms
+    TFile output(OUTPUT_FILE.c_str(), "RECREATE");
+    output.cd();
+    for (size_t i_job = 0; i_job < jobs.size(); ++i_job) {
+        const histogram_job& JOB = jobs[i_job];
+        const histogram_spec& HISTO = *JOB.spec;
+        TH1* histo = nullptr;
+        if (JOB.y == nullptr) {
+            histo = new TH1D(HISTO.name.c_str(), HISTO.title.c_str(), JOB.n_bins_x, &HISTO.x.bins.edges[0]);
+        }
+        else {
+            histo = new TH2D(HISTO.name.c_str(), HISTO.title.c_str(), JOB.n_bins_x, &HISTO.x.bins.edges[0], JOB.n_bins_y, &HISTO.y.bins.edges[0]);
+        }
+        // Titles like "title;x;y" already set the axis titles
+        if (HISTO.title.find(';') == std::string::npos) {
+            histo->GetXaxis()->SetTitle(HISTO.x.expression.c_str());
+            if (JOB.y != nullptr) {
+                histo->GetYaxis()->SetTitle(HISTO.y.expression.c_str());
+            }
+        }
+        histo->Sumw2();
+
+        Long64_t entries = 0;
+        const size_t N_CELLS = accumulators[0][i_job].sum_weight.size();
+        for (size_t i_cell = 0; i_cell < N_CELLS; ++i_cell) {
+            double sum_weight = 0;
+            double sum_weight2 = 0;
+            for (auto& i_thread : accumulators) {
+                sum_weight += i_thread[i_job].sum_weight[i_cell];
+                sum_weight2 += i_thread[i_job].sum_weight2[i_cell];
+            }
+            histo->SetBinContent(i_cell, sum_weight);
+            histo->SetBinError(i_cell, sqrt(sum_weight2));
+        }
+        for (auto& i_thread : accumulators) {
+            entries += i_thread[i_job].entries;
+        }
+        histo->SetEntries(entries);
+
+        delete JOB.x;
+        delete JOB.y;
+        delete JOB.selection;
+    }
+    output.Write();
+    output.Close();
+
+    return EXIT_SUCCESS;
+}
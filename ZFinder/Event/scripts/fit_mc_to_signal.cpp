@@ -1,5 +1,7 @@
+#include <cmath>
 #include <string>
 #include <iostream>
+#include <vector>
 
 #include "TH1I.h"
 #include "TFile.h"
@@ -9,13 +11,16 @@
 #include <TROOT.h>
 #include <TStyle.h>
 
+#include "same_sign/TemplateFit.h"
+
 int MakePlots(
          const std::string input_data_file,
          const std::string input_mc_file,
          const std::string data_hist_name,
          const std::string mc_hist_name,
          const std::string output_file,
-         const std::string title
+         const std::string title,
+         const bool fit
         ) {
     /* Open the root file */
     TFile* in_tfile_data = new TFile(input_data_file.c_str(), "READ");
@@ -61,6 +66,53 @@ int MakePlots(
     const double data_area = data_hist->Integral();
     mc_hist->Scale(data_area / mc_area);
 
+    /*
+     * Fit the data to the MC plus the QCD background shape, and scale the MC
+     * to its fitted share of the data instead
+     */
+    std::string norm_text = "MC normalized to data";
+    if (fit) {
+        // The starting values and limits of the background shape are those
+        // of the same sign fits, which are made to Z mass histograms from 0
+        // to 300 GeV
+        const double LOW_EDGE = data_hist->GetXaxis()->GetXmin();
+        const double HIGH_EDGE = data_hist->GetXaxis()->GetXmax();
+        if (std::abs(LOW_EDGE) > 1e-6 || std::abs(HIGH_EDGE - 300.) > 1e-6) {
+            std::cout << "Only Z mass histograms from 0 to 300 GeV can be fit, not ";
+            std::cout << LOW_EDGE << " to " << HIGH_EDGE << std::endl;
+            return 1;
+        }
+        if (mc_hist->GetNbinsX() != data_hist->GetNbinsX()
+                || std::abs(mc_hist->GetXaxis()->GetXmin() - LOW_EDGE) > 1e-6
+                || std::abs(mc_hist->GetXaxis()->GetXmax() - HIGH_EDGE) > 1e-6) {
+            std::cout << "The data and MC histograms must have the same binning to be fit" << std::endl;
+            return 1;
+        }
+        std::vector<double> edges;
+        std::vector<double> mc_contents;
+        std::vector<double> data_contents;
+        for (int i = 1; i <= data_hist->GetNbinsX(); ++i) {
+            edges.push_back(data_hist->GetBinLowEdge(i));
+            mc_contents.push_back(mc_hist->GetBinContent(i));
+            data_contents.push_back(data_hist->GetBinContent(i));
+        }
+        edges.push_back(data_hist->GetBinLowEdge(data_hist->GetNbinsX() + 1));
+
+        const TemplateFit fitter(edges, mc_contents);
+        const TemplateFit::result result = fitter.Fit(data_contents);
+        if (!result.converged) {
+            std::cout << "The fit did not converge" << std::endl;
+        }
+        const double signal_fraction = result.values[TemplateFit::SIGNAL_FRACTION];
+        const double signal_error = sqrt(result.covariance[TemplateFit::SIGNAL_FRACTION][TemplateFit::SIGNAL_FRACTION]);
+        const std::pair<double, double> background = fitter.BackgroundFraction(result, 60., 120.);
+        std::cout << "Signal fraction: " << signal_fraction << " +- " << signal_error << std::endl;
+        std::cout << "Background fraction in 60-120 GeV: " << background.first << " +- " << background.second << std::endl;
+
+        mc_hist->Scale(signal_fraction);
+        norm_text = "MC fit to data";
+    }
+
     /* Figure out the largest Y value and set the plot accordingly */
     const double DATA_MAX = data_hist->GetMaximum();
     const double MC_MAX = mc_hist->GetMaximum();
@@ -92,7 +144,7 @@ int MakePlots(
     lumi_label->SetTextAngle(0);
 
     /* Add normalization method */
-    TLatex *norm_label = new TLatex(.8, .75, "MC normalized to data");
+    TLatex *norm_label = new TLatex(.8, .75, norm_text.c_str());
     norm_label->SetNDC();
     norm_label->SetTextFont(42);
     norm_label->SetTextColor(1);
@@ -126,7 +178,7 @@ int MakePlots(
 
 int main(int argc, char* argv[]) {
     const int argcLow = 6;
-    const int argcHigh = 8;
+    const int argcHigh = 9;
 
     if (argc <= argcLow) {
         std::cout<<"Not enough arguments.";
@@ -142,11 +194,18 @@ int main(int argc, char* argv[]) {
         std::string mc_hist_name(argv[4]);
         std::string output_file(argv[5]);
         std::string title(argv[6]);
-
-        return MakePlots(input_data_file, input_mc_file, data_hist_name, mc_hist_name, output_file, title);
+        // An optional "fit" fits the MC and a QCD background to the data
+        // instead of normalizing the areas
+        const bool fit = (argc == argcHigh - 1);
+        if (fit && std::string(argv[7]) != "fit") {
+            std::cout << "Unknown option " << argv[7] << ", the only option is \"fit\".";
+            return 1;
+        }
+
+        return MakePlots(input_data_file, input_mc_file, data_hist_name, mc_hist_name, output_file, title, fit);
     }
 }
 
 /* Compile time notes:
- *    g++ -O2 -o fit_mc_to_signal.exe fit_mc_to_signal.cpp `root-config --cflags --libs`
+ *    g++ -O2 -std=c++0x -o fit_mc_to_signal.exe fit_mc_to_signal.cpp same_sign/TemplateFit.cpp `root-config --cflags --libs`
  */
@@ -0,0 +1,284 @@
+#!/usr/bin/env python
+
+"""Run ZFinder over the files in one or more file lists (for example
+Metadata/filelists/*.txt) one cmsRun job per input file, and merge the outputs.
+
+The state of every input file is saved in WORK_DIR/state.json after each job
+finishes, so a killed run can be restarted with the same command and only the
+files that are not done are processed. A file is done if its job succeeded
+with the current configuration and the file has not changed since. The
+configuration is identified by a hash of `edmConfigDump` of it (or of the file
+itself if edmConfigDump is not available); if it changes, every file is
+processed again.
+
+The merged result (WORK_DIR/merged.root by default) is updated incrementally
+by merging only the new outputs into it with merge_zfinder.exe. If a file that
+is already in the result was removed from the lists or reprocessed, the result
+is merged again from all the outputs instead.
+
+Usage:
+
+    zfinder_jobs.py -w WORK_DIR [-j N] config_cfg.py filelist.txt [...]
+
+The configuration must define process.source (a PoolSource) and
+process.TFileService; the jobs replace their file names.
+"""
+
+from hashlib import sha1
+from optparse import OptionParser
+from os import environ, makedirs, rename, remove
+from os.path import abspath, basename, dirname, exists, getsize, isdir, join
+from subprocess import Popen, PIPE
+from sys import exit
+from time import sleep
+import json
+
+
+# Bytes read from the start and end of an input file for its fingerprint
+FINGERPRINT_BYTES = 1 << 16
+
+
+def file_fingerprint(path):
+    """A hash of the size and the first and last FINGERPRINT_BYTES of a file.
+    ROOT files keep their header at the start and their keys and streamer
+    info at the end, so any rewrite changes one of them, and the file does
+    not have to be read in full.
+    """
+    path = strip_file_prefix(path)
+    size = getsize(path)
+    digest = sha1(str(size).encode())
+    with open(path, 'rb') as f:
+        digest.update(f.read(FINGERPRINT_BYTES))
+        if size > FINGERPRINT_BYTES:
+            f.seek(max(FINGERPRINT_BYTES, size - FINGERPRINT_BYTES))
+            digest.update(f.read(FINGERPRINT_BYTES))
+    return digest.hexdigest()
+
+
+def config_hash(config):
+    """Hash the full configuration as cmsRun sees it, including the
+    imported cfi files. Falls back to the configuration file alone.
+    """
+    try:
+        dump = Popen(["edmConfigDump", config], stdout=PIPE, stderr=PIPE, cwd=dirname(config))
+        (out, err) = dump.communicate()
+        if dump.returncode == 0:
+            return sha1(out).hexdigest()
+    except OSError:
+        pass
+    print("edmConfigDump failed, hashing only " + config)
+    with open(config, 'rb') as f:
+        return sha1(f.read()).hexdigest()
+
+
+def strip_file_prefix(path):
+    if path.startswith("file:"):
+        return path[len("file:"):]
+    return path
+
+
+def read_file_lists(file_lists):
+    files = []
+    seen = set()
+    for file_list in file_lists:
+        with open(file_list) as f:
+            for line in f:
+                line = line.strip()
+                if line and not line.startswith('#') and line not in seen:
+                    seen.add(line)
+                    files.append(line)
+    return files
+
+
+class State(object):
+    """The jobs done so far, saved as JSON after every change."""
+
+    def __init__(self, work_dir):
+        self.path = join(work_dir, "state.json")
+        self.config_hash = None
+        # Input file: {"fingerprint", "status", "output"}
+        self.files = {}
+        # Input files whose outputs are in the merged result, with the
+        # fingerprint they had when merged
+        self.merged = {}
+        if exists(self.path):
+            with open(self.path) as f:
+                saved = json.load(f)
+            self.config_hash = saved["config_hash"]
+            self.files = saved["files"]
+            self.merged = saved["merged"]
+
+    def save(self):
+        # Write a new file and rename it, so a kill never leaves a
+        # truncated state
+        tmp_path = self.path + ".tmp"
+        with open(tmp_path, 'w') as f:
+            json.dump({
+                "config_hash": self.config_hash,
+                "files": self.files,
+                "merged": self.merged,
+            }, f, indent=1, sort_keys=True)
+        rename(tmp_path, self.path)
+
+    def reset(self, new_config_hash):
+        self.config_hash = new_config_hash
+        self.files = {}
+        self.merged = {}
+        self.save()
+
+
+def write_job_config(config, input_file, output_file, job_config):
+    with open(job_config, 'w') as f:
+        f.write("import imp\n")
+        f.write("import FWCore.ParameterSet.Config as cms\n")
+        f.write("process = imp.load_source('zfinder_jobs_base_cfg', {0!r}).process\n".format(config))
+        f.write("process.source.fileNames = cms.untracked.vstring({0!r})\n".format(input_file))
+        f.write("process.TFileService.fileName = {0!r}\n".format(output_file))
+
+
+class Job(object):
+    def __init__(self, input_file, fingerprint, config, work_dir):
+        self.input_file = input_file
+        self.fingerprint = fingerprint
+        name = sha1(input_file.encode()).hexdigest()[:16]
+        self.output = join(work_dir, "outputs", name + ".root")
+        self.job_config = join(work_dir, "configs", name + "_cfg.py")
+        self.log = join(work_dir, "logs", name + ".log")
+        input_name = input_file if ":" in input_file else "file:" + input_file
+        write_job_config(config, input_name, self.output, self.job_config)
+        # Remove the output of an earlier, failed or killed, attempt
+        if exists(self.output):
+            remove(self.output)
+        self.log_file = open(self.log, 'w')
+        # Run in the directory of the configuration, which may use relative
+        # paths
+        self.process = Popen(
+            ["cmsRun", self.job_config],
+            stdout=self.log_file, stderr=self.log_file, cwd=dirname(config)
+        )
+
+    def poll(self):
+        return self.process.poll()
+
+    def succeeded(self):
+        self.log_file.close()
+        return self.process.returncode == 0 and exists(self.output)
+
+
+def run_jobs(todo, config, work_dir, state, n_jobs):
+    """Run the jobs, at most n_jobs at once, saving the state after each."""
+    running = []
+    n_done = 0
+    n_failed = 0
+    while todo or running:
+        while todo and len(running) < n_jobs:
+            (input_file, fingerprint) = todo.pop(0)
+            running.append(Job(input_file, fingerprint, config, work_dir))
+        sleep(1)
+        for job in list(running):
+            if job.poll() is None:
+                continue
+            running.remove(job)
+            if job.succeeded():
+                status = "done"
+                n_done += 1
+            else:
+                status = "failed"
+                n_failed += 1
+                print("Failed: " + job.input_file + ", see " + job.log)
+            state.files[job.input_file] = {
+                "fingerprint": job.fingerprint,
+                "status": status,
+                "output": job.output,
+            }
+            state.save()
+    return (n_done, n_failed)
+
+
+def merge(merger, n_jobs, result, inputs):
+    """Merge inputs into a new result and replace the old one."""
+    tmp_result = result + ".tmp.root"
+    list_file = result + ".inputs.txt"
+    with open(list_file, 'w') as f:
+        for input_file in inputs:
+            f.write(input_file + "\n")
+    command = [merger, "-j", str(n_jobs), tmp_result, "@" + list_file]
+    if Popen(command).wait() != 0:
+        print("The merge failed: " + " ".join(command))
+        return False
+    rename(tmp_result, result)
+    remove(list_file)
+    return True
+
+
+if __name__ == '__main__':
+    usage = "usage: %prog -w work_dir [-j N] config_cfg.py filelist.txt [filelist.txt ...]"
+    parser = OptionParser(usage=usage)
+    parser.add_option("-w", "--work-dir", action="store", dest="work_dir", default=None, help="directory for the state, job outputs, and logs")
+    parser.add_option("-j", "--jobs", action="store", type="int", dest="jobs", default=1, help="number of cmsRun jobs (and merge processes) to run at once")
+    parser.add_option("-r", "--result", action="store", dest="result", default=None, help="the merged output file, WORK_DIR/merged.root by default")
+    parser.add_option("-m", "--merger", action="store", dest="merger", default=join(dirname(abspath(__file__)), "..", "merge_zfinder", "merge_zfinder.exe"), help="path to merge_zfinder.exe")
+    parser.add_option("-n", "--dry-run", action="store_true", dest="dry_run", default=False, help="only print which files would be processed")
+
+    (options, args) = parser.parse_args()
+    if options.work_dir is None or len(args) < 2:
+        parser.print_help()
+        exit(2)
+
+    config = abspath(args[0])
+    work_dir = abspath(options.work_dir)
+    result = abspath(options.result) if options.result else join(work_dir, "merged.root")
+    for sub_dir in ("outputs", "configs", "logs"):
+        if not isdir(join(work_dir, sub_dir)):
+            makedirs(join(work_dir, sub_dir))
+
+    # If the configuration changed nothing done so far can be used
+    state = State(work_dir)
+    current_hash = config_hash(config)
+    if state.config_hash != current_hash:
+        if state.config_hash is not None:
+            print("The configuration changed, every file will be processed again.")
+        if not options.dry_run:
+            state.reset(current_hash)
+        else:
+            state.files = {}
+            state.merged = {}
+
+    # Find the new, changed, and failed files
+    input_files = read_file_lists(args[1:])
+    fingerprints = {}
+    todo = []
+    for input_file in input_files:
+        fingerprint = file_fingerprint(input_file)
+        fingerprints[input_file] = fingerprint
+        saved = state.files.get(input_file)
+        if saved is None or saved["status"] != "done" or saved["fingerprint"] != fingerprint or not exists(saved["output"]):
+            todo.append((input_file, fingerprint))
+    print("{0} files, {1} to process".format(len(input_files), len(todo)))
+    if options.dry_run:
+        for (input_file, fingerprint) in todo:
+            print(input_file)
+        exit(0)
+
+    (n_done, n_failed) = run_jobs(todo, config, work_dir, state, options.jobs)
+    print("{0} jobs succeeded, {1} failed".format(n_done, n_failed))
+
+    # Only the outputs of the current file lists are merged
+    done = [f for f in input_files if state.files.get(f, {}).get("status") == "done"]
+    stale = [f for f in state.merged if f not in fingerprints or state.merged[f] != state.files.get(f, {}).get("fingerprint")]
+    new = [f for f in done if f not in state.merged]
+    if not exists(result) or stale:
+        print("Merging all {0} outputs".format(len(done)))
+        if done and merge(options.merger, options.jobs, result, [state.files[f]["output"] for f in done]):
+            state.merged = dict((f, state.files[f]["fingerprint"]) for f in done)
+            state.save()
+    elif new:
+        print("Merging {0} new outputs into {1}".format(len(new), basename(result)))
+        if merge(options.merger, options.jobs, result, [result] + [state.files[f]["output"] for f in new]):
+            for f in new:
+                state.merged[f] = state.files[f]["fingerprint"]
+            state.save()
+    else:
+        print("The merged result is up to date")
+
+    exit(1 if n_failed else 0)
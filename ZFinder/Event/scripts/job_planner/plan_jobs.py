@@ -0,0 +1,287 @@
+#!/usr/bin/env python
+
+"""Split the files in one or more file lists (for example
+Metadata/filelists/*.txt) into jobs with about the same number of events,
+instead of the same number of files.
+
+The number of events in each file is read with PyROOT (or edmFileUtil if
+PyROOT is not available) and cached in a JSON file, keyed by path, size, and
+modification time, so only new or changed files are opened on later runs.
+
+Files are packed whole into jobs, largest first onto the job with the fewest
+events, and a file with more events than the target is split into event
+ranges with process.source.skipEvents and process.maxEvents. The target is
+set with --events-per-job, or with --wall-time and --seconds-per-event.
+
+Two outputs are supported:
+
+    local: OUT_DIR/configs/job_NNNN_cfg.py for every job, OUT_DIR/jobs.txt
+           with one cmsRun command per line (for xargs -P or a batch system),
+           and OUT_DIR/manifest.json listing the files and ranges of each job.
+
+    crab:  a copy of a crab configuration in OUT_DIR with event based
+           splitting (events_per_job) set to the target, as crab assigns the
+           files itself. Configurations with a lumi_mask get the number of
+           jobs the target needs instead, as they must split by lumi.
+
+Usage:
+
+    plan_jobs.py -o OUT_DIR -e EVENTS [-f local|crab] config filelist.txt [...]
+
+where config is the cmsRun configuration for local jobs, or the crab
+configuration to copy for crab.
+"""
+
+from optparse import OptionParser
+from os import makedirs, rename
+from os.path import abspath, basename, dirname, exists, getmtime, getsize, isdir, join
+from subprocess import Popen, PIPE
+from sys import exit
+import json
+import re
+
+
+def read_file_lists(file_lists):
+    files = []
+    seen = set()
+    for file_list in file_lists:
+        with open(file_list) as f:
+            for line in f:
+                line = line.strip()
+                if line and not line.startswith('#') and line not in seen:
+                    seen.add(line)
+                    files.append(line)
+    return files
+
+
+def count_events_pyroot(path):
+    import ROOT
+    tfile = ROOT.TFile.Open(path)
+    if not tfile or tfile.IsZombie():
+        raise IOError("Can not open " + path)
+    tree = tfile.Get("Events")
+    if not tree:
+        raise IOError("No Events tree in " + path)
+    n_events = int(tree.GetEntries())
+    tfile.Close()
+    return n_events
+
+
+def count_events_edmfileutil(path):
+    # edmFileUtil prints "path (R runs, L lumis, E events, B bytes)"
+    name = path if ":" in path else "file:" + path
+    util = Popen(["edmFileUtil", name], stdout=PIPE, stderr=PIPE)
+    (out, err) = util.communicate()
+    match = re.search(r"(\d+) events", out.decode())
+    if util.returncode != 0 or match is None:
+        raise IOError("edmFileUtil failed for " + path)
+    return int(match.group(1))
+
+
+class EventCounts(object):
+    """Event counts of files, cached in a JSON file."""
+
+    def __init__(self, cache_path):
+        self.cache_path = cache_path
+        self.cache = {}
+        self.changed = False
+        if cache_path and exists(cache_path):
+            with open(cache_path) as f:
+                self.cache = json.load(f)
+        try:
+            import ROOT
+            ROOT.gROOT.SetBatch(True)
+            self.counter = count_events_pyroot
+        except ImportError:
+            self.counter = count_events_edmfileutil
+
+    def get(self, path):
+        # Remote files (with a protocol) can not be checked for changes, so
+        # their counts are trusted
+        if exists(path):
+            key = [getsize(path), getmtime(path)]
+        else:
+            key = None
+        saved = self.cache.get(path)
+        if saved is not None and saved["key"] == key:
+            return saved["events"]
+        n_events = self.counter(path)
+        self.cache[path] = {"key": key, "events": n_events}
+        self.changed = True
+        return n_events
+
+    def save(self):
+        if not self.cache_path or not self.changed:
+            return
+        tmp_path = self.cache_path + ".tmp"
+        with open(tmp_path, 'w') as f:
+            json.dump(self.cache, f, indent=1, sort_keys=True)
+        rename(tmp_path, self.cache_path)
+
+
+def plan(counts, events_per_job):
+    """Return a list of jobs, each a list of (file, first event, number of
+    events) with number of events -1 meaning the whole file.
+    """
+    # Split files larger than the target into ranges of nearly equal size,
+    # which become jobs of their own
+    jobs = []
+    pieces = []
+    for (path, n_events) in counts:
+        if n_events > events_per_job:
+            n_ranges = -(-n_events // events_per_job)
+            for i in range(n_ranges):
+                first = i * n_events // n_ranges
+                last = (i + 1) * n_events // n_ranges
+                jobs.append([(path, first, last - first)])
+        elif n_events > 0:
+            pieces.append((n_events, path))
+
+    # Pack the rest of the files longest processing time first, always onto
+    # the job with the fewest events. The number of jobs is the minimum
+    # needed to meet the target on average.
+    total = sum(n for (n, path) in pieces)
+    n_packed = max(1, -(-total // events_per_job)) if pieces else 0
+    packed = [[0, []] for i in range(n_packed)]
+    for (n_events, path) in sorted(pieces, reverse=True):
+        smallest = min(packed, key=lambda job: job[0])
+        smallest[0] += n_events
+        smallest[1].append((path, 0, -1))
+    jobs.extend(sorted(job[1]) for job in packed if job[1])
+    return jobs
+
+
+def job_events(job, events):
+    return sum(events[path] if n == -1 else n for (path, first, n) in job)
+
+
+def write_local(jobs, events, config, out_dir):
+    config_dir = join(out_dir, "configs")
+    output_dir = join(out_dir, "outputs")
+    for directory in (config_dir, output_dir):
+        if not isdir(directory):
+            makedirs(directory)
+
+    commands = []
+    manifest = []
+    for (i_job, job) in enumerate(jobs):
+        name = "job_{0:04d}".format(i_job)
+        job_config = join(config_dir, name + "_cfg.py")
+        output = join(output_dir, name + ".root")
+        file_names = [p if ":" in p else "file:" + p for (p, first, n) in job]
+        with open(job_config, 'w') as f:
+            f.write("import imp\n")
+            f.write("import FWCore.ParameterSet.Config as cms\n")
+            f.write("process = imp.load_source('plan_jobs_base_cfg', {0!r}).process\n".format(config))
+            f.write("process.source.fileNames = cms.untracked.vstring({0})\n".format(", ".join(repr(n) for n in file_names)))
+            f.write("process.TFileService.fileName = {0!r}\n".format(output))
+            # Only single file jobs are ever split into ranges
+            (path, first, n) = job[0]
+            if n != -1:
+                f.write("process.source.skipEvents = cms.untracked.uint32({0})\n".format(first))
+                f.write("process.maxEvents.input = cms.untracked.int32({0})\n".format(n))
+            else:
+                f.write("process.maxEvents.input = cms.untracked.int32(-1)\n")
+        # Run in the directory of the configuration, which may use relative
+        # paths
+        commands.append("cd {0} && cmsRun {1} > {2} 2>&1".format(dirname(config), job_config, join(output_dir, name + ".log")))
+        manifest.append({
+            "name": name,
+            "config": job_config,
+            "output": output,
+            "events": job_events(job, events),
+            "files": [{"path": p, "first_event": first, "events": n} for (p, first, n) in job],
+        })
+
+    with open(join(out_dir, "jobs.txt"), 'w') as f:
+        for command in commands:
+            f.write(command + "\n")
+    with open(join(out_dir, "manifest.json"), 'w') as f:
+        json.dump(manifest, f, indent=1)
+
+
+def write_crab(total_events, events_per_job, crab_config, out_dir):
+    # crab does not take a file assignment, so ask it to split by events
+    # instead of by files. With a lumi_mask crab can only split by lumi
+    # sections, so set the number of jobs from the event count instead.
+    with open(crab_config) as f:
+        lines = f.readlines()
+    n_jobs = -(-total_events // events_per_job)
+    if any(line.split('=')[0].strip() == "lumi_mask" for line in lines):
+        settings = {
+            "total_number_of_lumis": "-1",
+            "number_of_jobs": str(n_jobs),
+        }
+    else:
+        settings = {
+            "total_number_of_events": "-1",
+            "events_per_job": str(events_per_job),
+        }
+    removed = ("total_number_of_events", "events_per_job", "total_number_of_lumis", "lumis_per_job", "number_of_jobs", "files_per_job")
+    output = []
+    section = None
+    for line in lines:
+        stripped = line.strip()
+        if stripped.startswith('['):
+            section = stripped.strip("[]")
+            output.append(line)
+            if section == "CMSSW":
+                output.extend(setting_lines(settings))
+            continue
+        if section == "CMSSW" and '=' in stripped and not stripped.startswith('#'):
+            key = stripped.split('=')[0].strip()
+            if key in removed or key in settings:
+                continue
+        output.append(line)
+    with open(join(out_dir, basename(crab_config)), 'w') as f:
+        f.writelines(output)
+    print("crab will make about {0} jobs".format(n_jobs))
+
+
+def setting_lines(settings):
+    return ["{0:<23}=  {1}\n".format(key, settings[key]) for key in sorted(settings)]
+
+
+if __name__ == '__main__':
+    usage = "usage: %prog -o out_dir (-e events | -t seconds -s seconds_per_event) [-f local|crab] config filelist.txt [...]"
+    parser = OptionParser(usage=usage)
+    parser.add_option("-o", "--out-dir", action="store", dest="out_dir", default=None, help="directory to write the jobs to")
+    parser.add_option("-e", "--events-per-job", action="store", type="int", dest="events_per_job", default=None, help="target number of events per job")
+    parser.add_option("-t", "--wall-time", action="store", type="float", dest="wall_time", default=None, help="target wall time per job in seconds, used with --seconds-per-event")
+    parser.add_option("-s", "--seconds-per-event", action="store", type="float", dest="seconds_per_event", default=None, help="measured processing time per event")
+    parser.add_option("-f", "--format", action="store", dest="format", default="local", choices=["local", "crab"], help="local (cmsRun configurations) or crab")
+    parser.add_option("-c", "--cache", action="store", dest="cache", default=None, help="event count cache, OUT_DIR/event_counts.json by default")
+
+    (options, args) = parser.parse_args()
+    events_per_job = options.events_per_job
+    if events_per_job is None and options.wall_time and options.seconds_per_event:
+        events_per_job = int(options.wall_time / options.seconds_per_event)
+    if options.out_dir is None or len(args) < 2 or not events_per_job or events_per_job < 1:
+        parser.print_help()
+        exit(2)
+
+    out_dir = abspath(options.out_dir)
+    if not isdir(out_dir):
+        makedirs(out_dir)
+    config = abspath(args[0])
+
+    event_counts = EventCounts(options.cache if options.cache else join(out_dir, "event_counts.json"))
+    counts = []
+    try:
+        for path in read_file_lists(args[1:]):
+            counts.append((path, event_counts.get(path)))
+    finally:
+        # Keep the counts read so far even if a file fails
+        event_counts.save()
+    events = dict(counts)
+    total_events = sum(events.values())
+
+    if options.format == "crab":
+        write_crab(total_events, events_per_job, config, out_dir)
+        exit(0)
+
+    jobs = plan(counts, events_per_job)
+    write_local(jobs, events, config, out_dir)
+    if jobs:
+        sizes = [job_events(job, events) for job in jobs]
+        print("{0} files, {1} events, {2} jobs of {3} to {4} events".format(len(counts), total_events, len(jobs), min(sizes), max(sizes)))
@@ -0,0 +1,167 @@
+// Standard Library
+#include <iostream>
+#include <stdexcept>  // std::runtime_error
+#include <string>
+#include <vector>
+
+// ROOT
+#include <TChain.h>
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TKey.h>
+#include <TList.h>  // TIter
+#include <TTree.h>
+
+// RooFit
+#include <RooAbsData.h>  // RooAbsData::setDefaultStorageType
+#include <RooArgSet.h>
+#include <RooCategory.h>
+#include <RooDataSet.h>
+#include <RooRealVar.h>
+#include <RooWorkspace.h>
+
+// ZFinder
+#include "../zdef_tree/zdef_tree_reader.h"  // ExpandFileLists
+
+/*
+ * Make the RooWorkspaces of ZDefinitionWorkspace from the "workspace_store"
+ * trees of ZFinder outputs, as described in docs/ZDefinitionWorkspace.md.
+ *
+ * Usage:
+ *
+ *     make_workspace.exe output.root input.root [input.root ...]
+ *
+ * An input starting with "@" is a text file with one input file per line.
+ *
+ * Every ZFinder/<ZDefinition> directory of the first input with a store gets
+ * a RooWorkspace named "workspace" in the same directory of the output,
+ * holding a RooDataSet named after the ZDefinition and weighted by "weight".
+ * The stores of all inputs are read as one TChain, so the inputs can be the
+ * outputs of many jobs or a merged file.
+ */
+
+namespace {
+    // Values of the categories, as in ZDefinitionWorkspace
+    enum DataType {
+        DATA = 0,
+        RECO_MC = 1,
+        TRUTH_MC = 2
+    };
+
+    enum Degenerate {
+        NOT_DEGENERATE = 0,
+        DEGENERATE_DENOMINATOR = 1,
+        DEGENERATE_NUMERATOR = 2
+    };
+
+    const std::string STORE_NAME = "workspace_store";
+
+    // The ZDefinition directories of the file with a store
+    std::vector<std::string> FindStores(const std::string& FILE_NAME) {
+        TFile file(FILE_NAME.c_str(), "READ");
+        TDirectory* top = file.GetDirectory("ZFinder");
+        if (!top) {
+            throw std::runtime_error("Missing directory ZFinder in " + FILE_NAME);
+        }
+        std::vector<std::string> names;
+        TIter next(top->GetListOfKeys());
+        while (TKey* key = static_cast<TKey*>(next())) {
+            TDirectory* dir = top->GetDirectory(key->GetName());
+            if (dir && dir->GetKey(STORE_NAME.c_str())) {
+                names.push_back(key->GetName());
+            }
+        }
+        file.Close();
+        return names;
+    }
+
+    void MakeWorkspace(const std::string& ZDEF_NAME, TChain* store, TDirectory* out_dir) {
+        // Ranges include the -1 and -10 used for missing values
+        RooRealVar z_mass("z_mass", "m_{ee}", -1., 14000., "GeV");
+        RooRealVar z_eta("z_eta", "#eta_{ee}", -1000., 1000.);
+        RooRealVar z_y("z_y", "Y_{ee}", -1000., 1000.);
+        RooRealVar z_pt("z_pt", "p_{T,ee}", -1., 14000., "GeV");
+        RooRealVar phistar("phistar", "#phi*", -1., 1000.);
+        RooRealVar e0_pt("e0_pt", "p_{T,e_{0}}", -1., 14000., "GeV");
+        RooRealVar e1_pt("e1_pt", "p_{T,e_{1}}", -1., 14000., "GeV");
+        RooRealVar e0_eta("e0_eta", "#eta_{e_{0}}", -1000., 1000.);
+        RooRealVar e1_eta("e1_eta", "#eta_{e_{1}}", -1000., 1000.);
+        RooRealVar e0_charge("e0_charge", "q_{e_{0}}", -2., 2.);
+        RooRealVar e1_charge("e1_charge", "q_{e_{1}}", -2., 2.);
+        RooRealVar n_vert("n_vert", "Number of Vertexes", -1., 1000.);
+        RooRealVar event_num("event_num", "Event Number", 0., 4294967296.);
+        RooRealVar weight("weight", "Weight", -1e9, 1e9);
+
+        RooCategory data_type("data_type", "Data Type");
+        data_type.defineType("Data", DATA);
+        data_type.defineType("Reco MC", RECO_MC);
+        data_type.defineType("Truth MC", TRUTH_MC);
+        RooCategory numerator("numerator", "Numerator");
+        numerator.defineType("False", 0);
+        numerator.defineType("True", 1);
+        RooCategory degenerate("degenerate", "Degenerate");
+        degenerate.defineType("False", NOT_DEGENERATE);
+        degenerate.defineType("Degenerate Denominator", DEGENERATE_DENOMINATOR);
+        degenerate.defineType("Degenerate Denominator and Numerator", DEGENERATE_NUMERATOR);
+        RooCategory pass_all("pass_all", "Pass All");
+        pass_all.defineType("False", 0);
+        pass_all.defineType("True", 1);
+
+        RooArgSet variables(z_mass, z_eta, z_y, z_pt, phistar, e0_pt, e1_pt, e0_eta);
+        variables.add(RooArgSet(e1_eta, e0_charge, e1_charge, n_vert, event_num, weight));
+        variables.add(RooArgSet(data_type, numerator, degenerate, pass_all));
+
+        // A tree store, made in the output directory, so the events are
+        // never all in memory as RooArgSets
+        out_dir->cd();
+        RooAbsData::setDefaultStorageType(RooAbsData::Tree);
+        RooDataSet* dataset = new RooDataSet(ZDEF_NAME.c_str(), ZDEF_NAME.c_str(), store, variables, "", "weight");
+        RooWorkspace* workspace = new RooWorkspace("workspace", "workspace");
+        workspace->import(*dataset);
+        out_dir->cd();
+        workspace->Write();
+        std::cout << ZDEF_NAME << ": " << dataset->numEntries() << " events" << std::endl;
+        // RooDataSet skips the rows with a value outside the ranges above
+        const Long64_t DROPPED = store->GetEntries() - dataset->numEntries();
+        if (DROPPED > 0) {
+            std::cout << ZDEF_NAME << ": " << DROPPED << " events dropped, outside the variable ranges" << std::endl;
+        }
+
+        delete workspace;
+        delete dataset;
+    }
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cout << "Not enough arguments." << std::endl;
+        std::cout << "Usage: make_workspace.exe output.root input.root [input.root ...]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::string OUTPUT_FILE = argv[1];
+    const std::vector<std::string> INPUTS = ExpandFileLists(std::vector<std::string>(argv + 2, argv + argc));
+    if (INPUTS.empty()) {
+        std::cout << "No input files." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::vector<std::string> ZDEFS = FindStores(INPUTS[0]);
+    if (ZDEFS.empty()) {
+        std::cout << "No " << STORE_NAME << " trees in " << INPUTS[0] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    TFile output(OUTPUT_FILE.c_str(), "RECREATE");
+    TDirectory* top = output.mkdir("ZFinder");
+    for (auto& i_zdef : ZDEFS) {
+        const std::string TREE_NAME = "ZFinder/" + i_zdef + "/" + STORE_NAME;
+        TChain store(TREE_NAME.c_str());
+        for (auto& i_file : INPUTS) {
+            store.Add(i_file.c_str());
+        }
+        MakeWorkspace(i_zdef, &store, top->mkdir(i_zdef.c_str()));
+    }
+    output.Close();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,492 @@
+// Standard Library
+#include <algorithm>
+#include <cstdio>  // std::remove
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <stdexcept>  // std::runtime_error
+#include <string>
+#include <vector>
+
+// POSIX
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// ROOT
+#include <TClass.h>
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TH1.h>
+#include <TKey.h>
+#include <TLeaf.h>
+#include <TList.h>
+#include <TTree.h>
+
+// ZFinder
+#include "../zdef_tree/event_index.h"  // EventIndex
+#include "../zdef_tree/zdef_tree_reader.h"  // ExpandFileLists
+
+/*
+ * Merge ZFinder output files, for example the outputs of a crab task, as a
+ * replacement for hadd.
+ *
+ * Usage:
+ *
+ *     merge_zfinder.exe [-j N] output.root input.root [input.root ...]
+ *
+ * An input starting with "@" is a text file with one input file per line.
+ *
+ * Trees are concatenated with TTree::CopyEntries(..., "fast"), which copies
+ * the compressed baskets without unpacking them, straight into the output;
+ * all inputs must have the same branches. With N > 1 the other objects are
+ * merged at the same time by N processes, split by ZDefinition directory
+ * (ZFinder/<name>, with its cut level subdirectories), each writing a part
+ * file that is then copied into the output. Histograms (including
+ * unweighted_counter and weighted_counter) are added. The "zdefs" tree of
+ * the event table is the same in every job and is taken from the first
+ * input. The "event_index" trees are rebuilt for the merged trees instead of
+ * being concatenated. RooWorkspaces are skipped (scripts/make_workspace makes
+ * them from the merged workspace_store trees). Other objects are taken from
+ * the first input.
+ */
+
+namespace {
+    // A directory to merge. If RECURSIVE is false only the objects directly
+    // in it are merged, not its subdirectories.
+    struct work_unit {
+        std::string path;
+        bool recursive;
+        Long64_t bytes;
+    };
+
+    // Which objects of the directories to merge. The trees are merged into
+    // the output by the main process and the rest by the jobs, so the tree
+    // baskets are only written once.
+    enum MergeObjects {
+        ALL_OBJECTS,
+        TREES_ONLY,
+        NO_TREES
+    };
+
+    std::string JoinPath(const std::string& DIR, const std::string& NAME) {
+        return DIR.empty() ? NAME : DIR + "/" + NAME;
+    }
+
+    TDirectory* GetDirectory(TFile* file, const std::string& PATH) {
+        if (PATH.empty()) {
+            return file;
+        }
+        TDirectory* dir = file->GetDirectory(PATH.c_str());
+        if (!dir) {
+            throw std::runtime_error("Missing directory " + PATH + " in " + file->GetName());
+        }
+        return dir;
+    }
+
+    // mkdir -p
+    TDirectory* MakeDirectory(TDirectory* base, const std::string& PATH) {
+        TDirectory* dir = base;
+        std::istringstream iss(PATH);
+        std::string name;
+        while (std::getline(iss, name, '/')) {
+            if (name.empty()) {
+                continue;
+            }
+            TDirectory* sub = dir->GetDirectory(name.c_str());
+            if (!sub) {
+                sub = dir->mkdir(name.c_str());
+            }
+            dir = sub;
+        }
+        return dir;
+    }
+
+    // The keys of a directory, one per name (the highest cycle)
+    std::vector<TKey*> UniqueKeys(TDirectory* dir) {
+        std::vector<TKey*> keys;
+        std::set<std::string> seen;
+        TIter next(dir->GetListOfKeys());
+        while (TKey* key = static_cast<TKey*>(next())) {
+            if (seen.insert(key->GetName()).second) {
+                keys.push_back(key);
+            }
+        }
+        return keys;
+    }
+
+    bool InheritsFrom(TKey* key, TClass* base) {
+        TClass* key_class = TClass::GetClass(key->GetClassName());
+        return key_class != nullptr && key_class->InheritsFrom(base);
+    }
+
+    Long64_t DirectoryBytes(TDirectory* dir, const bool RECURSIVE) {
+        Long64_t bytes = 0;
+        for (auto& i_key : UniqueKeys(dir)) {
+            if (InheritsFrom(i_key, TDirectory::Class())) {
+                if (RECURSIVE) {
+                    bytes += DirectoryBytes(dir->GetDirectory(i_key->GetName()), true);
+                }
+            }
+            else {
+                // A tree's key only holds its header, and the jobs do not
+                // copy the baskets, so this is the work of the jobs
+                bytes += i_key->GetNbytes();
+            }
+        }
+        return bytes;
+    }
+
+    std::string LeafSignature(TTree* tree) {
+        std::ostringstream oss;
+        TIter next(tree->GetListOfLeaves());
+        while (TLeaf* leaf = static_cast<TLeaf*>(next())) {
+            oss << leaf->GetBranch()->GetName() << "." << leaf->GetName() << "/" << leaf->GetTypeName() << ";";
+        }
+        return oss.str();
+    }
+
+    template<class T>
+    T* GetObject(TFile* file, const std::string& PATH) {
+        T* object = nullptr;
+        file->GetObject(PATH.c_str(), object);
+        if (!object) {
+            throw std::runtime_error("Missing " + PATH + " in " + file->GetName());
+        }
+        return object;
+    }
+
+    void MergeHistogram(const std::vector<TFile*>& INPUTS, const std::string& PATH, const std::string& NAME, TDirectory* out_dir) {
+        const std::string FULL_NAME = JoinPath(PATH, NAME);
+        TH1* sum = GetObject<TH1>(INPUTS[0], FULL_NAME);
+        sum->SetDirectory(0);
+        for (size_t i = 1; i < INPUTS.size(); ++i) {
+            TH1* histo = GetObject<TH1>(INPUTS[i], FULL_NAME);
+            sum->Add(histo);
+            delete histo;
+        }
+        out_dir->cd();
+        sum->Write(NAME.c_str());
+        delete sum;
+    }
+
+    void MergeTree(const std::vector<TFile*>& INPUTS, const std::string& PATH, const std::string& NAME, TDirectory* out_dir) {
+        const std::string FULL_NAME = JoinPath(PATH, NAME);
+        TTree* first = GetObject<TTree>(INPUTS[0], FULL_NAME);
+        const std::string SIGNATURE = LeafSignature(first);
+
+        out_dir->cd();
+        TTree* merged = first->CloneTree(0);
+        for (size_t i = 0; i < INPUTS.size(); ++i) {
+            TTree* tree = (i == 0) ? first : GetObject<TTree>(INPUTS[i], FULL_NAME);
+            if (LeafSignature(tree) != SIGNATURE) {
+                throw std::runtime_error("The branches of " + FULL_NAME + " in " + INPUTS[i]->GetName() + " do not match the first file");
+            }
+            merged->CopyEntries(tree, -1, "fast");
+            if (tree != first) {
+                delete tree;
+            }
+        }
+        out_dir->cd();
+        merged->Write();
+        delete merged;
+        delete first;
+    }
+
+    void CopyFirst(const std::vector<TFile*>& INPUTS, const std::string& PATH, const std::string& NAME, TDirectory* out_dir) {
+        TKey* key = GetDirectory(INPUTS[0], PATH)->GetKey(NAME.c_str());
+        TObject* object = key->ReadObj();
+        out_dir->cd();
+        if (TTree* tree = dynamic_cast<TTree*>(object)) {
+            TTree* copy = tree->CloneTree(-1, "fast");
+            copy->Write();
+            delete copy;
+        }
+        else {
+            object->Write(NAME.c_str());
+        }
+        delete object;
+    }
+
+    void RebuildIndex(const std::vector<TFile*>& INPUTS, const std::string& PATH, const std::string& TREE_NAME, TDirectory* out_dir) {
+        /*
+         * Same layout as ZDefinitionTree::WriteIndex, with the entries
+         * shifted by the number of entries of the files before each input.
+         */
+        std::vector<EventIndex::record> records;
+        Long64_t offset = 0;
+        for (auto& i_file : INPUTS) {
+            TTree* tree = GetObject<TTree>(i_file, JoinPath(PATH, TREE_NAME));
+            const EventIndex INDEX(tree);
+            if (!INDEX.HasLumi()) {
+                std::cout << "Not every input has an event_index for " << PATH << ", it is not written." << std::endl;
+                delete tree;
+                return;
+            }
+            for (auto& i_record : INDEX) {
+                EventIndex::record shifted = i_record;
+                shifted.entry += offset;
+                records.push_back(shifted);
+            }
+            offset += tree->GetEntries();
+            delete tree;
+        }
+        std::sort(records.begin(), records.end(),
+            [](const EventIndex::record& A, const EventIndex::record& B) {
+                if (A.run != B.run) { return A.run < B.run; }
+                if (A.lumi != B.lumi) { return A.lumi < B.lumi; }
+                if (A.event != B.event) { return A.event < B.event; }
+                return A.entry < B.entry;
+            }
+        );
+
+        out_dir->cd();
+        TTree* index_tree = new TTree("event_index", "event_index");
+        EventIndex::record record;
+        Long64_t index_size = records.size();
+        index_tree->Branch("run_number", &record.run, "run_number/i");
+        index_tree->Branch("lumi_number", &record.lumi, "lumi_number/i");
+        index_tree->Branch("event_number", &record.event, "event_number/i");
+        index_tree->Branch("entry", &record.entry, "entry/L");
+        index_tree->Branch("index_size", &index_size, "index_size/L");
+        for (auto& i_record : records) {
+            record = i_record;
+            index_tree->Fill();
+        }
+        // The branches point at the locals above
+        index_tree->ResetBranchAddresses();
+        index_tree->Write();
+        delete index_tree;
+    }
+
+    void MergeDirectory(const std::vector<TFile*>& INPUTS, const std::string& PATH, TDirectory* out_dir, const bool RECURSIVE, const MergeObjects OBJECTS) {
+        bool has_index = false;
+        for (auto& i_key : UniqueKeys(GetDirectory(INPUTS[0], PATH))) {
+            const std::string NAME = i_key->GetName();
+            // The event_index and zdefs trees are small and belong with the
+            // other objects
+            const bool IS_TREE = InheritsFrom(i_key, TTree::Class()) && NAME != "event_index" && NAME != "zdefs";
+            if (InheritsFrom(i_key, TDirectory::Class())) {
+                if (RECURSIVE) {
+                    MergeDirectory(INPUTS, JoinPath(PATH, NAME), MakeDirectory(out_dir, NAME), true, OBJECTS);
+                }
+            }
+            else if ((OBJECTS == TREES_ONLY && !IS_TREE) || (OBJECTS == NO_TREES && IS_TREE)) {
+                continue;
+            }
+            else if (InheritsFrom(i_key, TH1::Class())) {
+                MergeHistogram(INPUTS, PATH, NAME, out_dir);
+            }
+            else if (NAME == "event_index") {
+                has_index = true;
+            }
+            else if (NAME == "zdefs") {
+                CopyFirst(INPUTS, PATH, NAME, out_dir);
+            }
+            else if (IS_TREE) {
+                MergeTree(INPUTS, PATH, NAME, out_dir);
+            }
+            else if (std::string(i_key->GetClassName()) == "RooWorkspace") {
+                // Older outputs have a RooWorkspace, which can not be added;
+                // make_workspace makes it from the merged workspace_store
+                std::cout << "Skipping " << JoinPath(PATH, NAME) << "; make it from the merged output with make_workspace." << std::endl;
+            }
+            else {
+                CopyFirst(INPUTS, PATH, NAME, out_dir);
+            }
+        }
+
+        // The index belongs to the tree named after its ZDefinition directory
+        if (has_index) {
+            const std::string TREE_NAME = PATH.substr(PATH.rfind('/') + 1);
+            TTree* tree = nullptr;
+            GetDirectory(INPUTS[0], PATH)->GetObject(TREE_NAME.c_str(), tree);
+            if (tree) {
+                delete tree;
+                RebuildIndex(INPUTS, PATH, TREE_NAME, out_dir);
+            }
+        }
+    }
+
+    void CopyDirectory(TDirectory* in_dir, TDirectory* out_dir) {
+        /*
+         * Copy a part file into the output. The parts hold disjoint
+         * directories, and no large trees, so nothing is added here.
+         */
+        for (auto& i_key : UniqueKeys(in_dir)) {
+            const std::string NAME = i_key->GetName();
+            if (InheritsFrom(i_key, TDirectory::Class())) {
+                CopyDirectory(in_dir->GetDirectory(NAME.c_str()), MakeDirectory(out_dir, NAME));
+                continue;
+            }
+            TObject* object = i_key->ReadObj();
+            out_dir->cd();
+            if (TTree* tree = dynamic_cast<TTree*>(object)) {
+                TTree* copy = tree->CloneTree(-1, "fast");
+                copy->Write();
+                delete copy;
+            }
+            else {
+                object->Write(NAME.c_str());
+            }
+            delete object;
+        }
+    }
+
+    std::vector<TFile*> OpenInputs(const std::vector<std::string>& INPUT_FILES) {
+        std::vector<TFile*> inputs;
+        for (auto& i_name : INPUT_FILES) {
+            TFile* file = TFile::Open(i_name.c_str(), "READ");
+            if (!file || file->IsZombie()) {
+                throw std::runtime_error("Failed to open " + i_name);
+            }
+            inputs.push_back(file);
+        }
+        return inputs;
+    }
+
+    void MergeUnits(const std::vector<std::string>& INPUT_FILES, const std::vector<work_unit>& UNITS, const std::string& OUTPUT_FILE, const MergeObjects OBJECTS) {
+        std::vector<TFile*> inputs = OpenInputs(INPUT_FILES);
+        TFile output(OUTPUT_FILE.c_str(), "RECREATE");
+        for (auto& i_unit : UNITS) {
+            MergeDirectory(inputs, i_unit.path, MakeDirectory(&output, i_unit.path), i_unit.recursive, OBJECTS);
+        }
+        output.Close();
+        for (auto& i_file : inputs) {
+            i_file->Close();
+            delete i_file;
+        }
+    }
+
+    std::vector<work_unit> FindUnits(const std::string& FIRST_FILE) {
+        /*
+         * Each top level directory (normally just "ZFinder") is split into
+         * the objects directly in it and one unit per subdirectory.
+         */
+        TFile file(FIRST_FILE.c_str(), "READ");
+        std::vector<work_unit> units;
+        work_unit top = {"", false, DirectoryBytes(&file, false)};
+        units.push_back(top);
+        for (auto& i_key : UniqueKeys(&file)) {
+            if (!InheritsFrom(i_key, TDirectory::Class())) {
+                continue;
+            }
+            const std::string TOP_PATH = i_key->GetName();
+            TDirectory* top_dir = file.GetDirectory(TOP_PATH.c_str());
+            work_unit objects = {TOP_PATH, false, DirectoryBytes(top_dir, false)};
+            units.push_back(objects);
+            for (auto& j_key : UniqueKeys(top_dir)) {
+                if (InheritsFrom(j_key, TDirectory::Class())) {
+                    const std::string PATH = JoinPath(TOP_PATH, j_key->GetName());
+                    work_unit sub = {PATH, true, DirectoryBytes(file.GetDirectory(PATH.c_str()), true)};
+                    units.push_back(sub);
+                }
+            }
+        }
+        file.Close();
+        return units;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int n_jobs = 1;
+    int first_arg = 1;
+    if (argc > 2 && std::string(argv[1]) == "-j") {
+        n_jobs = std::max(1, atoi(argv[2]));
+        first_arg = 3;
+    }
+    if (argc - first_arg < 2) {
+        std::cout << "Not enough arguments.";
+        std::cout << " Usage: merge_zfinder.exe [-j N] output.root input.root [input.root ...]";
+        std::cout << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::string OUTPUT_FILE(argv[first_arg]);
+    const std::vector<std::string> INPUT_FILES = ExpandFileLists(std::vector<std::string>(argv + first_arg + 1, argv + argc));
+    if (INPUT_FILES.empty()) {
+        std::cout << "No input files." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Split the directories between the jobs, largest first, each to the
+    // job with the least work so far
+    std::vector<work_unit> units = FindUnits(INPUT_FILES[0]);
+    n_jobs = std::min(n_jobs, static_cast<int>(units.size()));
+    if (n_jobs <= 1) {
+        MergeUnits(INPUT_FILES, units, OUTPUT_FILE, ALL_OBJECTS);
+        return EXIT_SUCCESS;
+    }
+    std::stable_sort(units.begin(), units.end(),
+        [](const work_unit& A, const work_unit& B) { return A.bytes > B.bytes; }
+    );
+    std::vector<std::vector<work_unit>> job_units(n_jobs);
+    std::vector<Long64_t> job_bytes(n_jobs, 0);
+    for (auto& i_unit : units) {
+        const size_t I_JOB = std::min_element(job_bytes.begin(), job_bytes.end()) - job_bytes.begin();
+        job_units[I_JOB].push_back(i_unit);
+        job_bytes[I_JOB] += i_unit.bytes;
+    }
+
+    // Each job writes its own part file, without the trees
+    std::vector<std::string> part_files;
+    std::vector<pid_t> pids;
+    for (int i_job = 0; i_job < n_jobs; ++i_job) {
+        std::ostringstream part_name;
+        part_name << OUTPUT_FILE << ".part" << i_job;
+        part_files.push_back(part_name.str());
+        const pid_t PID = fork();
+        if (PID < 0) {
+            throw std::runtime_error("fork failed");
+        }
+        if (PID == 0) {
+            int status = EXIT_SUCCESS;
+            try {
+                MergeUnits(INPUT_FILES, job_units[i_job], part_files.back(), NO_TREES);
+            }
+            catch (std::runtime_error& error) {
+                std::cout << error.what() << std::endl;
+                status = EXIT_FAILURE;
+            }
+            _exit(status);
+        }
+        pids.push_back(PID);
+    }
+
+    // Meanwhile, merge the trees into the output
+    bool failed = false;
+    try {
+        MergeUnits(INPUT_FILES, units, OUTPUT_FILE, TREES_ONLY);
+    }
+    catch (std::runtime_error& error) {
+        std::cout << error.what() << std::endl;
+        failed = true;
+    }
+    for (auto& i_pid : pids) {
+        int status = 0;
+        waitpid(i_pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+            failed = true;
+        }
+    }
+    if (failed) {
+        for (auto& i_part : part_files) {
+            std::remove(i_part.c_str());
+        }
+        std::remove(OUTPUT_FILE.c_str());
+        std::cout << "A merge job failed." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Add the parts to the trees
+    TFile output(OUTPUT_FILE.c_str(), "UPDATE");
+    for (auto& i_part : part_files) {
+        TFile part(i_part.c_str(), "READ");
+        CopyDirectory(&part, &output);
+        part.Close();
+        std::remove(i_part.c_str());
+    }
+    output.Close();
+
+    return EXIT_SUCCESS;
+}
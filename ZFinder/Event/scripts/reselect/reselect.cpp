@@ -0,0 +1,487 @@
+// Interface
+#include "reselect.h"
+
+// Standard Library
+#include <cmath>  // fabs
+#include <fstream>  // std::ifstream
+#include <iostream>
+#include <sstream>  // std::ostringstream, std::istringstream
+#include <stdexcept>  // std::runtime_error
+
+// ROOT
+#include <TFile.h>
+#include <TH1D.h>
+
+// ZFinder
+#include "../zdef_tree/zdef_tree_reader.h"  // GetTTree
+
+/*
+ * Apply new ZDefinitions to the "Electron Cuts/electrons" tree written by
+ * ZFinder when run with store_electron_cuts = True.
+ *
+ * Usage:
+ *
+ *     reselect.exe input.root definitions.txt output.root
+ *
+ * The definitions file contains one or more blocks of the form:
+ *
+ *     name = Combined Single
+ *     cuts0 = acc(ALL) acc(MUON_TIGHT) trig(single_ele) pt>30 eg_medium
+ *     cuts1 = acc(ALL) acc(MUON_LOOSE) acc(ALL) pt>20 eg_medium
+ *     min_mz = 60
+ *     max_mz = 120
+ *     use_truth_mass = False
+ *
+ * where the cuts are the same strings used in zdefinitions_cfi.py. Lines
+ * starting with # are ignored.
+ *
+ * For each definition the output file contains a cut flow histogram and a
+ * tree with one entry per input entry (so it can be used as a friend) that
+ * stores whether the event passed and its weight.
+ */
+
+Reselection::Reselection(
+        const std::string NAME,
+        const std::vector<std::string>& CUTS0,
+        const std::vector<std::string>& CUTS1,
+        const double MZ_MIN,
+        const double MZ_MAX,
+        const bool USE_MC_MASS
+        ) :
+    NAME(NAME),
+    MZ_MIN_(MZ_MIN),
+    MZ_MAX_(MZ_MAX),
+    USE_MC_MASS_(USE_MC_MASS)
+{
+    if (CUTS0.size() != CUTS1.size()) {
+        const std::string ERR = "In " + NAME + ", cuts0 and cuts1 have different length!";
+        throw std::runtime_error(ERR);
+    }
+    if (MZ_MIN_ > MZ_MAX_) {
+        const std::string ERR = "In " + NAME + ", min_mz > max_mz!";
+        throw std::runtime_error(ERR);
+    }
+
+    for (auto& i_cut : CUTS0) {
+        cutinfo_[0].push_back(ParseCut(i_cut));
+    }
+    for (auto& i_cut : CUTS1) {
+        cutinfo_[1].push_back(ParseCut(i_cut));
+    }
+
+    // Name the levels the same way as ZDefinition
+    for (unsigned int i = 0; i < CUTS0.size(); ++i) {
+        level_names.push_back(cutinfo_[0][i].cut + " AND " + cutinfo_[1][i].cut);
+    }
+    std::ostringstream ss0;
+    ss0 << MZ_MIN_;
+    std::ostringstream ss1;
+    ss1 << MZ_MAX_;
+    if (USE_MC_MASS_) {
+        level_names.push_back(ss0.str() + " < GEN M_{ee} < " + ss1.str());
+    } else {
+        level_names.push_back(ss0.str() + " < M_{ee} < " + ss1.str());
+    }
+
+    pass.resize(level_names.size(), false);
+    t0p1_pass.resize(level_names.size(), false);
+    t1p0_pass.resize(level_names.size(), false);
+    weight.resize(level_names.size(), 1.);
+}
+
+Reselection::CutInfo Reselection::ParseCut(const std::string& CUT) {
+    CutInfo ci;
+    ci.cut = CUT;
+    ci.invert = false;
+    ci.comp_type = CT_NONE;
+    ci.comp_var = CV_NONE;
+    ci.comp_source = ES_RECO;
+    ci.comp_val = -1;
+
+    // We use a ! flag in the [0] slot to invert the cut
+    if (!ci.cut.empty() && ci.cut[0] == '!') {
+        ci.invert = true;
+        ci.cut.erase(0, 1);
+    }
+
+    ci.bit = zf::CutBitIndex(zf::CUT_BIT_NAMES, ci.cut);
+    ci.weight_bit = zf::CutBitIndex(zf::CUT_BIT_WEIGHTED_NAMES, ci.cut);
+
+    // Comparison type, in the same order of precedence as ZDefinition
+    using std::string;
+    if (ci.cut.find("<") != string::npos) {
+        ci.comp_type = (ci.cut.find("=") != string::npos) ? CT_LTE : CT_LT;
+    } else if (ci.cut.find(">") != string::npos) {
+        ci.comp_type = (ci.cut.find("=") != string::npos) ? CT_GTE : CT_GT;
+    } else if (ci.cut.find("=") != string::npos) {
+        ci.comp_type = CT_EQUAL;
+    }
+    if (ci.comp_type == CT_NONE) {
+        return ci;
+    }
+
+    // Comparison variable, checked in the same order as ZDefinition so that
+    // prefixes resolve identically
+    struct VariablePrefix {
+        std::string prefix;
+        ComparisonVariable var;
+        ElectronSource source;
+    };
+    const std::vector<VariablePrefix> PREFIXES = {
+        {"pt", CV_PT, ES_RECO},
+        {"gpt", CV_PT, ES_TRUTH},
+        {"tpt", CV_PT, ES_TRIG},
+        {"eta", CV_ETA, ES_RECO},
+        {"geta", CV_ETA, ES_TRUTH},
+        {"teta", CV_ETA, ES_TRIG},
+        {"phi", CV_PHI, ES_RECO},
+        {"gphi", CV_PHI, ES_TRUTH},
+        {"tphi", CV_PHI, ES_TRIG},
+        {"charge", CV_CHARGE, ES_RECO},
+        {"gcharge", CV_CHARGE, ES_TRUTH},
+        {"tcharge", CV_CHARGE, ES_TRIG},
+        {"aeta", CV_AETA, ES_RECO},
+        {"gaeta", CV_AETA, ES_TRUTH},
+        {"taeta", CV_AETA, ES_TRIG},
+        {"r9", CV_R9, ES_RECO},
+    };
+    for (auto& i_prefix : PREFIXES) {
+        if (ci.cut.compare(0, i_prefix.prefix.size(), i_prefix.prefix) == 0) {
+            ci.comp_var = i_prefix.var;
+            ci.comp_source = i_prefix.source;
+            break;
+        }
+    }
+
+    // Comparison value; everything after the last operator
+    const int GT_POS = ci.cut.find(">");
+    const int LT_POS = ci.cut.find("<");
+    const int EQ_POS = ci.cut.find("=");
+    int pos;
+    if (GT_POS > LT_POS && GT_POS > EQ_POS) {
+        pos = GT_POS;
+    } else if (LT_POS > GT_POS && LT_POS > EQ_POS) {
+        pos = LT_POS;
+    } else {
+        pos = EQ_POS;
+    }
+    std::istringstream iss(ci.cut.substr(pos + 1));
+    iss >> ci.comp_val;
+
+    return ci;
+}
+
+double Reselection::Efficiency(const CutInfo& CUTINFO, const int I_ELEC, const electron_event& EVENT) {
+    // If the electron doesn't exist we return 0
+    if (EVENT.reco.pt[I_ELEC] < 0) {
+        return 0.;
+    }
+
+    // Cuts without a result have an efficiency of 1, and are not inverted
+    if (CUTINFO.bit < 0 || !(EVENT.cut_known[I_ELEC] & (1ULL << CUTINFO.bit))) {
+        return 1.;
+    }
+
+    double efficiency = 1.;
+    if (CUTINFO.weight_bit >= 0) {
+        efficiency = EVENT.cut_weights[I_ELEC][CUTINFO.weight_bit];
+    }
+    if (CUTINFO.invert) {
+        efficiency = 1 - efficiency;
+    }
+
+    return efficiency;
+}
+
+bool Reselection::PassCut(const CutInfo& CUTINFO, const int I_ELEC, const electron_event& EVENT) {
+    /*
+     * Normal cuts are read from the bitmask; a cut that the electron has no
+     * result for passes (unless inverted), as it does in ZDefinition.
+     */
+    if (CUTINFO.comp_type == CT_NONE) {
+        if (EVENT.reco.pt[I_ELEC] < 0) {
+            return false;
+        }
+        bool passed = true;
+        if (CUTINFO.bit >= 0) {
+            const ULong64_t BIT = 1ULL << CUTINFO.bit;
+            if (EVENT.cut_known[I_ELEC] & BIT) {
+                passed = EVENT.cut_bits[I_ELEC] & BIT;
+            }
+        }
+        return CUTINFO.invert ? !passed : passed;
+    }
+
+    // Comparison cuts; gen cuts always fail on data
+    if (CUTINFO.comp_source == ES_TRUTH && !EVENT.event_info.is_mc) {
+        return false;
+    }
+    const electron_branch* elec;
+    switch (CUTINFO.comp_source) {
+        case ES_TRUTH:
+            elec = &EVENT.truth;
+            break;
+        case ES_TRIG:
+            elec = &EVENT.trig;
+            break;
+        case ES_RECO:
+        default:
+            elec = &EVENT.reco;
+            break;
+    }
+    // Not all the required electrons existed, so fail
+    if (elec->pt[I_ELEC] < 0) {
+        return false;
+    }
+
+    double e_val = -1;
+    switch (CUTINFO.comp_var) {
+        case CV_PT:
+            e_val = elec->pt[I_ELEC];
+            break;
+        case CV_ETA:
+            e_val = elec->eta[I_ELEC];
+            break;
+        case CV_PHI:
+            e_val = elec->phi[I_ELEC];
+            break;
+        case CV_CHARGE:
+            e_val = elec->charge[I_ELEC];
+            break;
+        case CV_AETA:
+            e_val = fabs(elec->eta[I_ELEC]);
+            break;
+        case CV_R9:
+            e_val = elec->rnine[I_ELEC];
+            break;
+        case CV_NONE:
+        default:
+            return false;
+    }
+
+    bool passed = false;
+    switch (CUTINFO.comp_type) {
+        case CT_EQUAL:
+            passed = (e_val == CUTINFO.comp_val);
+            break;
+        case CT_GT:
+            passed = (e_val > CUTINFO.comp_val);
+            break;
+        case CT_LT:
+            passed = (e_val < CUTINFO.comp_val);
+            break;
+        case CT_GTE:
+            passed = (e_val >= CUTINFO.comp_val);
+            break;
+        case CT_LTE:
+            passed = (e_val <= CUTINFO.comp_val);
+            break;
+        case CT_NONE:
+        default:
+            return false;
+    }
+
+    return CUTINFO.invert ? !passed : passed;
+}
+
+void Reselection::ApplySelection(const electron_event& EVENT) {
+    /*
+     * Follows ZDefinition::FillCutLevelVector: t0p1 applies cuts0 to e0 and
+     * cuts1 to e1, t1p0 the reverse, and each level requires all previous
+     * levels.
+     */
+    const size_t SIZE = cutinfo_[0].size();
+    bool t0p1 = true;
+    bool t1p0 = true;
+    double t0p1_eff = EVENT.event_weight;
+    double t1p0_eff = EVENT.event_weight;
+    for (size_t i = 0; i < SIZE; ++i) {
+        const CutInfo& CUT0 = cutinfo_[0][i];
+        const CutInfo& CUT1 = cutinfo_[1][i];
+        t0p1 = t0p1 && PassCut(CUT0, 0, EVENT) && PassCut(CUT1, 1, EVENT);
+        t1p0 = t1p0 && PassCut(CUT0, 1, EVENT) && PassCut(CUT1, 0, EVENT);
+        t0p1_eff *= Efficiency(CUT0, 0, EVENT) * Efficiency(CUT1, 1, EVENT);
+        t1p0_eff *= Efficiency(CUT0, 1, EVENT) * Efficiency(CUT1, 0, EVENT);
+
+        t0p1_pass[i] = t0p1;
+        t1p0_pass[i] = t1p0;
+        pass[i] = t0p1 || t1p0;
+        weight[i] = t0p1 ? t0p1_eff : t1p0_eff;
+    }
+
+    // The mass cut
+    const double MZ = USE_MC_MASS_ ? EVENT.truth_z.z_m : EVENT.reco_z.z_m;
+    const bool PASS_MZ = !(MZ > MZ_MAX_ || MZ < MZ_MIN_);
+    t0p1 = t0p1 && PASS_MZ;
+    t1p0 = t1p0 && PASS_MZ;
+    t0p1_pass.back() = t0p1;
+    t1p0_pass.back() = t1p0;
+    pass.back() = t0p1 || t1p0;
+    weight.back() = t0p1 ? t0p1_eff : t1p0_eff;
+}
+
+std::vector<Reselection*> ReadDefinitions(const std::string FILE_NAME) {
+    std::ifstream infile(FILE_NAME.c_str());
+    if (!infile.good()) {
+        const std::string ERR = "Could not open the definitions file " + FILE_NAME;
+        throw std::runtime_error(ERR);
+    }
+
+    std::vector<Reselection*> definitions;
+
+    std::string name;
+    std::vector<std::string> cuts0;
+    std::vector<std::string> cuts1;
+    double min_mz = 60;
+    double max_mz = 120;
+    bool use_truth_mass = false;
+
+    // Add the current block, if there is one, and reset the values
+    auto add_definition = [&]() {
+        if (!name.empty()) {
+            definitions.push_back(new Reselection(name, cuts0, cuts1, min_mz, max_mz, use_truth_mass));
+        }
+        name.clear();
+        cuts0.clear();
+        cuts1.clear();
+        min_mz = 60;
+        max_mz = 120;
+        use_truth_mass = false;
+    };
+
+    std::string line;
+    while (std::getline(infile, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        const size_t EQ_POS = line.find(" = ");
+        if (EQ_POS == std::string::npos) {
+            const std::string ERR = "Could not parse line: " + line;
+            throw std::runtime_error(ERR);
+        }
+        const std::string KEY = line.substr(0, EQ_POS);
+        const std::string VALUE = line.substr(EQ_POS + 3);
+        std::istringstream iss(VALUE);
+
+        if (KEY == "name") {
+            add_definition();
+            name = VALUE;
+        } else if (KEY == "cuts0" || KEY == "cuts1") {
+            std::vector<std::string>* cuts = (KEY == "cuts0") ? &cuts0 : &cuts1;
+            std::string cut;
+            while (iss >> cut) {
+                cuts->push_back(cut);
+            }
+        } else if (KEY == "min_mz") {
+            iss >> min_mz;
+        } else if (KEY == "max_mz") {
+            iss >> max_mz;
+        } else if (KEY == "use_truth_mass") {
+            use_truth_mass = (VALUE == "True" || VALUE == "true" || VALUE == "1");
+        } else {
+            const std::string ERR = "Unknown key: " + KEY;
+            throw std::runtime_error(ERR);
+        }
+    }
+    add_definition();
+
+    return definitions;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 4) {
+        std::cout << "Usage: " << argv[0] << " input.root definitions.txt output.root" << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::string INPUT_FILE = argv[1];
+    const std::string DEFINITION_FILE = argv[2];
+    const std::string OUTPUT_FILE = argv[3];
+
+    const std::string TREE_NAME = "ZFinder/Electron Cuts/electrons";
+    TTree* tree = GetTTree(INPUT_FILE, TREE_NAME);
+    std::vector<Reselection*> definitions = ReadDefinitions(DEFINITION_FILE);
+
+    // Read only the branches we need
+    electron_event event;
+    const bool IS_MC = (tree->GetBranch("truth") != nullptr);
+    tree->SetBranchAddress("reco", &event.reco);
+    tree->SetBranchAddress("trig", &event.trig);
+    tree->SetBranchAddress("reco_z", &event.reco_z);
+    if (IS_MC) {
+        tree->SetBranchAddress("truth", &event.truth);
+        tree->SetBranchAddress("truth_z", &event.truth_z);
+    } else {
+        for (int i = 0; i < 2; ++i) {
+            event.truth.pt[i] = -1;
+        }
+        event.truth_z.z_m = -1;
+    }
+    tree->SetBranchAddress("cut_bits", event.cut_bits);
+    tree->SetBranchAddress("cut_known", event.cut_known);
+    tree->SetBranchAddress("cut_weights", event.cut_weights);
+    tree->SetBranchAddress("event_weight", &event.event_weight);
+    tree->SetBranchAddress("event_info", &event.event_info);
+
+    // Set up the output
+    TFile* output_file = new TFile(OUTPUT_FILE.c_str(), "RECREATE");
+    std::vector<TH1D*> cutflows;
+    std::vector<TTree*> out_trees;
+    std::vector<double> out_weight(definitions.size(), 0.);
+    // std::vector<bool> has no addressable elements
+    bool* pass_array = new bool[definitions.size()];
+    for (unsigned int i = 0; i < definitions.size(); ++i) {
+        Reselection* def = definitions[i];
+        TDirectory* tdir = output_file->mkdir(def->NAME.c_str());
+        tdir->cd();
+        const int N_LEVELS = def->level_names.size();
+        TH1D* cutflow = new TH1D("cutflow", "Weighted cut flow", N_LEVELS, 0, N_LEVELS);
+        cutflow->Sumw2();
+        for (int i_level = 0; i_level < N_LEVELS; ++i_level) {
+            cutflow->GetXaxis()->SetBinLabel(i_level + 1, def->level_names[i_level].c_str());
+        }
+        cutflows.push_back(cutflow);
+        TTree* out_tree = new TTree("reselection", def->NAME.c_str());
+        out_tree->Branch("pass", &pass_array[i], "pass/O");
+        out_tree->Branch("weight", &out_weight[i], "weight/D");
+        out_trees.push_back(out_tree);
+    }
+
+    // Loop over the events
+    const long N_ENTRIES = tree->GetEntries();
+    for (long i = 0; i < N_ENTRIES; ++i) {
+        tree->GetEntry(i);
+        for (unsigned int i_def = 0; i_def < definitions.size(); ++i_def) {
+            Reselection* def = definitions[i_def];
+            def->ApplySelection(event);
+            for (unsigned int i_level = 0; i_level < def->pass.size(); ++i_level) {
+                if (!def->pass[i_level]) {
+                    break;
+                }
+                cutflows[i_def]->Fill(i_level, def->weight[i_level]);
+            }
+            pass_array[i_def] = def->pass.back();
+            out_weight[i_def] = def->pass.back() ? def->weight.back() : 0.;
+            out_trees[i_def]->Fill();
+        }
+    }
+
+    // Print the cut flows and save
+    for (unsigned int i = 0; i < definitions.size(); ++i) {
+        std::cout << definitions[i]->NAME << std::endl;
+        for (int i_bin = 1; i_bin <= cutflows[i]->GetNbinsX(); ++i_bin) {
+            std::cout << "    " << cutflows[i]->GetXaxis()->GetBinLabel(i_bin);
+            std::cout << ": " << cutflows[i]->GetBinContent(i_bin) << std::endl;
+        }
+        output_file->cd(definitions[i]->NAME.c_str());
+        cutflows[i]->Write();
+        out_trees[i]->Write();
+    }
+    output_file->Close();
+
+    delete[] pass_array;
+    for (auto& i_def : definitions) {
+        delete i_def;
+    }
+
+    return EXIT_SUCCESS;
+}
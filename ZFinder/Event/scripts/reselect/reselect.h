@@ -0,0 +1,130 @@
+#ifndef RESELECT_H_
+#define RESELECT_H_
+
+// Standard Library
+#include <string>
+#include <vector>
+
+// ROOT
+#include <TTree.h>
+
+// ZFinder
+#include "../../interface/CutBits.h"  // N_WEIGHTED_CUTS
+
+/*
+ * The branches written by ZElectronTree.
+ */
+struct electron_branch {
+    float pt[2];
+    float eta[2];
+    float phi[2];
+    float rnine[2];
+    int charge[2];
+};
+
+struct z_branch {
+    float z_m;
+    float z_y;
+    float z_phistar;
+    float z_pt;
+};
+
+struct event_branch {
+    unsigned int event_number;
+    unsigned int run_number;
+    unsigned int lumi_number;
+    bool is_mc;
+};
+
+struct electron_event {
+    electron_branch reco;
+    electron_branch truth;
+    electron_branch trig;
+    z_branch reco_z;
+    z_branch truth_z;
+    event_branch event_info;
+    ULong64_t cut_bits[2];
+    ULong64_t cut_known[2];
+    float cut_weights[2][zf::N_WEIGHTED_CUTS];
+    double event_weight;
+};
+
+/*
+ * A ZDefinition that is applied to the output of ZElectronTree instead of to
+ * a ZFinderEvent. The cut strings, inversion, comparison cuts, efficiencies,
+ * and tag/probe logic all follow ZDefinition.cc exactly.
+ */
+class Reselection {
+    public:
+        Reselection(
+            const std::string NAME,
+            const std::vector<std::string>& CUTS0,
+            const std::vector<std::string>& CUTS1,
+            const double MZ_MIN,
+            const double MZ_MAX,
+            const bool USE_MC_MASS
+        );
+
+        // Apply the selection to an event, filling pass and weight for each
+        // cut level (the last level is the mass cut)
+        void ApplySelection(const electron_event& EVENT);
+
+        const std::string NAME;
+        std::vector<std::string> level_names;
+        std::vector<bool> pass;
+        std::vector<bool> t0p1_pass;
+        std::vector<bool> t1p0_pass;
+        std::vector<double> weight;
+
+    protected:
+        const double MZ_MIN_;
+        const double MZ_MAX_;
+        const bool USE_MC_MASS_;
+
+        enum ComparisonType {
+            CT_NONE,
+            CT_EQUAL,
+            CT_GT,
+            CT_LT,
+            CT_GTE,
+            CT_LTE
+        };
+
+        // R, G, T are the reco, generator, and trigger electrons
+        enum ElectronSource {
+            ES_RECO,
+            ES_TRUTH,
+            ES_TRIG
+        };
+
+        enum ComparisonVariable {
+            CV_NONE,
+            CV_PT,
+            CV_ETA,
+            CV_PHI,
+            CV_CHARGE,
+            CV_AETA,
+            CV_R9
+        };
+
+        struct CutInfo {
+            std::string cut;
+            bool invert;
+            ComparisonType comp_type;
+            ComparisonVariable comp_var;
+            ElectronSource comp_source;
+            double comp_val;
+            int bit;  // Position in CUT_BIT_NAMES, -1 if not stored
+            int weight_bit;  // Position in CUT_BIT_WEIGHTED_NAMES, -1 if none
+        };
+
+        std::vector<CutInfo> cutinfo_[2];
+
+        CutInfo ParseCut(const std::string& CUT);
+        bool PassCut(const CutInfo& CUTINFO, const int I_ELEC, const electron_event& EVENT);
+        double Efficiency(const CutInfo& CUTINFO, const int I_ELEC, const electron_event& EVENT);
+};
+
+std::vector<Reselection*> ReadDefinitions(const std::string FILE_NAME);
+
+#endif  // RESELECT_H_
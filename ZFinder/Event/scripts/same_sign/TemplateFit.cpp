@@ -0,0 +1,402 @@
+#include "TemplateFit.h"
+
+// Standard Library
+#include <algorithm>  // std::min, std::max
+#include <cmath>  // erfc, exp, log, sqrt, fabs, HUGE_VAL
+#include <stdexcept>  // std::runtime_error
+
+namespace {
+    const int N = TemplateFit::N_PARAMETERS;
+
+    // Cholesky decomposition of the N_FREE x N_FREE matrix A in place (lower
+    // triangle). Returns false if A is not positive definite.
+    bool Cholesky(double a[][N], const int N_FREE) {
+        for (int i = 0; i < N_FREE; ++i) {
+            for (int j = 0; j <= i; ++j) {
+                double sum = a[i][j];
+                for (int k = 0; k < j; ++k) {
+                    sum -= a[i][k] * a[j][k];
+                }
+                if (i == j) {
+                    if (sum <= 0) {
+                        return false;
+                    }
+                    a[i][i] = sqrt(sum);
+                }
+                else {
+                    a[i][j] = sum / a[j][j];
+                }
+            }
+        }
+        return true;
+    }
+
+    // Solves L L^T x = B with the decomposition from Cholesky
+    void CholeskySolve(const double L[][N], const int N_FREE, const double* B, double* x) {
+        for (int i = 0; i < N_FREE; ++i) {
+            double sum = B[i];
+            for (int k = 0; k < i; ++k) {
+                sum -= L[i][k] * x[k];
+            }
+            x[i] = sum / L[i][i];
+        }
+        for (int i = N_FREE - 1; i >= 0; --i) {
+            double sum = x[i];
+            for (int k = i + 1; k < N_FREE; ++k) {
+                sum -= L[k][i] * x[k];
+            }
+            x[i] = sum / L[i][i];
+        }
+    }
+}  // namespace
+
+TemplateFit::TemplateFit(const std::vector<double>& EDGES, const std::vector<double>& TEMPLATE) :
+    edges_(EDGES)
+{
+    if (EDGES.size() != TEMPLATE.size() + 1 || TEMPLATE.empty()) {
+        throw std::runtime_error("TemplateFit needs one more edge than template bins");
+    }
+    double sum = 0;
+    for (auto& i_bin : TEMPLATE) {
+        sum += i_bin;
+    }
+    if (sum <= 0) {
+        throw std::runtime_error("TemplateFit needs a template with a positive integral");
+    }
+    for (size_t i = 0; i < TEMPLATE.size(); ++i) {
+        const double WIDTH = EDGES[i + 1] - EDGES[i];
+        centers_.push_back(EDGES[i] + WIDTH / 2.);
+        density_.push_back(TEMPLATE[i] / (sum * WIDTH));
+    }
+    full_range_ = MakeQuadrature(EDGES.front(), EDGES.back());
+
+    SetParameter(SIGNAL_FRACTION, 0.9, 0.6, 1.0);
+    SetParameter(ALPHA, 50., 10., 90.);
+    SetParameter(GAMMA, 0.01, 0.0001, 0.03);
+    SetParameter(DELTA, 40., 10., 80.);
+}
+
+void TemplateFit::SetParameter(const parameter PAR, const double START, const double LOW, const double HIGH) {
+    start_[PAR] = START;
+    low_[PAR] = LOW;
+    high_[PAR] = HIGH;
+}
+
+TemplateFit::shape TemplateFit::Background(const double M, const double* PARS) {
+    /*
+     * b = erfc(u) * exp(-gamma * m) with u = (alpha - m) / delta. The
+     * derivatives use erfc'(u) = -2/sqrt(pi) exp(-u^2) and erfc''(u) = -2u
+     * erfc'(u).
+     */
+    const double ALPHA = PARS[0];
+    const double GAMMA = PARS[1];
+    const double DELTA = PARS[2];
+    const double U = (ALPHA - M) / DELTA;
+    const double X = exp(-GAMMA * M);
+    const double E0 = erfc(U);
+    const double E1 = -2. / sqrt(M_PI) * exp(-U * U);
+    const double E2 = -2. * U * E1;
+    const double U_A = 1. / DELTA;
+    const double U_D = -U / DELTA;
+    const double U_AD = -1. / (DELTA * DELTA);
+    const double U_DD = 2. * U / (DELTA * DELTA);
+
+    shape out;
+    out.value = E0 * X;
+    out.gradient[0] = E1 * U_A * X;
+    out.gradient[1] = -M * out.value;
+    out.gradient[2] = E1 * U_D * X;
+    out.hessian[0][0] = E2 * U_A * U_A * X;
+    out.hessian[0][1] = -M * out.gradient[0];
+    out.hessian[0][2] = (E2 * U_A * U_D + E1 * U_AD) * X;
+    out.hessian[1][1] = M * M * out.value;
+    out.hessian[1][2] = -M * out.gradient[2];
+    out.hessian[2][2] = (E2 * U_D * U_D + E1 * U_DD) * X;
+    out.hessian[1][0] = out.hessian[0][1];
+    out.hessian[2][0] = out.hessian[0][2];
+    out.hessian[2][1] = out.hessian[1][2];
+    return out;
+}
+
+TemplateFit::quadrature TemplateFit::MakeQuadrature(const double LOW, const double HIGH) const {
+    // Five point Gauss-Legendre on each bin (or part of a bin) in the range
+    const double NODES[] = {0., -0.5384693101056831, 0.5384693101056831, -0.9061798459386640, 0.9061798459386640};
+    const double WEIGHTS[] = {0.5688888888888889, 0.4786286704993665, 0.4786286704993665, 0.2369268850561891, 0.2369268850561891};
+    std::vector<double> points(1, LOW);
+    for (auto& i_edge : edges_) {
+        if (i_edge > LOW && i_edge < HIGH) {
+            points.push_back(i_edge);
+        }
+    }
+    points.push_back(HIGH);
+
+    quadrature out;
+    for (size_t i = 0; i + 1 < points.size(); ++i) {
+        const double MID = (points[i] + points[i + 1]) / 2.;
+        const double HALF = (points[i + 1] - points[i]) / 2.;
+        for (int j = 0; j < 5; ++j) {
+            out.x.push_back(MID + HALF * NODES[j]);
+            out.w.push_back(HALF * WEIGHTS[j]);
+        }
+    }
+    return out;
+}
+
+TemplateFit::shape TemplateFit::Integrate(const quadrature& QUAD, const double* PARS) {
+    shape out = {};
+    for (size_t i = 0; i < QUAD.x.size(); ++i) {
+        const shape B = Background(QUAD.x[i], PARS);
+        const double W = QUAD.w[i];
+        out.value += W * B.value;
+        for (int k = 0; k < N_BACKGROUND; ++k) {
+            out.gradient[k] += W * B.gradient[k];
+            for (int l = 0; l < N_BACKGROUND; ++l) {
+                out.hessian[k][l] += W * B.hessian[k][l];
+            }
+        }
+    }
+    return out;
+}
+
+double TemplateFit::NLL(
+        const std::vector<double>& DATA,
+        const double* PARS,
+        double* gradient,
+        double hessian[][N_PARAMETERS]
+        ) const {
+    /*
+     * The pdf is d = f tau + (1 - f) beta, with beta = b / I the background
+     * normalized by its integral I. Then
+     *
+     *     dbeta/dk = b_k / I - b I_k / I^2
+     *     d2beta/dkdl = b_kl / I - (b_k I_l + b_l I_k) / I^2 - b I_kl / I^2 + 2 b I_k I_l / I^3
+     *
+     * and NLL = -sum(n log d) has the gradient -sum(n d' / d) and the
+     * Hessian sum(n (d' d'^T / d^2 - d'' / d)).
+     */
+    const double F = PARS[SIGNAL_FRACTION];
+    const double* BG_PARS = PARS + 1;
+    const shape I = Integrate(full_range_, BG_PARS);
+    if (I.value <= 0) {
+        return HUGE_VAL;
+    }
+
+    if (gradient != nullptr) {
+        for (int k = 0; k < N; ++k) {
+            gradient[k] = 0;
+            for (int l = 0; l < N; ++l) {
+                hessian[k][l] = 0;
+            }
+        }
+    }
+
+    double nll = 0;
+    for (size_t i = 0; i < DATA.size(); ++i) {
+        const double COUNT = DATA[i];
+        if (COUNT == 0) {
+            continue;
+        }
+        const shape B = Background(centers_[i], BG_PARS);
+        const double BETA = B.value / I.value;
+        const double D = F * density_[i] + (1. - F) * BETA;
+        if (D <= 0) {
+            return HUGE_VAL;
+        }
+        nll -= COUNT * log(D);
+        if (gradient == nullptr) {
+            continue;
+        }
+
+        double beta_k[N_BACKGROUND];
+        for (int k = 0; k < N_BACKGROUND; ++k) {
+            beta_k[k] = B.gradient[k] / I.value - B.value * I.gradient[k] / (I.value * I.value);
+        }
+        double d_k[N];
+        d_k[SIGNAL_FRACTION] = density_[i] - BETA;
+        for (int k = 0; k < N_BACKGROUND; ++k) {
+            d_k[k + 1] = (1. - F) * beta_k[k];
+        }
+        double d_kl[N][N] = {};
+        for (int k = 0; k < N_BACKGROUND; ++k) {
+            d_kl[0][k + 1] = -beta_k[k];
+            d_kl[k + 1][0] = -beta_k[k];
+            for (int l = 0; l < N_BACKGROUND; ++l) {
+                const double BETA_KL =
+                    B.hessian[k][l] / I.value
+                    - (B.gradient[k] * I.gradient[l] + B.gradient[l] * I.gradient[k]) / (I.value * I.value)
+                    - B.value * I.hessian[k][l] / (I.value * I.value)
+                    + 2. * B.value * I.gradient[k] * I.gradient[l] / (I.value * I.value * I.value);
+                d_kl[k + 1][l + 1] = (1. - F) * BETA_KL;
+            }
+        }
+
+        for (int k = 0; k < N; ++k) {
+            gradient[k] -= COUNT * d_k[k] / D;
+            for (int l = 0; l < N; ++l) {
+                hessian[k][l] += COUNT * (d_k[k] * d_k[l] / (D * D) - d_kl[k][l] / D);
+            }
+        }
+    }
+    return nll;
+}
+
+TemplateFit::result TemplateFit::Fit(const std::vector<double>& DATA) const {
+    /*
+     * Damped Newton: the step solves (H + lambda diag(H)) s = -g over the
+     * free parameters, halved until the likelihood decreases. Parameters at
+     * a limit whose gradient points out of the range are held there. The
+     * fit has converged when the estimated distance to the minimum,
+     * g^T H^-1 g / 2, is below EDM_TOLERANCE.
+     */
+    if (DATA.size() != density_.size()) {
+        throw std::runtime_error("TemplateFit::Fit needs data with the binning of the template");
+    }
+    const int MAX_ITERATIONS = 200;
+    const double EDM_TOLERANCE = 1e-9;
+
+    result out = {};
+    double* x = out.values;
+    for (int k = 0; k < N; ++k) {
+        x[k] = std::min(std::max(start_[k], low_[k]), high_[k]);
+    }
+
+    double gradient[N];
+    double hessian[N][N];
+    double lambda = 0;
+    int free_pars[N];
+    int n_free = 0;
+    for (out.iterations = 0; out.iterations < MAX_ITERATIONS; ++out.iterations) {
+        out.nll = NLL(DATA, x, gradient, hessian);
+        n_free = 0;
+        for (int k = 0; k < N; ++k) {
+            const bool HELD_LOW = (x[k] <= low_[k] && gradient[k] > 0);
+            const bool HELD_HIGH = (x[k] >= high_[k] && gradient[k] < 0);
+            if (!HELD_LOW && !HELD_HIGH) {
+                free_pars[n_free++] = k;
+            }
+        }
+        double g[N];
+        for (int i = 0; i < n_free; ++i) {
+            g[i] = gradient[free_pars[i]];
+        }
+
+        // The undamped step gives the distance to the minimum
+        double l[N][N];
+        double step[N];
+        for (int i = 0; i < n_free; ++i) {
+            for (int j = 0; j < n_free; ++j) {
+                l[i][j] = hessian[free_pars[i]][free_pars[j]];
+            }
+        }
+        if (Cholesky(l, n_free)) {
+            CholeskySolve(l, n_free, g, step);
+            out.edm = 0;
+            for (int i = 0; i < n_free; ++i) {
+                out.edm += g[i] * step[i] / 2.;
+            }
+            if (out.edm < EDM_TOLERANCE) {
+                out.converged = true;
+                break;
+            }
+        }
+        else {
+            lambda = std::max(lambda, 1e-3);
+        }
+
+        // Take a step, damping more until the likelihood decreases
+        bool moved = false;
+        while (!moved && lambda < 1e10) {
+            for (int i = 0; i < n_free; ++i) {
+                for (int j = 0; j < n_free; ++j) {
+                    l[i][j] = hessian[free_pars[i]][free_pars[j]];
+                }
+                l[i][i] += lambda * std::max(fabs(l[i][i]), 1e-12);
+            }
+            if (!Cholesky(l, n_free)) {
+                lambda = std::max(10. * lambda, 1e-3);
+                continue;
+            }
+            CholeskySolve(l, n_free, g, step);
+            for (double t = 1; t > 1e-6 && !moved; t /= 2.) {
+                double trial[N];
+                std::copy(x, x + N, trial);
+                for (int i = 0; i < n_free; ++i) {
+                    const int K = free_pars[i];
+                    trial[K] = std::min(std::max(x[K] - t * step[i], low_[K]), high_[K]);
+                }
+                if (NLL(DATA, trial, nullptr, nullptr) < out.nll) {
+                    std::copy(trial, trial + N, x);
+                    moved = true;
+                }
+            }
+            if (moved) {
+                lambda = (lambda > 1e-6) ? lambda / 10. : 0;
+            }
+            else {
+                lambda = std::max(10. * lambda, 1e-3);
+            }
+        }
+        if (!moved) {
+            break;
+        }
+    }
+
+    // The covariance is the inverse Hessian of the free parameters
+    out.nll = NLL(DATA, x, gradient, hessian);
+    double l[N][N];
+    for (int i = 0; i < n_free; ++i) {
+        for (int j = 0; j < n_free; ++j) {
+            l[i][j] = hessian[free_pars[i]][free_pars[j]];
+        }
+    }
+    if (!Cholesky(l, n_free)) {
+        out.converged = false;
+        return out;
+    }
+    for (int j = 0; j < n_free; ++j) {
+        double unit[N] = {};
+        double column[N];
+        unit[j] = 1;
+        CholeskySolve(l, n_free, unit, column);
+        for (int i = 0; i < n_free; ++i) {
+            out.covariance[free_pars[i]][free_pars[j]] = column[i];
+        }
+    }
+    return out;
+}
+
+std::pair<double, double> TemplateFit::BackgroundFraction(const result& RESULT, const double LOW, const double HIGH) const {
+    // F = J / I, so dF/dk = (J_k I - J I_k) / I^2
+    const double* BG_PARS = RESULT.values + 1;
+    const shape I = Integrate(full_range_, BG_PARS);
+    const shape J = Integrate(MakeQuadrature(LOW, HIGH), BG_PARS);
+    double f_k[N_BACKGROUND];
+    for (int k = 0; k < N_BACKGROUND; ++k) {
+        f_k[k] = (J.gradient[k] * I.value - J.value * I.gradient[k]) / (I.value * I.value);
+    }
+    double variance = 0;
+    for (int k = 0; k < N_BACKGROUND; ++k) {
+        for (int l = 0; l < N_BACKGROUND; ++l) {
+            variance += f_k[k] * f_k[l] * RESULT.covariance[k + 1][l + 1];
+        }
+    }
+    return std::make_pair(J.value / I.value, sqrt(std::max(variance, 0.)));
+}
+
+void TemplateFit::Expected(
+        const result& RESULT,
+        const double TOTAL,
+        std::vector<double>* signal,
+        std::vector<double>* background
+        ) const {
+    const double F = RESULT.values[SIGNAL_FRACTION];
+    const double* BG_PARS = RESULT.values + 1;
+    const double I = Integrate(full_range_, BG_PARS).value;
+    signal->clear();
+    background->clear();
+    for (size_t i = 0; i < density_.size(); ++i) {
+        const double WIDTH = edges_[i + 1] - edges_[i];
+        signal->push_back(TOTAL * F * density_[i] * WIDTH);
+        background->push_back(TOTAL * (1. - F) * Background(centers_[i], BG_PARS).value / I * WIDTH);
+    }
+}
@@ -0,0 +1,107 @@
+#ifndef TEMPLATEFIT_H_
+#define TEMPLATEFIT_H_
+
+// Standard Library
+#include <utility>  // std::pair
+#include <vector>
+
+/*
+ * A binned maximum likelihood fit of a histogram to a template plus the
+ * background shape of FitForQCDRooFit,
+ *
+ *     f * template(m) + (1 - f) * erfc((alpha - m) / delta) * exp(-gamma * m),
+ *
+ * with both parts normalized over the histogram range. This is the model
+ * that FitForQCDRooFit builds (a RooHistPdf and a RooGenericPdf in a
+ * RooAddPdf fitted to a RooDataHist), and the likelihood is the same, -sum(n_i
+ * * log(pdf(center_i))), so the results agree, but it works on plain arrays
+ * of bin contents.
+ *
+ * The background is normalized by Gauss-Legendre quadrature on the bins.
+ * The gradient and Hessian of the likelihood are computed analytically, and
+ * it is minimized with a damped Newton method that keeps the parameters
+ * within their limits. The covariance is the inverse of the Hessian at the
+ * minimum.
+ */
+class TemplateFit {
+    public:
+        enum parameter {
+            SIGNAL_FRACTION = 0,
+            ALPHA = 1,
+            GAMMA = 2,
+            DELTA = 3,
+            N_PARAMETERS = 4
+        };
+
+        struct result {
+            double values[N_PARAMETERS];
+            double covariance[N_PARAMETERS][N_PARAMETERS];
+            double nll;
+            double edm;  // Estimated distance to the minimum
+            int iterations;
+            bool converged;
+        };
+
+        // EDGES has one more entry than TEMPLATE. The starting values and
+        // limits are those of FitForQCDRooFit.
+        TemplateFit(const std::vector<double>& EDGES, const std::vector<double>& TEMPLATE);
+
+        void SetParameter(const parameter PAR, const double START, const double LOW, const double HIGH);
+
+        // Fit the bin contents DATA, which must have the binning of the
+        // template
+        result Fit(const std::vector<double>& DATA) const;
+
+        // The fraction of the normalized background between LOW and HIGH,
+        // and its error from the covariance
+        std::pair<double, double> BackgroundFraction(const result& RESULT, const double LOW, const double HIGH) const;
+
+        // The expected contents of each bin for TOTAL entries, from the
+        // template and from the background
+        void Expected(
+                const result& RESULT,
+                const double TOTAL,
+                std::vector<double>* signal,
+                std::vector<double>* background
+                ) const;
+
+    protected:
+        static const int N_BACKGROUND = 3;  // alpha, gamma, delta
+
+        // The background and its derivatives by (alpha, gamma, delta)
+        struct shape {
+            double value;
+            double gradient[N_BACKGROUND];
+            double hessian[N_BACKGROUND][N_BACKGROUND];
+        };
+
+        // Quadrature nodes and weights
+        struct quadrature {
+            std::vector<double> x;
+            std::vector<double> w;
+        };
+
+        std::vector<double> edges_;
+        std::vector<double> centers_;
+        std::vector<double> density_;  // Template, normalized, per unit m
+        quadrature full_range_;
+        double start_[N_PARAMETERS];
+        double low_[N_PARAMETERS];
+        double high_[N_PARAMETERS];
+
+        static shape Background(const double M, const double* PARS);
+        quadrature MakeQuadrature(const double LOW, const double HIGH) const;
+        // The integral of the background over the nodes and its derivatives
+        static shape Integrate(const quadrature& QUAD, const double* PARS);
+
+        // The negative log likelihood, and if GRADIENT is not null its
+        // gradient and Hessian
+        double NLL(
+                const std::vector<double>& DATA,
+                const double* PARS,
+                double* gradient,
+                double hessian[][N_PARAMETERS]
+                ) const;
+};
+
+#endif  // TEMPLATEFIT_H_
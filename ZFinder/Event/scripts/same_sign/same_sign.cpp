@@ -1,10 +1,25 @@
 // Interface
-#include "same_sign.h"  // branch_struct
+#include "same_sign.h"  // histogram_map
 
 // Standard Library
+#include <algorithm>  // std::max
+#include <cmath>  // sqrt
+#include <cerrno>  // errno, EINTR
+#include <cstdio>  // fdopen
+#include <cstdlib>  // atoi
+#include <cstring>  // memcpy
+#include <functional>  // std::function
+#include <iomanip>  // std::setprecision, std::setw
 #include <stdexcept>
 #include <iostream>
 #include <sstream>
+#include <vector>
+
+// POSIX
+#include <poll.h>  // poll, pollfd
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 // ROOT
 #include <TFile.h>
@@ -18,6 +33,9 @@
 #include <TFitResult.h>
 #include <TFitResultPtr.h>
 
+// ZFinder
+#include "../zdef_tree/zdef_tree_reader.h"  // ZDefTreeReader, GetTTree
+
 // RooFit
 #include "RooAddPdf.h"
 #include "RooArgSet.h"
@@ -32,29 +50,12 @@
 // Style
 #include "PlotStyle.h"
 
+// Fitting
+#include "TemplateFit.h"  // TemplateFit
+
 // ZFinder
-#include "../../interface/WeightID.h"
 #include "../../interface/ATLASBins.h"  // ATLAS_PHISTAR_BINNING
 
-TTree* GetTTree(const std::string TFILE, const std::string TTREE) {
-    // Open the TFiles
-    TFile* mc_tfile = new TFile(TFILE.c_str(), "READ");
-    if (!mc_tfile || mc_tfile->IsZombie()) {
-        const std::string ERR = "Could not open the file " + TFILE;
-        throw std::runtime_error(ERR);
-    }
-
-    // Load the tree
-    TTree* tree = new TTree();
-    mc_tfile->GetObject(TTREE.c_str(), tree);
-    if (!tree || tree->IsZombie()) {
-        const std::string ERR = "Could not open the TTree " + TTREE;
-        throw std::runtime_error(ERR);
-    }
-
-    return tree;
-}
-
 double GetOverallNormalization(const std::string NAME) {
     const double DATA_LUMI = 19712;
     const std::map<std::string, double> NORM = {
@@ -71,36 +72,133 @@ double GetOverallNormalization(const std::string NAME) {
     return WEIGHT;
 }
 
-double GetWeight(
-        const int& WEIGHT_SIZE,
-        const double WEIGHTS[],
-        const int WEIGHTIDS[]
+std::vector<std::vector<double> > RunForked(
+        const int N_JOBS,
+        const size_t N_TASKS,
+        std::function<std::vector<double>(const size_t)> task
         ) {
-    double weight = 1.;
-
-    // Loop over the weights and use it if it is one of correct
-    for (int i = 0; i < WEIGHT_SIZE; ++i) {
-        switch (WEIGHTIDS[i]) {
-            case zf::WeightID::GEN_MC:
-            case zf::WeightID::PILEUP:
-            case zf::WeightID::VETO:
-            case zf::WeightID::LOOSE:
-            case zf::WeightID::MEDIUM:
-            case zf::WeightID::TIGHT:
-            case zf::WeightID::SINGLE_TRIG:
-            case zf::WeightID::DOUBLE_TRIG:
-            case zf::WeightID::GSF_RECO:
-                weight *= WEIGHTS[i];
-                break;
-            default:
+    /*
+     * RooFit and ROOT I/O are not thread safe, so the work is split between
+     * forked processes, each with its own copy of ROOT's global state. Task
+     * i runs in job i % N_JOBS, which sends back its task number, the size
+     * of the result, and the result through a pipe. The results are returned
+     * by task number, so the output does not depend on the order the jobs
+     * finish in.
+     */
+    std::vector<std::vector<double> > results(N_TASKS);
+    std::cout.flush();  // Otherwise every job would print it again
+    std::vector<pid_t> pids;
+    std::vector<int> pipes;
+    for (int i_job = 0; i_job < N_JOBS && static_cast<size_t>(i_job) < N_TASKS; ++i_job) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            throw std::runtime_error("pipe failed");
+        }
+        const pid_t PID = fork();
+        if (PID < 0) {
+            throw std::runtime_error("fork failed");
+        }
+        if (PID == 0) {
+            close(fds[0]);
+            FILE* out = fdopen(fds[1], "w");
+            int status = EXIT_SUCCESS;
+            try {
+                for (size_t i_task = i_job; i_task < N_TASKS; i_task += N_JOBS) {
+                    const std::vector<double> RESULT = task(i_task);
+                    const size_t SIZE = RESULT.size();
+                    fwrite(&i_task, sizeof(i_task), 1, out);
+                    fwrite(&SIZE, sizeof(SIZE), 1, out);
+                    fwrite(&RESULT[0], sizeof(double), SIZE, out);
+                }
+            }
+            catch (std::runtime_error& error) {
+                std::cout << error.what() << std::endl;
+                status = EXIT_FAILURE;
+            }
+            fclose(out);
+            _exit(status);
+        }
+        close(fds[1]);
+        pids.push_back(PID);
+        pipes.push_back(fds[0]);
+    }
+
+    // Read all the pipes at once as data arrives, so no job stalls on a full
+    // pipe while another is being read, and parse them at the end
+    std::vector<std::vector<char> > received(pipes.size());
+    std::vector<pollfd> polled;
+    for (auto& i_pipe : pipes) {
+        pollfd fd;
+        fd.fd = i_pipe;
+        fd.events = POLLIN;
+        fd.revents = 0;
+        polled.push_back(fd);
+    }
+    size_t n_open = pipes.size();
+    char buffer[65536];
+    while (n_open > 0) {
+        if (poll(&polled[0], polled.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("poll failed");
+        }
+        for (size_t i_pipe = 0; i_pipe < polled.size(); ++i_pipe) {
+            if (polled[i_pipe].fd < 0 || polled[i_pipe].revents == 0) {
+                continue;
+            }
+            const ssize_t N_READ = read(polled[i_pipe].fd, buffer, sizeof(buffer));
+            if (N_READ > 0) {
+                received[i_pipe].insert(received[i_pipe].end(), buffer, buffer + N_READ);
+            }
+            else if (N_READ == 0 || errno != EINTR) {
+                close(polled[i_pipe].fd);
+                polled[i_pipe].fd = -1;  // Ignored by poll
+                --n_open;
+            }
+        }
+    }
+    size_t n_results = 0;
+    for (auto& i_data : received) {
+        size_t position = 0;
+        size_t i_task = 0;
+        size_t size = 0;
+        while (position + sizeof(i_task) + sizeof(size) <= i_data.size()) {
+            memcpy(&i_task, &i_data[position], sizeof(i_task));
+            memcpy(&size, &i_data[position + sizeof(i_task)], sizeof(size));
+            position += sizeof(i_task) + sizeof(size);
+            if (i_task >= N_TASKS || position + size * sizeof(double) > i_data.size()) {
                 break;
+            }
+            results[i_task].resize(size);
+            if (size > 0) {
+                memcpy(&results[i_task][0], &i_data[position], size * sizeof(double));
+            }
+            position += size * sizeof(double);
+            ++n_results;
         }
     }
+    bool failed = false;
+    for (auto& i_pid : pids) {
+        int status = 0;
+        waitpid(i_pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+            failed = true;
+        }
+    }
+    if (failed || n_results != N_TASKS) {
+        throw std::runtime_error("A job failed.");
+    }
+    return results;
+}
 
-    return weight;
+TH2D* MakePhistarMassHisto() {
+    TH2D* histo = new TH2D("phistar_and_mass", "Phistar Vs. Mass;#phi*;m_{ee}", zf::ATLAS_PHISTAR_BINNING.size() - 1, &zf::ATLAS_PHISTAR_BINNING[0], 50, 0, 300);
+    histo->Sumw2();
+    return histo;
 }
 
-histogram_map Get2DHistoMap() {
+histogram_map Get2DHistoMap(const int N_JOBS) {
     // The list of files
     std::map<std::string, std::string> files_to_open = {
         {"Data", "/data/whybee0a/user/gude_2/Data/20150306_SingleElectron_2012ALL_same_sign/20150306_SingleElectron_2012ALL_same_sign.root"},
@@ -118,66 +216,86 @@ histogram_map Get2DHistoMap() {
     const std::string TREE_NAME =
         "ZFinder/Combined Single Reco/Combined Single Reco";
 
-    // Open the files and fill the file map
-    histogram_map output_map;
+    // Fill the histogram of each file in its own job. A job sends back the
+    // sum of weights and sum of squared weights of every cell, and the
+    // number of entries.
+    std::vector<std::string> data_types;
+    std::vector<std::string> file_names;
     for (auto iter : files_to_open) {
-        std::string data_type = iter.first;
-        std::string file_name = iter.second;
-        bool is_real_data = false;
-        if (data_type == "Data") {
-            is_real_data = true;
-        }
+        data_types.push_back(iter.first);
+        file_names.push_back(iter.second);
+    }
+    auto fill = [&](const size_t I) -> std::vector<double> {
+        const std::string& DATA_TYPE = data_types[I];
+        const bool IS_REAL_DATA = (DATA_TYPE == "Data");
 
         // Open the file and load the tree
-        TTree* tree = GetTTree(file_name, TREE_NAME);
-
-        TBranch* reco_branch = tree->GetBranch("reco");
-        TLeaf* e0_charge = reco_branch->GetLeaf("e_charge0");
-        TLeaf* e1_charge = reco_branch->GetLeaf("e_charge1");
-        TLeaf* mee = reco_branch->GetLeaf("z_m");
-        TLeaf* phistar = reco_branch->GetLeaf("z_phistar_dressed");
-
-        // We have to grab the first entry to learn how many weights there are
-        int nweights = 0;
-        if (!is_real_data) {
-            tree->SetBranchAddress("weight_size", &nweights);
-            tree->GetEntry(0);
-        }
-        double weights[nweights];
-        int weightid[nweights];
-        if (!is_real_data) {
-            tree->SetBranchAddress("weights", &weights);
-            tree->SetBranchAddress("weight_ids", &weightid);
+        TTree* tree = GetTTree(file_names[I], TREE_NAME);
+
+        // Works with both the leaf-list and split tree layouts
+        ZDefTreeReader reader(tree);
+        const size_t E0_CHARGE = reader.Column("reco", "e_charge0");
+        const size_t E1_CHARGE = reader.Column("reco", "e_charge1");
+        const size_t MEE = reader.Column("reco", "z_m");
+        const size_t PHISTAR = reader.Column("reco", "z_phistar_dressed");
+        if (!IS_REAL_DATA) {
+            reader.UseWeights();
         }
+        const double NORMALIZATION = IS_REAL_DATA ? 1 : GetOverallNormalization(DATA_TYPE);
 
         // Pack into a hitogram
-        TH2D* histo = new TH2D("phistar_and_mass", "Phistar Vs. Mass;#phi*;m_{ee}", zf::ATLAS_PHISTAR_BINNING.size() - 1, &zf::ATLAS_PHISTAR_BINNING[0], 50, 0, 300);
-        for (int i = 0; i < tree->GetEntries(); i++) {
-            tree->GetEntry(i);
-
-            // Reject opposite sign
-            if (e0_charge->GetValue() * e1_charge->GetValue() < 0) {
-                continue;
-            }
-
-            // We have a bug in our tuples where the charge is often set wrong.
-            // Instead we selected the events from the beinging to be be same
-            // sign, so we run on all of them.
-            double weight = 1;
-            if (!is_real_data) {
-                weight = GetOverallNormalization(data_type);
-                weight *= GetWeight(nweights, weights, weightid);
+        TH2D* histo = MakePhistarMassHisto();
+        const Long64_t BATCH_SIZE = 20000;
+        ZDefTreeReader::batch batch;
+        for (Long64_t i = 0; i < reader.GetEntries(); i += BATCH_SIZE) {
+            reader.ReadBatch(i, BATCH_SIZE, &batch);
+            for (Long64_t row = 0; row < batch.size; ++row) {
+                // Reject opposite sign
+                if (batch.columns[E0_CHARGE][row] * batch.columns[E1_CHARGE][row] < 0) {
+                    continue;
+                }
+
+                // We have a bug in our tuples where the charge is often set wrong.
+                // Instead we selected the events from the beinging to be be same
+                // sign, so we run on all of them.
+                double weight = 1;
+                if (!IS_REAL_DATA) {
+                    weight = NORMALIZATION * batch.weights[row];
+                }
+
+                histo->Fill(batch.columns[PHISTAR][row], batch.columns[MEE][row], weight);
             }
+        }
 
-            const double MEE = mee->GetValue();
-            const double PHISTAR = phistar->GetValue();
-            histo->Fill(PHISTAR, MEE, weight);
+        std::vector<double> cells;
+        const int N_CELLS = histo->GetSize();
+        for (int i = 0; i < N_CELLS; ++i) {
+            cells.push_back(histo->GetBinContent(i));
+        }
+        for (int i = 0; i < N_CELLS; ++i) {
+            cells.push_back(histo->GetBinError(i) * histo->GetBinError(i));
         }
-        histo->Sumw2();
+        cells.push_back(histo->GetEntries());
 
+        delete histo;
         delete tree;
 
-        output_map[data_type] = histo;
+        return cells;
+    };
+    const std::vector<std::vector<double> > CELLS = RunForked(N_JOBS, data_types.size(), fill);
+
+    // Rebuild the histograms
+    histogram_map output_map;
+    for (size_t i_type = 0; i_type < data_types.size(); ++i_type) {
+        const std::vector<double>& CELL = CELLS[i_type];
+        TH2D* histo = MakePhistarMassHisto();
+        const int N_CELLS = histo->GetSize();
+        for (int i = 0; i < N_CELLS; ++i) {
+            histo->SetBinContent(i, CELL[i]);
+            histo->SetBinError(i, sqrt(CELL[N_CELLS + i]));
+        }
+        histo->SetEntries(CELL[2 * N_CELLS]);
+        output_map[data_types[i_type]] = histo;
     }
 
     return output_map;
@@ -211,7 +329,109 @@ TH1D* Get1DFromBin(TH2D* histo, const int BIN, const std::string PREFIX) {
     return out_histo;
 }
 
-std::pair<double, double> FitForQCD(TH1D* data_histo, TH1D* template_histo, const std::string BIN, const std::string PHISTAR_RANGE) {
+std::vector<double> BinContents(TH1D* histo) {
+    std::vector<double> contents;
+    for (int i = 1; i <= histo->GetNbinsX(); ++i) {
+        contents.push_back(histo->GetBinContent(i));
+    }
+    return contents;
+}
+
+std::pair<double, double> FitForQCD(TH1D* data_histo, TH1D* template_histo, const std::string BIN, const std::string PHISTAR_RANGE, const bool MAKE_PLOT) {
+    /*
+     * The same fit as FitForQCDRooFit, done by TemplateFit on the bin
+     * contents. The histograms span the z_mass range of the RooFit version,
+     * 0 to 300 GeV.
+     */
+    std::vector<double> edges;
+    for (int i = 1; i <= data_histo->GetNbinsX() + 1; ++i) {
+        edges.push_back(data_histo->GetBinLowEdge(i));
+    }
+    const TemplateFit FITTER(edges, BinContents(template_histo));
+    const std::vector<double> DATA = BinContents(data_histo);
+    const TemplateFit::result RESULT = FITTER.Fit(DATA);
+    if (!RESULT.converged) {
+        std::cout << "The fit of bin " << BIN << " did not converge" << std::endl;
+    }
+
+    if (MAKE_PLOT) {
+        // Set up the legend using the plot edges to set its location
+        const double RIGHT_EDGE = 0.90;
+        const double TOP_EDGE = 0.92;
+        const double LEG_HEIGHT = 0.20;
+        const double LEG_LENGTH = 0.40;
+        TLegend legend(
+                RIGHT_EDGE - LEG_LENGTH,
+                (TOP_EDGE - 0.025) - LEG_HEIGHT,  // 0.025 offset to avoid ticks
+                RIGHT_EDGE,
+                TOP_EDGE - 0.025  // 0.025 offset to avoid the ticks
+                );
+        legend.SetFillColor(kWhite);
+        legend.SetBorderSize(0);  // Remove drop shadow and border
+        legend.SetFillStyle(0);  // Transparent
+
+        // The components, as expected bin contents
+        double total = 0;
+        for (auto& i_bin : DATA) {
+            total += i_bin;
+        }
+        std::vector<double> signal;
+        std::vector<double> background;
+        FITTER.Expected(RESULT, total, &signal, &background);
+        TH1D* data_plot = dynamic_cast<TH1D*>(data_histo->Clone(("data_plot_" + BIN).c_str()));
+        TH1D* template_plot = dynamic_cast<TH1D*>(data_histo->Clone(("template_plot_" + BIN).c_str()));
+        TH1D* qcd_plot = dynamic_cast<TH1D*>(data_histo->Clone(("qcd_plot_" + BIN).c_str()));
+        TH1D* fit_plot = dynamic_cast<TH1D*>(data_histo->Clone(("fit_plot_" + BIN).c_str()));
+        for (size_t i = 0; i < signal.size(); ++i) {
+            template_plot->SetBinContent(i + 1, signal[i]);
+            qcd_plot->SetBinContent(i + 1, background[i]);
+            fit_plot->SetBinContent(i + 1, signal[i] + background[i]);
+        }
+
+        // Plot
+        TCanvas canvas("canvas", "canvas", 600, 600);
+        canvas.cd();
+        gPad->SetLogy();
+        const std::string TITLE = "QCD Fit: " + PHISTAR_RANGE + ";m_{ee} [GeV];Events";
+        data_plot->SetTitle(TITLE.c_str());
+        data_plot->SetStats(false);
+        data_plot->GetYaxis()->SetTitleOffset(1.25);
+        data_plot->SetMarkerStyle(kFullCircle);
+        data_plot->SetMarkerColor(kBlack);
+        data_plot->SetLineColor(kBlack);
+        template_plot->SetLineColor(kBlack);
+        template_plot->SetLineStyle(kDashed);
+        qcd_plot->SetLineColor(kRed);
+        qcd_plot->SetLineStyle(kDashed);
+        fit_plot->SetLineColor(kBlue);
+        legend.AddEntry(data_plot, "Data", "p");
+        legend.AddEntry(template_plot, "MC Template", "l");
+        legend.AddEntry(qcd_plot, "Analytic Background", "l");
+        legend.AddEntry(fit_plot, "Sum of Fit Components", "l");
+
+        data_plot->Draw("E");
+        template_plot->Draw("HIST SAME");
+        qcd_plot->Draw("HIST SAME");
+        fit_plot->Draw("HIST SAME");
+        data_plot->Draw("E SAME");
+        legend.Draw();
+        const std::string FILE_TYPE = "pdf";
+        const std::string OUT_NAME = "qcd_fit_plot_for_" + BIN + "." + FILE_TYPE;
+        const std::string OUT_NAME_C = "qcd_fit_plot_for_" + BIN + "." + FILE_TYPE + ".C";
+        canvas.Print(OUT_NAME.c_str(), FILE_TYPE.c_str());
+        canvas.Print(OUT_NAME_C.c_str(), "cxx");
+
+        delete data_plot;
+        delete template_plot;
+        delete qcd_plot;
+        delete fit_plot;
+    }
+
+    // The fraction of the background in the Z window
+    return FITTER.BackgroundFraction(RESULT, 60., 120.);
+}
+
+std::pair<double, double> FitForQCDRooFit(TH1D* data_histo, TH1D* template_histo, const std::string BIN, const std::string PHISTAR_RANGE) {
     using namespace RooFit;
     // The X value of the histogram
     RooRealVar z_mass("z_mass", "m_{ee}" , 0, 300, "GeV");
@@ -339,9 +559,37 @@ void MakePhistarPlot(TH1D* histo) {
     }
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // The number of jobs for filling and fitting, and which fit to use:
+    // TemplateFit, RooFit (-roofit), or both, printing the differences
+    // (-compare)
+    int n_jobs = 4;
+    bool use_roofit = false;
+    bool compare = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string ARG = argv[i];
+        if (ARG == "-j" && i + 1 < argc) {
+            n_jobs = std::max(1, atoi(argv[++i]));
+        }
+        else if (ARG == "-roofit") {
+            use_roofit = true;
+        }
+        else if (ARG == "-compare") {
+            compare = true;
+        }
+        else {
+            std::cout << "Usage: same_sign.exe [-j N] [-roofit | -compare]" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    if (use_roofit && compare) {
+        std::cout << "-roofit and -compare can not be used together." << std::endl;
+        std::cout << "Usage: same_sign.exe [-j N] [-roofit | -compare]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
     // Get a map of the histograms of the Z Masses
-    histogram_map histo2d = Get2DHistoMap();
+    histogram_map histo2d = Get2DHistoMap(n_jobs);
 
     // Write and draw the histos
     TH2D* data_histo2d = histo2d["Data"];
@@ -352,7 +600,12 @@ int main() {
     TH1D* qcd_phistar_histo = new TH1D("phistar", "QCD Phistar;#phi*;counts", zf::ATLAS_PHISTAR_BINNING.size() - 1, &zf::ATLAS_PHISTAR_BINNING[0]);
     TH1D* fake_zmass = new TH1D("z_mass_all", "z_mass_all", 60, 60., 120.);
     qcd_phistar_histo->Sumw2();
-    for (unsigned int i = 1; i < zf::ATLAS_PHISTAR_BINNING.size(); ++i) {
+    // Each fit is a task; it makes its plots and sends back the background
+    // integral and its error (and those of RooFit, when comparing)
+    const size_t N_BINS = zf::ATLAS_PHISTAR_BINNING.size() - 1;
+    auto fit = [&](const size_t TASK) -> std::vector<double> {
+        const int i = TASK + 1;
+
         // Get histograms for each phistar bin
         TH1D* data_histo = Get1DFromBin(data_histo2d, i, "data_bin_");
         TH1D* template_histo = Get1DFromBin(template_histo2d, i, "template_bin_");
@@ -371,16 +624,40 @@ int main() {
         // Run the fit and make the plot
         std::ostringstream convert2;
         convert2 << std::setw(2) << std::setfill('0') << i;
-        std::pair<double, double> fit_result = FitForQCD(data_histo, template_histo, convert2.str(), PHISTART_BINNING);
-
-        // Fill the background histogram
-        qcd_phistar_histo->SetBinContent(i, fit_result.first);
-        qcd_phistar_histo->SetBinError(i, fit_result.second);
-        fake_zmass->Fill(91, fit_result.first);
+        std::vector<double> results;
+        if (!use_roofit) {
+            const std::pair<double, double> FIT_RESULT = FitForQCD(data_histo, template_histo, convert2.str(), PHISTART_BINNING, !compare);
+            results.push_back(FIT_RESULT.first);
+            results.push_back(FIT_RESULT.second);
+        }
+        if (use_roofit || compare) {
+            const std::pair<double, double> FIT_RESULT = FitForQCDRooFit(data_histo, template_histo, convert2.str(), PHISTART_BINNING);
+            results.push_back(FIT_RESULT.first);
+            results.push_back(FIT_RESULT.second);
+        }
 
         // Clean up
         delete data_histo;
         delete template_histo;
+
+        return results;
+    };
+    const std::vector<std::vector<double> > FIT_RESULTS = RunForked(n_jobs, N_BINS, fit);
+
+    // Fill the background histogram, in bin order
+    for (size_t i = 1; i <= N_BINS; ++i) {
+        qcd_phistar_histo->SetBinContent(i, FIT_RESULTS[i - 1][0]);
+        qcd_phistar_histo->SetBinError(i, FIT_RESULTS[i - 1][1]);
+        fake_zmass->Fill(91, FIT_RESULTS[i - 1][0]);
+    }
+    if (compare) {
+        std::cout << "Bin: TemplateFit, RooFit, (TemplateFit - RooFit) / RooFit error" << std::endl;
+        for (size_t i = 1; i <= N_BINS; ++i) {
+            const std::vector<double>& RESULT = FIT_RESULTS[i - 1];
+            std::cout << i << ": " << RESULT[0] << " +- " << RESULT[1] << ", ";
+            std::cout << RESULT[2] << " +- " << RESULT[3] << ", ";
+            std::cout << ((RESULT[3] > 0) ? (RESULT[0] - RESULT[2]) / RESULT[3] : 0) << std::endl;
+        }
     }
 
     // Divide by bin width and scale for the fact that we cosider only same
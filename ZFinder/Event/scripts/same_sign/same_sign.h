@@ -2,9 +2,11 @@
 #define SAME_SIGN_H_
 
 // Standard Library
+#include <functional>  // std::function
 #include <string>
 #include <map>
 #include <utility>  // std::pair
+#include <vector>
 
 // ROOT
 #include <TH1D.h>
@@ -13,44 +15,26 @@
 
 typedef std::map<std::string, TH2D*> histogram_map;
 
-struct branch_struct {
-    double z_m;
-    double z_y;
-    double z_phistar_born;
-    double z_phistar_dressed;
-    double z_phistar_naked;
-    double z_phistar_sc;
-    double z_pt;
-    double z_eta;
-    double e_pt[2];
-    double e_eta[2];
-    double e_phi[2];
-    int e_charge[2];
-    unsigned int n_verts;
-};
-
-struct event_branch {
-    unsigned int event_number;
-    bool is_mc;
-};
-
-TTree* GetTTree(const std::string TFILE, const std::string TTREE);
-
-double GetWeight(
-    const int& WEIGHT_SIZE,
-    const double WEIGHTS[],
-    const int WEIGHTIDS[]
-);
-
 double GetOverallNormalization(const std::string NAME);
 
-histogram_map Get2DHistoMap();
+// Runs TASK(i) for every i < N_TASKS in N_JOBS forked processes, and
+// returns the results in order of i
+std::vector<std::vector<double> > RunForked(const int N_JOBS, const size_t N_TASKS, std::function<std::vector<double>(const size_t)> task);
+
+TH2D* MakePhistarMassHisto();
+
+histogram_map Get2DHistoMap(const int N_JOBS);
 
 TH2D* GetTemplate(histogram_map histo_map);
 
 TH1D* Get1DFromBin(TH2D* histo, const int BIN);
 
-std::pair<double, double> FitForQCD(TH1D* data_histo, TH1D* template_histo, const std::string BIN, const std::string PHISTAR_RANGE);
+std::vector<double> BinContents(TH1D* histo);
+
+// Fit for the fraction of the QCD background in the Z mass window, with
+// TemplateFit or with RooFit
+std::pair<double, double> FitForQCD(TH1D* data_histo, TH1D* template_histo, const std::string BIN, const std::string PHISTAR_RANGE, const bool MAKE_PLOT);
+std::pair<double, double> FitForQCDRooFit(TH1D* data_histo, TH1D* template_histo, const std::string BIN, const std::string PHISTAR_RANGE);
 
 void MakePhistarPlot(TH1D* histo);
 
@@ -0,0 +1,406 @@
+// Standard Library
+#include <algorithm>  // std::max, std::min
+#include <cmath>  // sqrt
+#include <cstdlib>  // atoi, atof
+#include <functional>  // std::cref
+#include <iostream>
+#include <stdexcept>  // std::runtime_error
+#include <string>
+#include <thread>  // std::thread
+#include <vector>
+
+// ROOT
+#include <TFile.h>
+#include <TH1D.h>
+#include <TH2D.h>
+
+// ZFinder
+#include "../../interface/WeightID.h"  // WeightID
+#include "../zdef_tree/tuple_binning.h"  // tuple_axis, ParseBinning, FindBin
+#include "../zdef_tree/tuple_expression.h"  // TupleExpression
+#include "../zdef_tree/zdef_tree_reader.h"  // ZDefTreeReader, ExpandFileLists
+
+/*
+ * Fill a distribution and all of its weight variations in one pass, and
+ * reduce the PDF variations to uncertainty envelopes.
+ *
+ * Usage:
+ *
+ *     systematics.exe [options] output.root input.root [input.root ...]
+ *
+ * Options:
+ *
+ *     -t TREE        the tree (default "ZFinder/Combined Single Reco/Combined Single Reco")
+ *     -x EXPRESSION  the variable (default "reco.z_phistar_dressed")
+ *     -b BINS        its bins, as in fill_histograms (default "atlas_phistar")
+ *     -s EXPRESSION  a selection
+ *     -n NUMBER      a normalization applied to every weight
+ *     -j N           the number of filling threads (default 4)
+ *
+ * An input starting with "@" is a text file with one input file per line.
+ *
+ * Every entry is weighted by GetWeight (times the normalization). The
+ * variations are: pileup up and down (the PILEUP weight replaced by
+ * PILEUP_PLUS or PILEUP_MINUS), FSR (times weight_fsr), and each member of
+ * the cteq, mstw, and nnpdf PDF sets present in the tree (times the member's
+ * weight over member 0's). For each entry, one bin gets the nominal weight
+ * and every variation at once: the sums are a [bin][variation] array, so
+ * the variations of the bin are contiguous and the loops over the PDF
+ * members are vectorized. Each thread has its own array and they are added
+ * at the end.
+ *
+ * The output has the histograms "nominal", "pileup_up", "pileup_down", and
+ * "fsr", and for each PDF set "<set>_members" (a TH2D of the bins against
+ * the member number), and "<set>_central", "<set>_up", and "<set>_down".
+ * cteq and mstw are Hessian sets: the central value is member 0, and the
+ * envelope is the asymmetric sum in quadrature over the eigenvector pairs
+ * (1, 2), (3, 4), .... nnpdf is a set of replicas: the central value is the
+ * mean of members 1 to N, and the envelope is one standard deviation.
+ */
+
+namespace {
+    enum pdf_mode {
+        HESSIAN,
+        REPLICA
+    };
+
+    struct pdf_set_info {
+        std::string name;
+        pdf_mode mode;
+        size_t n_members;
+        size_t offset;  // Of member 0 in the variations
+    };
+
+    // The fixed variations, followed by the PDF members
+    enum variation {
+        NOMINAL = 0,
+        PILEUP_UP = 1,
+        PILEUP_DOWN = 2,
+        FSR = 3,
+        N_FIXED_VARIATIONS = 4
+    };
+
+    struct context {
+        const TupleExpression* x;
+        const TupleExpression* selection;
+        tuple_axis axis;
+        double normalization;
+        bool has_fsr;
+        size_t fsr_column;
+        std::vector<pdf_set_info> pdf_sets;
+        size_t n_variations;
+    };
+
+    // One thread's sums; sum_weight[bin * n_variations + variation]
+    struct accumulator {
+        std::vector<double> sum_weight;
+        std::vector<double> sum_weight2;  // Of the nominal weight only
+        Long64_t entries;
+    };
+
+    /*
+     * Adds SCALE * MEMBERS[i] to OUT[i]. Kept apart, with restrict pointers,
+     * so the compiler knows the arrays do not overlap and vectorizes it.
+     */
+    void AddScaled(double* __restrict__ out, const double* __restrict__ MEMBERS, const size_t N, const double SCALE) {
+        for (size_t i = 0; i < N; ++i) {
+            out[i] += SCALE * MEMBERS[i];
+        }
+    }
+
+    void AddConstant(double* __restrict__ out, const size_t N, const double VALUE) {
+        for (size_t i = 0; i < N; ++i) {
+            out[i] += VALUE;
+        }
+    }
+
+    void FillRows(
+            const context& CTX,
+            const ZDefTreeReader::batch& BATCH,
+            const size_t FIRST,
+            const size_t LAST,
+            accumulator* acc
+            ) {
+        // Look the PDF blocks up once per batch, not per entry
+        std::vector<const ZDefTreeReader::pdf_block*> blocks;
+        for (auto& i_set : CTX.pdf_sets) {
+            blocks.push_back(&BATCH.pdf.find(i_set.name)->second);
+        }
+
+        for (size_t row = FIRST; row < LAST; ++row) {
+            if (CTX.selection != nullptr && CTX.selection->Evaluate(BATCH, row) == 0) {
+                continue;
+            }
+            const double WEIGHT = CTX.normalization * BATCH.weights[row];
+            const size_t BIN = FindBin(CTX.axis, CTX.x->Evaluate(BATCH, row));
+            double* sums = &acc->sum_weight[BIN * CTX.n_variations];
+            acc->sum_weight2[BIN] += WEIGHT * WEIGHT;
+            ++acc->entries;
+
+            // Pileup, by replacing the nominal pileup weight
+            double pileup = 0;
+            double pileup_plus = 0;
+            double pileup_minus = 0;
+            for (size_t i = BATCH.weight_offsets[row]; i < BATCH.weight_offsets[row + 1]; ++i) {
+                switch (BATCH.weight_ids[i]) {
+                    case zf::WeightID::PILEUP:
+                        pileup = BATCH.weight_values[i];
+                        break;
+                    case zf::WeightID::PILEUP_PLUS:
+                        pileup_plus = BATCH.weight_values[i];
+                        break;
+                    case zf::WeightID::PILEUP_MINUS:
+                        pileup_minus = BATCH.weight_values[i];
+                        break;
+                    default:
+                        break;
+                }
+            }
+            sums[NOMINAL] += WEIGHT;
+            sums[PILEUP_UP] += (pileup != 0) ? WEIGHT * pileup_plus / pileup : WEIGHT;
+            sums[PILEUP_DOWN] += (pileup != 0) ? WEIGHT * pileup_minus / pileup : WEIGHT;
+            sums[FSR] += CTX.has_fsr ? WEIGHT * BATCH.columns[CTX.fsr_column][row] : WEIGHT;
+
+            // The PDF members, as ratios to member 0. Members missing from
+            // an entry, or all of them if member 0 is 0, get the nominal
+            // weight.
+            for (size_t i_set = 0; i_set < CTX.pdf_sets.size(); ++i_set) {
+                const pdf_set_info& SET = CTX.pdf_sets[i_set];
+                const ZDefTreeReader::pdf_block& BLOCK = *blocks[i_set];
+                const double* MEMBERS = BLOCK.weights.data() + BLOCK.offsets[row];
+                size_t n = std::min(BLOCK.offsets[row + 1] - BLOCK.offsets[row], SET.n_members);
+                if (n > 0 && MEMBERS[0] != 0) {
+                    AddScaled(sums + SET.offset, MEMBERS, n, WEIGHT / MEMBERS[0]);
+                }
+                else {
+                    n = 0;
+                }
+                AddConstant(sums + SET.offset + n, SET.n_members - n, WEIGHT);
+            }
+        }
+    }
+
+    // A histogram of the variation V of SUMS
+    TH1D* MakeHistogram(
+            const std::string& NAME,
+            const tuple_axis& AXIS,
+            const std::vector<double>& SUMS,
+            const size_t N_VARIATIONS,
+            const size_t V
+            ) {
+        TH1D* histo = new TH1D(NAME.c_str(), NAME.c_str(), AXIS.NBins(), &AXIS.edges[0]);
+        histo->Sumw2();
+        for (size_t bin = 0; bin < AXIS.NBins() + 2; ++bin) {
+            histo->SetBinContent(bin, SUMS[bin * N_VARIATIONS + V]);
+        }
+        return histo;
+    }
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string tree_name = "ZFinder/Combined Single Reco/Combined Single Reco";
+    std::string x_expression = "reco.z_phistar_dressed";
+    std::string bins = "atlas_phistar";
+    std::string selection;
+    double normalization = 1;
+    int n_threads = 4;
+    int arg = 1;
+    while (arg + 1 < argc && argv[arg][0] == '-') {
+        const std::string OPTION = argv[arg];
+        const std::string VALUE = argv[arg + 1];
+        if (OPTION == "-t") {
+            tree_name = VALUE;
+        }
+        else if (OPTION == "-x") {
+            x_expression = VALUE;
+        }
+        else if (OPTION == "-b") {
+            bins = VALUE;
+        }
+        else if (OPTION == "-s") {
+            selection = VALUE;
+        }
+        else if (OPTION == "-n") {
+            normalization = atof(VALUE.c_str());
+        }
+        else if (OPTION == "-j") {
+            n_threads = atoi(VALUE.c_str());
+        }
+        else {
+            std::cout << "Unknown option " << OPTION << std::endl;
+            return EXIT_FAILURE;
+        }
+        arg += 2;
+    }
+    if (argc - arg < 2 || n_threads < 1) {
+        std::cout << "Not enough arguments." << std::endl;
+        std::cout << "Usage: systematics.exe [-t TREE] [-x EXPRESSION] [-b BINS] [-s SELECTION] [-n NORMALIZATION] [-j N] output.root input.root [input.root ...]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::string OUTPUT_FILE = argv[arg];
+    const std::vector<std::string> INPUTS = ExpandFileLists(std::vector<std::string>(argv + arg + 1, argv + argc));
+
+    // Request everything we read from the reader
+    ZDefTreeReader reader(INPUTS, tree_name);
+    context ctx;
+    ctx.axis = ParseBinning(bins);
+    ctx.x = new TupleExpression(x_expression, &reader);
+    ctx.selection = selection.empty() ? nullptr : new TupleExpression(selection, &reader);
+    ctx.normalization = normalization;
+    reader.UseWeights();
+    ctx.has_fsr = (reader.GetTree()->GetBranch("weight_fsr") != nullptr);
+    if (ctx.has_fsr) {
+        ctx.fsr_column = reader.Column("weight_fsr", "weight_fsr");
+    }
+    const std::string SETS[] = {"cteq", "mstw", "nnpdf"};
+    const pdf_mode MODES[] = {HESSIAN, HESSIAN, REPLICA};
+    for (size_t i = 0; i < 3; ++i) {
+        const std::string SIZE = "weight_" + SETS[i] + "_size";
+        if (reader.GetTree()->GetBranch(SIZE.c_str()) != nullptr) {
+            reader.UsePDFWeights(SETS[i]);
+            pdf_set_info set;
+            set.name = SETS[i];
+            set.mode = MODES[i];
+            set.n_members = 0;
+            set.offset = 0;
+            ctx.pdf_sets.push_back(set);
+        }
+    }
+
+    // The number of members of each set is the most of any entry in the
+    // tree
+    ctx.n_variations = N_FIXED_VARIATIONS;
+    for (auto& i_set : ctx.pdf_sets) {
+        const std::string SIZE = "weight_" + i_set.name + "_size";
+        i_set.n_members = static_cast<size_t>(std::max(0., reader.GetTree()->GetMaximum(SIZE.c_str())));
+        i_set.offset = ctx.n_variations;
+        ctx.n_variations += i_set.n_members;
+        std::cout << i_set.name << ": " << i_set.n_members << " members" << std::endl;
+    }
+
+    const Long64_t BATCH_SIZE = 20000;
+    ZDefTreeReader::batch batches[2];
+    int current = 0;
+    Long64_t first = 0;
+    reader.ReadBatch(first, BATCH_SIZE, &batches[current]);
+
+    const size_t N_CELLS = ctx.axis.NBins() + 2;
+    std::vector<accumulator> accumulators(n_threads);
+    for (auto& i_acc : accumulators) {
+        i_acc.sum_weight.assign(N_CELLS * ctx.n_variations, 0.);
+        i_acc.sum_weight2.assign(N_CELLS, 0.);
+        i_acc.entries = 0;
+    }
+
+    // Fill one batch while the next one is read
+    while (batches[current].size > 0) {
+        const ZDefTreeReader::batch& BATCH = batches[current];
+        const size_t SIZE = BATCH.size;
+        std::vector<std::thread> workers;
+        for (int i = 0; i < n_threads; ++i) {
+            const size_t BEGIN = SIZE * i / n_threads;
+            const size_t END = SIZE * (i + 1) / n_threads;
+            workers.push_back(std::thread(FillRows, std::cref(ctx), std::cref(BATCH), BEGIN, END, &accumulators[i]));
+        }
+
+        first += BATCH.size;
+        reader.ReadBatch(first, BATCH_SIZE, &batches[1 - current]);
+
+        for (auto& i_worker : workers) {
+            i_worker.join();
+        }
+        current = 1 - current;
+    }
+    std::cout << "Read " << first << " entries" << std::endl;
+
+    // Add up the threads
+    std::vector<double> sums(N_CELLS * ctx.n_variations, 0.);
+    std::vector<double> sum_weight2(N_CELLS, 0.);
+    Long64_t entries = 0;
+    for (auto& i_acc : accumulators) {
+        for (size_t i = 0; i < sums.size(); ++i) {
+            sums[i] += i_acc.sum_weight[i];
+        }
+        for (size_t i = 0; i < N_CELLS; ++i) {
+            sum_weight2[i] += i_acc.sum_weight2[i];
+        }
+        entries += i_acc.entries;
+    }
+
+    TFile output(OUTPUT_FILE.c_str(), "RECREATE");
+    output.cd();
+    TH1D* nominal = MakeHistogram("nominal", ctx.axis, sums, ctx.n_variations, NOMINAL);
+    for (size_t bin = 0; bin < N_CELLS; ++bin) {
+        nominal->SetBinError(bin, sqrt(sum_weight2[bin]));
+    }
+    nominal->SetEntries(entries);
+    MakeHistogram("pileup_up", ctx.axis, sums, ctx.n_variations, PILEUP_UP);
+    MakeHistogram("pileup_down", ctx.axis, sums, ctx.n_variations, PILEUP_DOWN);
+    MakeHistogram("fsr", ctx.axis, sums, ctx.n_variations, FSR);
+
+    for (auto& i_set : ctx.pdf_sets) {
+        const size_t N = i_set.n_members;
+        if (N == 0) {
+            continue;
+        }
+        const std::string NAME = i_set.name;
+        TH2D* members = new TH2D((NAME + "_members").c_str(), (NAME + "_members").c_str(), ctx.axis.NBins(), &ctx.axis.edges[0], N, -0.5, N - 0.5);
+        TH1D* central = MakeHistogram(NAME + "_central", ctx.axis, sums, ctx.n_variations, i_set.offset);
+        TH1D* up = MakeHistogram(NAME + "_up", ctx.axis, sums, ctx.n_variations, i_set.offset);
+        TH1D* down = MakeHistogram(NAME + "_down", ctx.axis, sums, ctx.n_variations, i_set.offset);
+
+        std::cout << NAME << " relative uncertainty per bin (down, up):" << std::endl;
+        for (size_t bin = 0; bin < N_CELLS; ++bin) {
+            const double* X = &sums[bin * ctx.n_variations + i_set.offset];
+            for (size_t i = 0; i < N; ++i) {
+                members->SetBinContent(bin, i + 1, X[i]);
+            }
+
+            double center = X[0];
+            double err_up = 0;
+            double err_down = 0;
+            if (i_set.mode == HESSIAN) {
+                // Each pair moves the value up and down by at most its larger
+                // shift in that direction
+                for (size_t i = 1; i + 1 < N; i += 2) {
+                    const double UP = std::max(std::max(X[i] - center, X[i + 1] - center), 0.);
+                    const double DOWN = std::max(std::max(center - X[i], center - X[i + 1]), 0.);
+                    err_up += UP * UP;
+                    err_down += DOWN * DOWN;
+                }
+                err_up = sqrt(err_up);
+                err_down = sqrt(err_down);
+            }
+            else if (N > 2) {
+                double mean = 0;
+                for (size_t i = 1; i < N; ++i) {
+                    mean += X[i];
+                }
+                mean /= (N - 1);
+                double variance = 0;
+                for (size_t i = 1; i < N; ++i) {
+                    variance += (X[i] - mean) * (X[i] - mean);
+                }
+                variance /= (N - 2);
+                center = mean;
+                err_up = sqrt(variance);
+                err_down = err_up;
+            }
+            central->SetBinContent(bin, center);
+            up->SetBinContent(bin, center + err_up);
+            down->SetBinContent(bin, center - err_down);
+            if (bin > 0 && bin <= ctx.axis.NBins() && center != 0) {
+                std::cout << "    [" << ctx.axis.edges[bin - 1] << ", " << ctx.axis.edges[bin] << "): ";
+                std::cout << -err_down / center << ", " << err_up / center << std::endl;
+            }
+        }
+    }
+
+    output.Write();
+    output.Close();
+
+    delete ctx.x;
+    delete ctx.selection;
+
+    return EXIT_SUCCESS;
+}
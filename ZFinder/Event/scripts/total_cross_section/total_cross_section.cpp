@@ -1,12 +1,60 @@
 // Standard Library
+#include <algorithm>  // std::max
+#include <cmath>
 #include <iostream>
 #include <string>
 
 // ROOT
 #include <TFile.h>
-#include <TH1D.h>
+#include <TTree.h>
 
 
+struct cutflow_count {
+    std::string name;
+    double count;  // Sum of the full weights
+    double error2;  // Sum of the squared full weights
+};
+
+bool ReadCutflow(TFile* tfile, const std::string& ZDEF_DIR, cutflow_count* result) {
+    /*
+     * Read the last cut level of the cutflow table written by
+     * ZDefinitionWriter. Merged files have one set of rows per job, so the
+     * rows of that level are summed.
+     */
+    TTree* tree;
+    tfile->GetObject((ZDEF_DIR + "/cutflow").c_str(), tree);
+    if (!tree) {
+        return false;
+    }
+    int level;
+    char name[256];
+    double sum_full_weight;
+    double sum_full_weight2;
+    tree->SetBranchAddress("level", &level);
+    tree->SetBranchAddress("name", name);
+    tree->SetBranchAddress("sum_full_weight", &sum_full_weight);
+    tree->SetBranchAddress("sum_full_weight2", &sum_full_weight2);
+
+    int last_level = -1;
+    for (Long64_t i = 0; i < tree->GetEntries(); ++i) {
+        tree->GetEntry(i);
+        if (level > last_level) {
+            last_level = level;
+        }
+    }
+    result->count = 0;
+    result->error2 = 0;
+    for (Long64_t i = 0; i < tree->GetEntries(); ++i) {
+        tree->GetEntry(i);
+        if (level == last_level) {
+            result->name = name;
+            result->count += sum_full_weight;
+            result->error2 += sum_full_weight2;
+        }
+    }
+    return last_level >= 0;
+}
+
 int main() {
     // Input Files
     const std::string MC_FILE =
@@ -14,19 +62,17 @@ int main() {
     const std::string DATA_FILE =
         "/data/whybee0a/user/gude_2/Data/20140210_SingleElectron_2012ALL/hadded.root";
 
-    // Histograms
-    // The Histogram containing the full event count with no acceptance or
+    // ZDefinitions, whose cutflow tables are read at the last cut level,
+    // the mass window
+    // The ZDefinition containing the full event count with no acceptance or
     // efficiency limits.
-    const std::string MC_HISTO_ALL =
-        "ZFinder/0 Gen Mass Only MC/0 All Events/z_mass_all";
-    // The Histogram containing MC events, but with the full analysis cuts
-    // applied. This is used in a ratio with MC_HISTO_ALL to correct for
+    const std::string MC_ZDEF_ALL = "ZFinder/0 Gen Mass Only MC";
+    // The ZDefinition containing MC events, but with the full analysis cuts
+    // applied. This is used in a ratio with MC_ZDEF_ALL to correct for
     // efficiency and acceptance.
-    const std::string MC_HISTO_ACC =
-        "ZFinder/3 Single Trigger Cuts Reco/7 60 < M_{ee} < 120/z_mass_all";
+    const std::string MC_ZDEF_ACC = "ZFinder/3 Single Trigger Cuts Reco";
     // The data after all cuts.
-    const std::string DATA_HISTO =
-        "ZFinder/Combined Single Reco/7 60 < M_{ee} < 120/z_mass_all";
+    const std::string DATA_ZDEF = "ZFinder/Combined Single Reco";
 
     // From src/Metadata/lumi_json/total_luminosity.md
     // These should be in 1/fb.
@@ -40,10 +86,6 @@ int main() {
     // you're using.
     const double LUMI = TOTAL_LUMI;
 
-    // Mass range
-    const double MASS_LOW = 60.;
-    const double MASS_HIGH = 120.;
-
     // Open the TFiles
     TFile* mc_tfile = new TFile(MC_FILE.c_str());
     if (!mc_tfile) {
@@ -56,48 +98,51 @@ int main() {
         return EXIT_FAILURE;
     }
 
-    // Load the histograms
-    TH1D* mc_histo_all;
-    mc_tfile->GetObject(MC_HISTO_ALL.c_str(), mc_histo_all);
-    if (!mc_histo_all) {
-        std::cout << "Failed to load MC_HISTO_ALL" << std::endl;
+    // Load the event counts
+    cutflow_count mc_all;
+    if (!ReadCutflow(mc_tfile, MC_ZDEF_ALL, &mc_all)) {
+        std::cout << "Failed to load the cutflow of MC_ZDEF_ALL" << std::endl;
         return EXIT_FAILURE;
     }
-    TH1D* mc_histo_acc;
-    mc_tfile->GetObject(MC_HISTO_ACC.c_str(), mc_histo_acc);
-    if (!mc_histo_acc) {
-        std::cout << "Failed to load MC_HISTO_ACC" << std::endl;
+    cutflow_count mc_acc;
+    if (!ReadCutflow(mc_tfile, MC_ZDEF_ACC, &mc_acc)) {
+        std::cout << "Failed to load the cutflow of MC_ZDEF_ACC" << std::endl;
         return EXIT_FAILURE;
     }
-    TH1D* data_histo;
-    data_tfile->GetObject(DATA_HISTO.c_str(), data_histo);
-    if (!data_histo) {
-        std::cout << "Failed to load DATA_HISTO" << std::endl;
+    cutflow_count data;
+    if (!ReadCutflow(data_tfile, DATA_ZDEF, &data)) {
+        std::cout << "Failed to load the cutflow of DATA_ZDEF" << std::endl;
         return EXIT_FAILURE;
     }
+    const double DATA_COUNT = data.count;
+    const double MC_COUNT_ALL = mc_all.count;
+    const double MC_COUNT_ACC = mc_acc.count;
 
-    // Integrate the histograms to get event counts
-    const int DATA_LOW = data_histo->FindBin(MASS_LOW);
-    const int DATA_HIGH = data_histo->FindBin(MASS_HIGH);
-    const double DATA_COUNT = data_histo->Integral(DATA_LOW, DATA_HIGH);
-
-    const int MC_ALL_LOW = mc_histo_all->FindBin(MASS_LOW);
-    const int MC_ALL_HIGH = mc_histo_all->FindBin(MASS_HIGH);
-    const double MC_COUNT_ALL = mc_histo_all->Integral(MC_ALL_LOW, MC_ALL_HIGH);
-
-    const int MC_ACC_LOW = mc_histo_acc->FindBin(MASS_LOW);
-    const int MC_ACC_HIGH = mc_histo_acc->FindBin(MASS_HIGH);
-    const double MC_COUNT_ACC = mc_histo_acc->Integral(MC_ACC_LOW, MC_ACC_HIGH);
-
-    // Calculate the final number
+    // Calculate the final number, with the statistical error from the
+    // sums of squared weights. The accepted MC events are a subset of all
+    // of them, so their ratio has the binomial error of a weighted
+    // efficiency,
+    //     var(eff) = ((1 - 2 eff) sum_acc(w^2) + eff^2 sum_all(w^2)) / sum_all(w)^2,
+    // which treats the weights of an event in both ZDefinitions as equal.
     const double CROSS_SECTION = (MC_COUNT_ALL / MC_COUNT_ACC)
                                  * (DATA_COUNT / LUMI);
+    const double EFFICIENCY = MC_COUNT_ACC / MC_COUNT_ALL;
+    const double EFFICIENCY_VARIANCE = std::max(0.,
+            ((1 - 2 * EFFICIENCY) * mc_acc.error2 + EFFICIENCY * EFFICIENCY * mc_all.error2)
+            / (MC_COUNT_ALL * MC_COUNT_ALL)
+            );
+    const double RELATIVE_ERROR = sqrt(
+            EFFICIENCY_VARIANCE / (EFFICIENCY * EFFICIENCY)
+            + data.error2 / (DATA_COUNT * DATA_COUNT)
+            );
 
     // Report, and exit
     //std::cout << "Correction factor: " << MC_COUNT_ALL / MC_COUNT_ACC << std::endl;
+    std::cout << "Levels: " << mc_all.name << ", " << mc_acc.name << ", " << data.name << std::endl;
     std::cout << "(" << MC_COUNT_ALL << " / " << MC_COUNT_ACC << ") * (";
     std::cout << DATA_COUNT << " / " << LUMI << " fb^(-1) ) = ";
-    std::cout << CROSS_SECTION / 1e6 << " nanobarns" << std::endl;
+    std::cout << CROSS_SECTION / 1e6 << " +- " << CROSS_SECTION * RELATIVE_ERROR / 1e6;
+    std::cout << " (stat.) nanobarns" << std::endl;
 
     return EXIT_SUCCESS;
 }
@@ -4,33 +4,12 @@
 
 // ROOT
 #include <TTree.h>
-#include <TFile.h>
-#include <TBranch.h>
 
+// ZFinder
+#include "../zdef_tree/zdef_tree_reader.h"  // ZDefTreeReader, GetTTree
 
-int main() {
-    //Structure outlining the branch
-    struct branch_struct {
-        double z_m;
-        double z_y;
-        double z_phistar_born;
-        double z_phistar_dressed;
-        double z_phistar_naked;
-        double z_phistar_sc;
-        double z_pt;
-        double z_eta;
-        double e_pt[2];
-        double e_eta[2];
-        double e_phi[2];
-        int e_charge[2];
-        unsigned int n_verts;
-    } truth_branch;
-
-    struct event_branch {
-        unsigned int event_number;
-        bool is_mc;
-    } event_branch;
 
+int main() {
     // Input Files
     const std::string MC_FILE =
         "/data/whybee0a/user/gude_2/MC/20150211_MC_CTEQ6LL/MadGraph_hadded.root";
@@ -39,24 +18,24 @@ int main() {
     const std::string TREE_NAME =
         "ZFinder/Combined Gen Cuts Reco/Combined Gen Cuts Reco";
 
-    // Open the TFiles
-    TFile* mc_tfile = new TFile(MC_FILE.c_str(), "READ");
-    if (!mc_tfile) {
-        std::cout << "Failed to read TFile: " << MC_FILE << std::endl;
-        return EXIT_FAILURE;
-    }
-
     // Load the tree
-    TTree* tree;
-    mc_tfile->GetObject(TREE_NAME.c_str(), tree);
-    if (!tree) {
-        std::cout << "Failed to load the tree: " << TREE_NAME << std::endl;
-        return EXIT_FAILURE;
-    }
+    TTree* tree = GetTTree(MC_FILE, TREE_NAME);
 
-    // Get the branch
-    tree->SetBranchAddress("truth", &truth_branch);
-    tree->SetBranchAddress("event_info", &event_branch);
+    // Get the variables; this works with both the leaf-list and split
+    // tree layouts
+    ZDefTreeReader reader(tree);
+    const double& event_number = reader.Variable("event_info", "event_number");
+    const double& e_pt0 = reader.Variable("truth", "e_pt0");
+    const double& e_eta0 = reader.Variable("truth", "e_eta0");
+    const double& e_phi0 = reader.Variable("truth", "e_phi0");
+    const double& e_charge0 = reader.Variable("truth", "e_charge0");
+    const double& e_pt1 = reader.Variable("truth", "e_pt1");
+    const double& e_eta1 = reader.Variable("truth", "e_eta1");
+    const double& e_phi1 = reader.Variable("truth", "e_phi1");
+    const double& e_charge1 = reader.Variable("truth", "e_charge1");
+    const double& z_m = reader.Variable("truth", "z_m");
+    const double& z_y = reader.Variable("truth", "z_y");
+    const double& z_phistar_dressed = reader.Variable("truth", "z_phistar_dressed");
 
     // Text file
     std::cout << "#event_number" << ", ";
@@ -72,21 +51,21 @@ int main() {
     std::cout << "z_y" << ", ";
     std::cout << "z_phistar_dressed";
     std::cout << std::endl;
-    for (int i = 0; i < tree->GetEntries(); i++) {
-        tree->GetEntry(i);
+    for (int i = 0; i < reader.GetEntries(); i++) {
+        reader.GetEntry(i);
         // Make the text file
-        std::cout << event_branch.event_number << ", ";
-        std::cout << truth_branch.e_pt[0] << ", ";
-        std::cout << truth_branch.e_eta[0] << ", ";
-        std::cout << truth_branch.e_phi[0] << ", ";
-        std::cout << truth_branch.e_charge[0] << ", ";
-        std::cout << truth_branch.e_pt[1] << ", ";
-        std::cout << truth_branch.e_eta[1] << ", ";
-        std::cout << truth_branch.e_phi[1] << ", ";
-        std::cout << truth_branch.e_charge[1] << ", ";
-        std::cout << truth_branch.z_m << ", ";
-        std::cout << truth_branch.z_y << ", ";
-        std::cout << truth_branch.z_phistar_dressed;
+        std::cout << static_cast<unsigned int>(event_number) << ", ";
+        std::cout << e_pt0 << ", ";
+        std::cout << e_eta0 << ", ";
+        std::cout << e_phi0 << ", ";
+        std::cout << e_charge0 << ", ";
+        std::cout << e_pt1 << ", ";
+        std::cout << e_eta1 << ", ";
+        std::cout << e_phi1 << ", ";
+        std::cout << e_charge1 << ", ";
+        std::cout << z_m << ", ";
+        std::cout << z_y << ", ";
+        std::cout << z_phistar_dressed;
         std::cout << std::endl;
     }
 
@@ -0,0 +1,240 @@
+#include "event_index.h"
+
+// Standard Library
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+// ROOT
+#include <TDirectory.h>
+
+// ZFinder
+#include "zdef_tree_reader.h"  // ZDefTreeReader
+
+namespace {
+    // Orderings of records, with and without the lumi section
+    bool LessRunLumiEvent(const EventIndex::record& A, const EventIndex::record& B) {
+        if (A.run != B.run) {
+            return A.run < B.run;
+        }
+        if (A.lumi != B.lumi) {
+            return A.lumi < B.lumi;
+        }
+        return A.event < B.event;
+    }
+
+    bool LessRunEvent(const EventIndex::record& A, const EventIndex::record& B) {
+        if (A.run != B.run) {
+            return A.run < B.run;
+        }
+        return A.event < B.event;
+    }
+
+    bool LessRun(const EventIndex::record& A, const EventIndex::record& B) {
+        return A.run < B.run;
+    }
+
+    // Keeps the entry as a tie breaker so that sorting is reproducible
+    bool LessRunLumiEventEntry(const EventIndex::record& A, const EventIndex::record& B) {
+        if (LessRunLumiEvent(A, B) || LessRunLumiEvent(B, A)) {
+            return LessRunLumiEvent(A, B);
+        }
+        return A.entry < B.entry;
+    }
+}
+
+EventIndex::EventIndex(TTree* tree) : has_lumi_(false) {
+    TTree* index_tree = nullptr;
+    if (tree->GetDirectory() != nullptr) {
+        tree->GetDirectory()->GetObject("event_index", index_tree);
+    }
+    if (index_tree == nullptr || !ReadIndexTree(index_tree, tree->GetEntries())) {
+        BuildFromTree(tree);
+    }
+}
+
+bool EventIndex::ReadIndexTree(TTree* index_tree, const Long64_t N_ENTRIES) {
+    /*
+     * Each job writes its records sorted, with index_size set to the number
+     * of records it wrote. After hadd the blocks of each job follow each
+     * other, in the same order as the entries of the ZDefinition tree, so
+     * the entry offset of a block is the sum of the sizes of the blocks
+     * before it.
+     */
+    record rec;
+    Long64_t index_size = 0;
+    index_tree->SetBranchAddress("run_number", &rec.run);
+    index_tree->SetBranchAddress("lumi_number", &rec.lumi);
+    index_tree->SetBranchAddress("event_number", &rec.event);
+    index_tree->SetBranchAddress("entry", &rec.entry);
+    index_tree->SetBranchAddress("index_size", &index_size);
+
+    const Long64_t N_RECORDS = index_tree->GetEntries();
+    records_.clear();
+    records_.reserve(N_RECORDS);
+    Long64_t offset = 0;
+    Long64_t block_end = 0;
+    for (Long64_t i = 0; i < N_RECORDS; ++i) {
+        index_tree->GetEntry(i);
+        if (i == block_end) {
+            offset = block_end;
+            block_end += index_size;
+        }
+        rec.entry += offset;
+        records_.push_back(rec);
+    }
+    index_tree->ResetBranchAddresses();
+
+    if (N_RECORDS != N_ENTRIES || block_end != N_ENTRIES) {
+        std::cout << "The event_index tree does not match its tree, rebuilding it." << std::endl;
+        records_.clear();
+        return false;
+    }
+    std::sort(records_.begin(), records_.end(), LessRunLumiEventEntry);
+    has_lumi_ = true;
+    return true;
+}
+
+void EventIndex::BuildFromTree(TTree* tree) {
+    ZDefTreeReader reader(tree);
+    const double& run = reader.Variable("event_info", "run_number");
+    const double& event = reader.Variable("event_info", "event_number");
+
+    records_.clear();
+    records_.reserve(reader.GetEntries());
+    for (Long64_t i = 0; i < reader.GetEntries(); ++i) {
+        reader.GetEntry(i);
+        record rec;
+        rec.run = static_cast<unsigned int>(run);
+        rec.lumi = 0;
+        rec.event = static_cast<unsigned int>(event);
+        rec.entry = i;
+        records_.push_back(rec);
+    }
+    std::sort(records_.begin(), records_.end(), LessRunLumiEventEntry);
+    has_lumi_ = false;
+}
+
+Long64_t EventIndex::Find(const unsigned int RUN, const unsigned int LUMI, const unsigned int EVENT) const {
+    record key;
+    key.run = RUN;
+    key.lumi = has_lumi_ ? LUMI : 0;
+    key.event = EVENT;
+    const_iterator it = std::lower_bound(records_.begin(), records_.end(), key, LessRunLumiEvent);
+    if (it == records_.end() || LessRunLumiEvent(key, *it)) {
+        return -1;
+    }
+    return it->entry;
+}
+
+Long64_t EventIndex::Find(const unsigned int RUN, const unsigned int EVENT) const {
+    if (!has_lumi_) {
+        return Find(RUN, 0, EVENT);
+    }
+    const std::pair<const_iterator, const_iterator> RANGE = Run(RUN);
+    for (const_iterator it = RANGE.first; it != RANGE.second; ++it) {
+        if (it->event == EVENT) {
+            return it->entry;
+        }
+    }
+    return -1;
+}
+
+std::pair<EventIndex::const_iterator, EventIndex::const_iterator> EventIndex::Run(const unsigned int RUN) const {
+    record key;
+    key.run = RUN;
+    return std::equal_range(records_.begin(), records_.end(), key, LessRun);
+}
+
+std::vector<EventIndex::record> EventIndex::SortedByRunEvent() const {
+    std::vector<record> sorted(records_);
+    std::stable_sort(sorted.begin(), sorted.end(), LessRunEvent);
+    return sorted;
+}
+
+template<class Operation>
+std::vector<EventIndex::record> EventIndex::SetOperation(const EventIndex& OTHER, Operation operation) const {
+    std::vector<record> output;
+    if (has_lumi_ && OTHER.has_lumi_) {
+        operation(
+                records_.begin(), records_.end(),
+                OTHER.records_.begin(), OTHER.records_.end(),
+                std::back_inserter(output), LessRunLumiEvent
+                );
+    }
+    else {
+        const std::vector<record> THIS_SORTED = SortedByRunEvent();
+        const std::vector<record> OTHER_SORTED = OTHER.SortedByRunEvent();
+        operation(
+                THIS_SORTED.begin(), THIS_SORTED.end(),
+                OTHER_SORTED.begin(), OTHER_SORTED.end(),
+                std::back_inserter(output), LessRunEvent
+                );
+    }
+    return output;
+}
+
+std::vector<EventIndex::record> EventIndex::Intersection(const EventIndex& OTHER) const {
+    typedef bool (*compare)(const record&, const record&);
+    return SetOperation(
+            OTHER,
+            std::set_intersection<const_iterator, const_iterator, std::back_insert_iterator<std::vector<record> >, compare>
+            );
+}
+
+std::vector<EventIndex::record> EventIndex::Difference(const EventIndex& OTHER) const {
+    typedef bool (*compare)(const record&, const record&);
+    return SetOperation(
+            OTHER,
+            std::set_difference<const_iterator, const_iterator, std::back_insert_iterator<std::vector<record> >, compare>
+            );
+}
+
+std::vector<std::pair<Long64_t, Long64_t> > EventIndex::Match(const EventIndex& OTHER) const {
+    // Without lumi numbers on both sides the records are resorted by run
+    // and event
+    const bool USE_LUMI = has_lumi_ && OTHER.has_lumi_;
+    std::vector<record> this_resorted;
+    std::vector<record> other_resorted;
+    if (!USE_LUMI) {
+        this_resorted = SortedByRunEvent();
+        other_resorted = OTHER.SortedByRunEvent();
+    }
+    const std::vector<record>& THIS_SORTED = USE_LUMI ? records_ : this_resorted;
+    const std::vector<record>& OTHER_SORTED = USE_LUMI ? OTHER.records_ : other_resorted;
+    bool (*less)(const record&, const record&) = USE_LUMI ? LessRunLumiEvent : LessRunEvent;
+
+    std::vector<std::pair<Long64_t, Long64_t> > output;
+    const_iterator it = THIS_SORTED.begin();
+    const_iterator other = OTHER_SORTED.begin();
+    while (it != THIS_SORTED.end() && other != OTHER_SORTED.end()) {
+        if (less(*it, *other)) {
+            ++it;
+        }
+        else if (less(*other, *it)) {
+            ++other;
+        }
+        else {
+            output.push_back(std::make_pair(it->entry, other->entry));
+            ++it;
+            ++other;
+        }
+    }
+    return output;
+}
+
+std::vector<EventIndex::record> EventIndex::Duplicates() const {
+    std::vector<record> output;
+    const_iterator it = records_.begin();
+    while (it != records_.end()) {
+        const_iterator next = it + 1;
+        while (next != records_.end() && !LessRunLumiEvent(*it, *next)) {
+            ++next;
+        }
+        if (next - it > 1) {
+            output.insert(output.end(), it, next);
+        }
+        it = next;
+    }
+    return output;
+}
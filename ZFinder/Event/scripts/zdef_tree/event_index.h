@@ -0,0 +1,82 @@
+#ifndef EVENT_INDEX_H_
+#define EVENT_INDEX_H_
+
+// Standard Library
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// ROOT
+#include <TTree.h>
+
+/*
+ * A sorted (run, lumi, event) -> entry index of a ZDefinition tree, for
+ * O(log n) lookups, scans over a run, and set operations between
+ * ZDefinitions.
+ *
+ * The index is read from the "event_index" tree that ZFinder writes next to
+ * the ZDefinition tree with tree_event_index = True, including after the
+ * output of several jobs has been combined with hadd. If there is no such
+ * tree, the index is built by reading "event_info" from the ZDefinition
+ * tree; those trees do not store the lumi section, so HasLumi() is false and
+ * every lumi is 0.
+ */
+class EventIndex {
+    public:
+        struct record {
+            unsigned int run;
+            unsigned int lumi;
+            unsigned int event;
+            Long64_t entry;
+        };
+        typedef std::vector<record>::const_iterator const_iterator;
+
+        explicit EventIndex(TTree* tree);
+
+        // The entry of an event, or -1 if it is not in the tree. If the event
+        // appears more than once, the first entry is returned. Without lumi
+        // numbers LUMI is ignored.
+        Long64_t Find(const unsigned int RUN, const unsigned int LUMI, const unsigned int EVENT) const;
+
+        // Same, for tools that do not know the lumi section. Only O(log n)
+        // if HasLumi() is false, otherwise the run is scanned.
+        Long64_t Find(const unsigned int RUN, const unsigned int EVENT) const;
+
+        // All events of a run, sorted by lumi and event
+        std::pair<const_iterator, const_iterator> Run(const unsigned int RUN) const;
+
+        // The events of this index that are, or are not, in OTHER. If either
+        // index does not have lumi numbers, events are compared by run and
+        // event number only. The entries are those of this index.
+        std::vector<record> Intersection(const EventIndex& OTHER) const;
+        std::vector<record> Difference(const EventIndex& OTHER) const;
+
+        // The (entry in this tree, entry in OTHER) pairs of the events in
+        // both, found with one merge over the two sorted indexes. Events
+        // that appear several times are paired in order, as in Intersection.
+        std::vector<std::pair<Long64_t, Long64_t> > Match(const EventIndex& OTHER) const;
+
+        // Every record whose run, lumi, and event appear more than once
+        std::vector<record> Duplicates() const;
+
+        const std::vector<record>& Records() const { return records_; }
+        const_iterator begin() const { return records_.begin(); }
+        const_iterator end() const { return records_.end(); }
+        size_t size() const { return records_.size(); }
+        bool HasLumi() const { return has_lumi_; }
+
+    protected:
+        std::vector<record> records_;
+        bool has_lumi_;
+
+        bool ReadIndexTree(TTree* index_tree, const Long64_t N_ENTRIES);
+        void BuildFromTree(TTree* tree);
+
+        // The records sorted by (run, event), used when lumi is not
+        // compared
+        std::vector<record> SortedByRunEvent() const;
+        template<class Operation>
+        std::vector<record> SetOperation(const EventIndex& OTHER, Operation operation) const;
+};
+
+#endif  // EVENT_INDEX_H_
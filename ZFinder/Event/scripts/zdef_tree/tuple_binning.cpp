@@ -0,0 +1,65 @@
+// Interface
+#include "tuple_binning.h"
+
+// Standard Library
+#include <algorithm>  // std::upper_bound, std::min
+#include <cstdlib>  // atoi
+#include <sstream>  // std::istringstream
+#include <stdexcept>  // std::runtime_error
+
+// ZFinder
+#include "../../interface/ATLASBins.h"  // ATLAS_PHISTAR_BINNING
+
+
+tuple_axis ParseBinning(const std::string& TEXT) {
+    std::istringstream words(TEXT);
+    std::string first;
+    words >> first;
+    tuple_axis axis;
+    axis.uniform = false;
+    if (first == "atlas_phistar") {
+        axis.edges = zf::ATLAS_PHISTAR_BINNING;
+    }
+    else if (first == "edges") {
+        double edge;
+        while (words >> edge) {
+            if (!axis.edges.empty() && edge <= axis.edges.back()) {
+                throw std::runtime_error("Bin edges must increase: " + TEXT);
+            }
+            axis.edges.push_back(edge);
+        }
+    }
+    else {
+        const int N_BINS = atoi(first.c_str());
+        double low;
+        double high;
+        if (N_BINS <= 0 || !(words >> low >> high) || high <= low) {
+            throw std::runtime_error("Bins must be \"N LOW HIGH\", \"edges E0 E1 ...\", or \"atlas_phistar\": " + TEXT);
+        }
+        axis.uniform = true;
+        for (int i = 0; i <= N_BINS; ++i) {
+            axis.edges.push_back(low + (high - low) * i / N_BINS);
+        }
+    }
+    if (axis.edges.size() < 2) {
+        throw std::runtime_error("An axis needs at least one bin: " + TEXT);
+    }
+    return axis;
+}
+
+size_t FindBin(const tuple_axis& AXIS, const double X) {
+    const std::vector<double>& EDGES = AXIS.edges;
+    const size_t N_BINS = AXIS.NBins();
+    // NaN goes to the overflow, as in TAxis::FindBin
+    if (X < EDGES.front()) {
+        return 0;
+    }
+    if (!(X < EDGES.back())) {
+        return N_BINS + 1;
+    }
+    if (AXIS.uniform) {
+        const size_t BIN = 1 + static_cast<size_t>(N_BINS * (X - EDGES.front()) / (EDGES.back() - EDGES.front()));
+        return std::min(BIN, N_BINS);
+    }
+    return std::upper_bound(EDGES.begin(), EDGES.end(), X) - EDGES.begin();
+}
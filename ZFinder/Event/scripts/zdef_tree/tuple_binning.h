@@ -0,0 +1,25 @@
+#ifndef TUPLE_BINNING_H_
+#define TUPLE_BINNING_H_
+
+// Standard Library
+#include <string>
+#include <vector>
+
+/*
+ * The bins of a histogram axis, parsed from "N LOW HIGH", "edges E0 E1 ...",
+ * or "atlas_phistar" (zf::ATLAS_PHISTAR_BINNING).
+ */
+struct tuple_axis {
+    std::vector<double> edges;
+    bool uniform;
+
+    size_t NBins() const { return edges.size() - 1; }
+};
+
+// Throws std::runtime_error if TEXT is not one of the forms above
+tuple_axis ParseBinning(const std::string& TEXT);
+
+// The ROOT bin number of X: 0 is the underflow, NBins() + 1 the overflow
+size_t FindBin(const tuple_axis& AXIS, const double X);
+
+#endif  // TUPLE_BINNING_H_
@@ -0,0 +1,325 @@
+// Interface
+#include "tuple_expression.h"
+
+// Standard Library
+#include <algorithm>  // std::min, std::max
+#include <cctype>  // isalpha, isalnum, isdigit, isspace
+#include <cmath>  // fabs, sqrt, exp, log, sin, cos
+#include <cstdlib>  // strtod
+#include <sstream>  // std::ostringstream
+#include <stdexcept>  // std::runtime_error
+
+
+struct TupleExpression::parser {
+    std::string text;
+    size_t pos;
+    ZDefTreeReader* reader;
+
+    void SkipSpace() {
+        while (pos < text.size() && isspace(text[pos])) {
+            ++pos;
+        }
+    }
+
+    // Consumes TOKEN if it is next
+    bool Accept(const std::string& TOKEN) {
+        SkipSpace();
+        if (text.compare(pos, TOKEN.size(), TOKEN) == 0) {
+            pos += TOKEN.size();
+            return true;
+        }
+        return false;
+    }
+
+    void Expect(const std::string& TOKEN) {
+        if (!Accept(TOKEN)) {
+            Fail("expected \"" + TOKEN + "\"");
+        }
+    }
+
+    void Fail(const std::string& WHAT) const {
+        std::ostringstream err;
+        err << "Could not parse the expression \"" << text << "\" at character " << pos << ": " << WHAT;
+        throw std::runtime_error(err.str());
+    }
+};
+
+TupleExpression::TupleExpression(const std::string& TEXT, ZDefTreeReader* reader) :
+    text_(TEXT)
+{
+    parser p;
+    p.text = TEXT;
+    p.pos = 0;
+    p.reader = reader;
+    ParseOr(&p);
+    p.SkipSpace();
+    if (p.pos != p.text.size()) {
+        p.Fail("unexpected text");
+    }
+    CheckDepth();
+}
+
+void TupleExpression::Append(const op_code CODE, const double CONSTANT, const size_t COLUMN) {
+    operation op;
+    op.code = CODE;
+    op.constant = CONSTANT;
+    op.column = COLUMN;
+    operations_.push_back(op);
+}
+
+void TupleExpression::ParseOr(parser* p) {
+    ParseAnd(p);
+    while (p->Accept("||")) {
+        ParseAnd(p);
+        Append(OP_OR);
+    }
+}
+
+void TupleExpression::ParseAnd(parser* p) {
+    ParseComparison(p);
+    while (p->Accept("&&")) {
+        ParseComparison(p);
+        Append(OP_AND);
+    }
+}
+
+void TupleExpression::ParseComparison(parser* p) {
+    ParseSum(p);
+    // The two character operators must be tried first
+    op_code code;
+    if (p->Accept("<=")) {
+        code = OP_LESS_EQUAL;
+    }
+    else if (p->Accept(">=")) {
+        code = OP_GREATER_EQUAL;
+    }
+    else if (p->Accept("==")) {
+        code = OP_EQUAL;
+    }
+    else if (p->Accept("!=")) {
+        code = OP_NOT_EQUAL;
+    }
+    else if (p->Accept("<")) {
+        code = OP_LESS;
+    }
+    else if (p->Accept(">")) {
+        code = OP_GREATER;
+    }
+    else {
+        return;
+    }
+    ParseSum(p);
+    Append(code);
+}
+
+void TupleExpression::ParseSum(parser* p) {
+    ParseProduct(p);
+    while (true) {
+        if (p->Accept("+")) {
+            ParseProduct(p);
+            Append(OP_ADD);
+        }
+        else if (p->Accept("-")) {
+            ParseProduct(p);
+            Append(OP_SUBTRACT);
+        }
+        else {
+            return;
+        }
+    }
+}
+
+void TupleExpression::ParseProduct(parser* p) {
+    ParseUnary(p);
+    while (true) {
+        if (p->Accept("*")) {
+            ParseUnary(p);
+            Append(OP_MULTIPLY);
+        }
+        else if (p->Accept("/")) {
+            ParseUnary(p);
+            Append(OP_DIVIDE);
+        }
+        else {
+            return;
+        }
+    }
+}
+
+void TupleExpression::ParseUnary(parser* p) {
+    if (p->Accept("-")) {
+        ParseUnary(p);
+        Append(OP_NEGATE);
+    }
+    // "!=" is not possible here, as it would need something before it
+    else if (p->Accept("!")) {
+        ParseUnary(p);
+        Append(OP_NOT);
+    }
+    else {
+        ParsePrimary(p);
+    }
+}
+
+void TupleExpression::ParsePrimary(parser* p) {
+    p->SkipSpace();
+    if (p->pos >= p->text.size()) {
+        p->Fail("unexpected end");
+    }
+
+    // Parentheses
+    if (p->Accept("(")) {
+        ParseOr(p);
+        p->Expect(")");
+        return;
+    }
+
+    // Numbers
+    const char FIRST = p->text[p->pos];
+    if (isdigit(FIRST) || FIRST == '.') {
+        const char* START = p->text.c_str() + p->pos;
+        char* end = nullptr;
+        const double VALUE = strtod(START, &end);
+        p->pos += end - START;
+        Append(OP_CONSTANT, VALUE);
+        return;
+    }
+
+    // Functions and variables
+    if (!isalpha(FIRST) && FIRST != '_') {
+        p->Fail("unexpected character");
+    }
+    const size_t START = p->pos;
+    while (p->pos < p->text.size() && (isalnum(p->text[p->pos]) || p->text[p->pos] == '_')) {
+        ++p->pos;
+    }
+    const std::string NAME = p->text.substr(START, p->pos - START);
+
+    if (p->Accept("(")) {
+        static const char* const ONE_ARGUMENT[] = {"abs", "sqrt", "exp", "log", "sin", "cos"};
+        static const op_code ONE_ARGUMENT_CODE[] = {OP_ABS, OP_SQRT, OP_EXP, OP_LOG, OP_SIN, OP_COS};
+        for (size_t i = 0; i < 6; ++i) {
+            if (NAME == ONE_ARGUMENT[i]) {
+                ParseOr(p);
+                p->Expect(")");
+                Append(ONE_ARGUMENT_CODE[i]);
+                return;
+            }
+        }
+        if (NAME == "min" || NAME == "max") {
+            ParseOr(p);
+            p->Expect(",");
+            ParseOr(p);
+            p->Expect(")");
+            Append(NAME == "min" ? OP_MIN : OP_MAX);
+            return;
+        }
+        p->Fail("unknown function " + NAME);
+    }
+
+    p->Expect(".");
+    p->SkipSpace();
+    const size_t LEAF_START = p->pos;
+    while (p->pos < p->text.size() && (isalnum(p->text[p->pos]) || p->text[p->pos] == '_')) {
+        ++p->pos;
+    }
+    if (p->pos == LEAF_START) {
+        p->Fail("expected a variable name after " + NAME + ".");
+    }
+    const std::string LEAF = p->text.substr(LEAF_START, p->pos - LEAF_START);
+    Append(OP_COLUMN, 0, p->reader->Column(NAME, LEAF));
+}
+
+void TupleExpression::CheckDepth() const {
+    // Constants and columns push a value, binary operators pop one, and
+    // unary operators leave the depth unchanged
+    int depth = 0;
+    int max_depth = 0;
+    for (auto& i_op : operations_) {
+        switch (i_op.code) {
+            case OP_CONSTANT:
+            case OP_COLUMN:
+                ++depth;
+                break;
+            case OP_NEGATE:
+            case OP_NOT:
+            case OP_ABS:
+            case OP_SQRT:
+            case OP_EXP:
+            case OP_LOG:
+            case OP_SIN:
+            case OP_COS:
+                break;
+            default:
+                --depth;
+                break;
+        }
+        max_depth = std::max(max_depth, depth);
+    }
+    if (max_depth > MAX_DEPTH) {
+        throw std::runtime_error("The expression \"" + text_ + "\" is nested too deeply");
+    }
+}
+
+double TupleExpression::Evaluate(const ZDefTreeReader::batch& BATCH, const size_t ROW) const {
+    double stack[MAX_DEPTH];
+    int top = -1;
+    for (auto& i_op : operations_) {
+        switch (i_op.code) {
+            case OP_CONSTANT:
+                stack[++top] = i_op.constant;
+                break;
+            case OP_COLUMN:
+                stack[++top] = BATCH.columns[i_op.column][ROW];
+                break;
+            case OP_NEGATE:
+                stack[top] = -stack[top];
+                break;
+            case OP_NOT:
+                stack[top] = (stack[top] == 0) ? 1 : 0;
+                break;
+            case OP_ABS:
+                stack[top] = fabs(stack[top]);
+                break;
+            case OP_SQRT:
+                stack[top] = sqrt(stack[top]);
+                break;
+            case OP_EXP:
+                stack[top] = exp(stack[top]);
+                break;
+            case OP_LOG:
+                stack[top] = log(stack[top]);
+                break;
+            case OP_SIN:
+                stack[top] = sin(stack[top]);
+                break;
+            case OP_COS:
+                stack[top] = cos(stack[top]);
+                break;
+            default: {
+                // Binary operators; the left operand is below the right one
+                const double RIGHT = stack[top--];
+                double& left = stack[top];
+                switch (i_op.code) {
+                    case OP_ADD: left = left + RIGHT; break;
+                    case OP_SUBTRACT: left = left - RIGHT; break;
+                    case OP_MULTIPLY: left = left * RIGHT; break;
+                    case OP_DIVIDE: left = left / RIGHT; break;
+                    case OP_LESS: left = (left < RIGHT) ? 1 : 0; break;
+                    case OP_LESS_EQUAL: left = (left <= RIGHT) ? 1 : 0; break;
+                    case OP_GREATER: left = (left > RIGHT) ? 1 : 0; break;
+                    case OP_GREATER_EQUAL: left = (left >= RIGHT) ? 1 : 0; break;
+                    case OP_EQUAL: left = (left == RIGHT) ? 1 : 0; break;
+                    case OP_NOT_EQUAL: left = (left != RIGHT) ? 1 : 0; break;
+                    case OP_AND: left = (left != 0 && RIGHT != 0) ? 1 : 0; break;
+                    case OP_OR: left = (left != 0 || RIGHT != 0) ? 1 : 0; break;
+                    case OP_MIN: left = std::min(left, RIGHT); break;
+                    case OP_MAX: left = std::max(left, RIGHT); break;
+                    default: break;
+                }
+                break;
+            }
+        }
+    }
+    return stack[0];
+}
@@ -0,0 +1,88 @@
+#ifndef TUPLE_EXPRESSION_H_
+#define TUPLE_EXPRESSION_H_
+
+// Standard Library
+#include <string>
+#include <vector>
+
+// ZFinder
+#include "zdef_tree_reader.h"  // ZDefTreeReader
+
+/*
+ * An arithmetic expression of the variables of a ZDefinition tree, for
+ * example "reco.z_m > 60 && abs(reco.e_eta0) < 2.1" or "reco.z_pt /
+ * reco.z_m". Variables are written BRANCH.LEAF with the leaf-list names, as
+ * given to ZDefTreeReader::Variable.
+ *
+ * The expression supports numbers, + - * /, the comparisons < <= > >= ==
+ * !=, && || !, parentheses, and the functions abs, sqrt, exp, log, sin, cos,
+ * min, and max. Comparisons and logical operators give 1 or 0.
+ *
+ * The constructor requests the variables from the reader and compiles the
+ * expression to a list of operations on the columns of a
+ * ZDefTreeReader::batch, so Evaluate does not touch the reader and may be
+ * called from several threads at once.
+ */
+class TupleExpression {
+    public:
+        TupleExpression(const std::string& TEXT, ZDefTreeReader* reader);
+
+        // The value for entry ROW of the batch
+        double Evaluate(const ZDefTreeReader::batch& BATCH, const size_t ROW) const;
+
+        const std::string& Text() const { return text_; }
+
+    protected:
+        enum op_code {
+            OP_CONSTANT,
+            OP_COLUMN,
+            OP_NEGATE,
+            OP_NOT,
+            OP_ADD,
+            OP_SUBTRACT,
+            OP_MULTIPLY,
+            OP_DIVIDE,
+            OP_LESS,
+            OP_LESS_EQUAL,
+            OP_GREATER,
+            OP_GREATER_EQUAL,
+            OP_EQUAL,
+            OP_NOT_EQUAL,
+            OP_AND,
+            OP_OR,
+            OP_ABS,
+            OP_SQRT,
+            OP_EXP,
+            OP_LOG,
+            OP_SIN,
+            OP_COS,
+            OP_MIN,
+            OP_MAX
+        };
+
+        struct operation {
+            op_code code;
+            double constant;
+            size_t column;
+        };
+
+        // Evaluate uses a fixed stack of this depth
+        static const int MAX_DEPTH = 32;
+
+        std::string text_;
+        std::vector<operation> operations_;
+
+        // Recursive descent parser; each level appends its operations
+        struct parser;
+        void ParseOr(parser* p);
+        void ParseAnd(parser* p);
+        void ParseComparison(parser* p);
+        void ParseSum(parser* p);
+        void ParseProduct(parser* p);
+        void ParseUnary(parser* p);
+        void ParsePrimary(parser* p);
+        void Append(const op_code CODE, const double CONSTANT = 0, const size_t COLUMN = 0);
+        void CheckDepth() const;
+};
+
+#endif  // TUPLE_EXPRESSION_H_
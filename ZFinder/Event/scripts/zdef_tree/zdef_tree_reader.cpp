@@ -0,0 +1,545 @@
+// Interface
+#include "zdef_tree_reader.h"
+
+// Standard Library
+#include <algorithm>  // std::find, std::min
+#include <cctype>  // isdigit
+#include <fstream>  // std::ifstream
+#include <stdexcept>  // std::runtime_error
+
+// ROOT
+#include <TFile.h>  // TFile
+#include <TTreeCacheUnzip.h>  // TTreeCacheUnzip::SetParallelUnzip
+
+// ZFinder
+#include "../../interface/WeightCoding.h"  // DecodeWeightRatio
+#include "../../interface/WeightID.h"  // WeightID
+
+
+ZDefTreeReader::ZDefTreeReader(
+        TTree* tree,
+        const Long64_t CACHE_SIZE,
+        const bool PARALLEL_UNZIP
+        ) :
+    weight_size(0),
+    tree_(tree),
+    chain_(nullptr),
+    is_split_(false),
+    is_mc_(false),
+    CACHE_SIZE_(CACHE_SIZE),
+    use_weights_(false),
+    tree_number_(-1)
+{
+    if (!tree_) {
+        throw std::runtime_error("ZDefTreeReader was given a null TTree");
+    }
+    Init(PARALLEL_UNZIP);
+}
+
+ZDefTreeReader::ZDefTreeReader(
+        const std::vector<std::string>& FILES,
+        const std::string& TREE_NAME,
+        const Long64_t CACHE_SIZE,
+        const bool PARALLEL_UNZIP
+        ) :
+    weight_size(0),
+    tree_(nullptr),
+    chain_(nullptr),
+    is_split_(false),
+    is_mc_(false),
+    CACHE_SIZE_(CACHE_SIZE),
+    use_weights_(false),
+    tree_number_(-1)
+{
+    if (FILES.empty()) {
+        throw std::runtime_error("ZDefTreeReader was given no files");
+    }
+    chain_ = new TChain(TREE_NAME.c_str());
+    for (auto& i_file : FILES) {
+        // With 0 entries the file is opened to check that it has the tree
+        if (chain_->Add(i_file.c_str(), 0) == 0) {
+            delete chain_;
+            const std::string ERR = "Could not read the TTree " + TREE_NAME + " from " + i_file;
+            throw std::runtime_error(ERR);
+        }
+    }
+    tree_ = chain_;
+    Init(PARALLEL_UNZIP);
+}
+
+ZDefTreeReader::~ZDefTreeReader() {
+    // Also closes the files of the chain
+    delete chain_;
+}
+
+void ZDefTreeReader::Init(const bool PARALLEL_UNZIP) {
+    // The cache must be made after the unzip mode is set to be a
+    // TTreeCacheUnzip
+    if (PARALLEL_UNZIP) {
+        TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+    }
+    tree_->SetBranchStatus("*", 0);
+    if (CACHE_SIZE_ > 0) {
+        tree_->SetCacheSize(CACHE_SIZE_);
+    }
+
+    // The split layout has no "reco" branch
+    is_split_ = (tree_->GetBranch("reco") == nullptr);
+    if (is_split_) {
+        is_mc_ = (tree_->GetBranch("truth_z_m") != nullptr);
+    }
+    else {
+        is_mc_ = (tree_->GetBranch("truth") != nullptr);
+    }
+}
+
+namespace {
+    /*
+     * The value of element INDEX of a leaf, read straight from its buffer
+     * instead of through the virtual TLeaf::GetValue.
+     */
+    template<typename T>
+    double LeafValue(const TLeaf* LEAF, const int INDEX) {
+        return static_cast<double>(static_cast<const T*>(LEAF->GetValuePointer())[INDEX]);
+    }
+}
+
+const double& ZDefTreeReader::Variable(const std::string& BRANCH, const std::string& LEAF) {
+    const std::string KEY = BRANCH + "." + LEAF;
+    std::map<std::string, variable>::iterator it = variables_.find(KEY);
+    if (it != variables_.end()) {
+        return it->second.value;
+    }
+
+    variable var;
+    var.value = 0;
+    var.index = 0;
+    if (!is_split_) {
+        // The leaf-list layout stores each electron in its own leaf, like
+        // "e_pt0"
+        var.branch_name = BRANCH;
+        var.leaf_name = LEAF;
+    }
+    else {
+        // The split layout stores both electrons in an array, so "e_pt0" is
+        // element 0 of "reco_e_pt". The event_info variables, and top level
+        // branches named after their leaf (like "weight_fsr"), have no
+        // prefix.
+        std::string name = LEAF;
+        if (name.compare(0, 2, "e_") == 0 && isdigit(name[name.size() - 1])) {
+            var.index = name[name.size() - 1] - '0';
+            name.erase(name.size() - 1);
+        }
+        if (BRANCH != "event_info" && BRANCH != LEAF) {
+            name = BRANCH + "_" + name;
+        }
+        var.branch_name = name;
+        var.leaf_name = name;
+    }
+    var.branch = tree_->GetBranch(var.branch_name.c_str());
+    var.leaf = (var.branch != nullptr) ? var.branch->GetLeaf(var.leaf_name.c_str()) : nullptr;
+    if (var.leaf == nullptr) {
+        const std::string ERR = "The TTree " + std::string(tree_->GetName()) + " has no variable " + KEY;
+        throw std::runtime_error(ERR);
+    }
+
+    // The type is the same in every file of a chain
+    const std::string TYPE = var.leaf->GetTypeName();
+    if (TYPE == "Double_t") {
+        var.type = LEAF_DOUBLE;
+    }
+    else if (TYPE == "Float_t") {
+        var.type = LEAF_FLOAT;
+    }
+    else if (TYPE == "Int_t") {
+        var.type = LEAF_INT;
+    }
+    else if (TYPE == "UInt_t") {
+        var.type = LEAF_UINT;
+    }
+    else if (TYPE == "UShort_t") {
+        var.type = LEAF_USHORT;
+    }
+    else if (TYPE == "Bool_t") {
+        var.type = LEAF_BOOL;
+    }
+    else if (TYPE == "Long64_t") {
+        var.type = LEAF_LONG64;
+    }
+    else {
+        const std::string ERR = "The variable " + KEY + " has the unsupported type " + TYPE;
+        throw std::runtime_error(ERR);
+    }
+
+    AddBranch(var.branch_name, true);
+    it = variables_.insert(std::make_pair(KEY, var)).first;
+    columns_.push_back(&it->second);
+    return it->second.value;
+}
+
+size_t ZDefTreeReader::Column(const std::string& BRANCH, const std::string& LEAF) {
+    const double* VALUE = &Variable(BRANCH, LEAF);
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        if (&columns_[i]->value == VALUE) {
+            return i;
+        }
+    }
+    // Not reached, Variable adds every variable to columns_
+    return columns_.size();
+}
+
+void ZDefTreeReader::UseWeights() {
+    if (use_weights_) {
+        return;
+    }
+    if (tree_->GetBranch("weight_size") == nullptr) {
+        throw std::runtime_error("The TTree has no weights");
+    }
+    // weight_size must be read before the arrays that depend on it
+    AddBranch("weight_size", true);
+    AddBranch("weights", true);
+    AddBranch("weight_ids", true);
+    tree_->SetBranchAddress("weight_size", &weight_size);
+    tree_->SetBranchAddress("weights", weights);
+    tree_->SetBranchAddress("weight_ids", weight_ids);
+    use_weights_ = true;
+}
+
+double ZDefTreeReader::Weight() const {
+    return GetWeight(weight_size, weights, weight_ids);
+}
+
+ZDefTreeReader::pdf_set& ZDefTreeReader::GetPDFSet(const std::string& SET) {
+    std::map<std::string, pdf_set>::iterator it = pdf_sets_.find(SET);
+    if (it != pdf_sets_.end()) {
+        return it->second;
+    }
+
+    // The map does not move its values, so the branch addresses stay valid
+    pdf_set& pdf = pdf_sets_[SET];
+    pdf.size = 0;
+    pdf.central = 0;
+    pdf.weights.resize(1);
+    pdf.ratios.resize(1);
+    pdf.size_name = "weight_" + SET + "_size";
+    const std::string RATIO = "weights_" + SET + "_ratio";
+    if (tree_->GetBranch(pdf.size_name.c_str()) == nullptr) {
+        pdf_sets_.erase(SET);
+        const std::string ERR = "The TTree " + std::string(tree_->GetName()) + " has no weight_" + SET + "_size";
+        throw std::runtime_error(ERR);
+    }
+    pdf.compact = (tree_->GetBranch(RATIO.c_str()) != nullptr);
+    if (pdf.compact) {
+        pdf.central_name = "weight_" + SET + "_central";
+        pdf.array_name = RATIO;
+    }
+    else {
+        pdf.array_name = "weights_" + SET;
+    }
+
+    // These are read by ReadPDFEntry, not with the other branches
+    AddBranch(pdf.size_name, false);
+    tree_->SetBranchAddress(pdf.size_name.c_str(), &pdf.size);
+    AddBranch(pdf.array_name, false);
+    if (pdf.compact) {
+        AddBranch(pdf.central_name, false);
+        tree_->SetBranchAddress(pdf.central_name.c_str(), &pdf.central);
+        tree_->SetBranchAddress(pdf.array_name.c_str(), &pdf.ratios[0]);
+    }
+    else {
+        tree_->SetBranchAddress(pdf.array_name.c_str(), &pdf.weights[0]);
+    }
+    pdf.size_branch = nullptr;
+    pdf.central_branch = nullptr;
+    pdf.array_branch = nullptr;
+    return pdf;
+}
+
+void ZDefTreeReader::ReadPDFEntry(pdf_set& pdf, const Long64_t ENTRY) {
+    // The size must be read first so the array is read with the right length
+    pdf.size_branch->GetEntry(ENTRY);
+    if (pdf.size < 0) {
+        throw std::runtime_error("A PDF weight array has a negative size");
+    }
+    const size_t SIZE = pdf.size;
+    if (pdf.compact && pdf.ratios.size() < SIZE) {
+        pdf.ratios.resize(SIZE);
+        tree_->SetBranchAddress(pdf.array_name.c_str(), &pdf.ratios[0]);
+    }
+    else if (!pdf.compact && pdf.weights.size() < SIZE) {
+        pdf.weights.resize(SIZE);
+        tree_->SetBranchAddress(pdf.array_name.c_str(), &pdf.weights[0]);
+    }
+    if (pdf.central_branch != nullptr) {
+        pdf.central_branch->GetEntry(ENTRY);
+    }
+    pdf.array_branch->GetEntry(ENTRY);
+}
+
+void ZDefTreeReader::DecodePDF(const pdf_set& PDF, std::vector<double>* out) const {
+    if (PDF.compact) {
+        for (int i = 0; i < PDF.size; ++i) {
+            out->push_back(zf::DecodeWeightRatio(PDF.ratios[i], PDF.central));
+        }
+    }
+    else {
+        out->insert(out->end(), PDF.weights.begin(), PDF.weights.begin() + PDF.size);
+    }
+}
+
+void ZDefTreeReader::UsePDFWeights(const std::string& SET) {
+    GetPDFSet(SET);
+    if (std::find(used_pdf_sets_.begin(), used_pdf_sets_.end(), SET) == used_pdf_sets_.end()) {
+        used_pdf_sets_.push_back(SET);
+    }
+}
+
+const std::vector<double>& ZDefTreeReader::PDFWeights(const std::string& SET) {
+    return GetPDFSet(SET).decoded;
+}
+
+Long64_t ZDefTreeReader::ReadPDFBlock(
+        const std::string& SET,
+        const Long64_t FIRST,
+        const Long64_t N,
+        pdf_block* block
+        ) {
+    pdf_set& pdf = GetPDFSet(SET);
+
+    const Long64_t LAST = std::min(FIRST + N, tree_->GetEntries());
+    block->offsets.clear();
+    block->weights.clear();
+    block->offsets.push_back(0);
+    for (Long64_t i = FIRST; i < LAST; ++i) {
+        ReadPDFEntry(pdf, LoadEntry(i));
+        DecodePDF(pdf, &block->weights);
+        block->offsets.push_back(block->weights.size());
+    }
+    return (LAST > FIRST) ? LAST - FIRST : 0;
+}
+
+Long64_t ZDefTreeReader::ReadBatch(const Long64_t FIRST, const Long64_t N, batch* out) {
+    const Long64_t LAST = std::min(FIRST + N, tree_->GetEntries());
+    const Long64_t SIZE = (LAST > FIRST) ? LAST - FIRST : 0;
+    out->first = FIRST;
+    out->size = SIZE;
+    out->columns.resize(columns_.size());
+    for (auto& i_column : out->columns) {
+        i_column.clear();
+        i_column.reserve(SIZE);
+    }
+    out->weights.clear();
+    out->weight_offsets.clear();
+    out->weight_values.clear();
+    out->weight_ids.clear();
+    if (use_weights_) {
+        out->weights.reserve(SIZE);
+        out->weight_offsets.reserve(SIZE + 1);
+        out->weight_offsets.push_back(0);
+    }
+    for (auto& i_set : used_pdf_sets_) {
+        pdf_block& block = out->pdf[i_set];
+        block.offsets.clear();
+        block.weights.clear();
+        block.offsets.reserve(SIZE + 1);
+        block.offsets.push_back(0);
+    }
+
+    for (Long64_t i = FIRST; i < LAST; ++i) {
+        GetEntry(i);
+        for (size_t j = 0; j < columns_.size(); ++j) {
+            out->columns[j].push_back(columns_[j]->value);
+        }
+        if (use_weights_) {
+            out->weights.push_back(Weight());
+            out->weight_values.insert(out->weight_values.end(), weights, weights + weight_size);
+            out->weight_ids.insert(out->weight_ids.end(), weight_ids, weight_ids + weight_size);
+            out->weight_offsets.push_back(out->weight_values.size());
+        }
+        for (auto& i_set : used_pdf_sets_) {
+            const std::vector<double>& DECODED = pdf_sets_[i_set].decoded;
+            pdf_block& block = out->pdf[i_set];
+            block.weights.insert(block.weights.end(), DECODED.begin(), DECODED.end());
+            block.offsets.push_back(block.weights.size());
+        }
+    }
+    return SIZE;
+}
+
+void ZDefTreeReader::AddBranch(const std::string& NAME, const bool READ_IN_GETENTRY) {
+    if (std::find(branch_names_.begin(), branch_names_.end(), NAME) == branch_names_.end()) {
+        tree_->SetBranchStatus(NAME.c_str(), 1);
+        branch_names_.push_back(NAME);
+    }
+    if (READ_IN_GETENTRY
+            && std::find(entry_branch_names_.begin(), entry_branch_names_.end(), NAME) == entry_branch_names_.end()) {
+        entry_branch_names_.push_back(NAME);
+    }
+    // Look the branches up again, and add this one to the cache
+    tree_number_ = -1;
+}
+
+TBranch* ZDefTreeReader::FindBranch(const std::string& NAME) const {
+    TTree* current = tree_->GetTree();
+    TBranch* branch = (current != nullptr) ? current->GetBranch(NAME.c_str()) : nullptr;
+    if (branch == nullptr) {
+        const std::string ERR = "The TTree " + std::string(tree_->GetName()) + " has no branch " + NAME + " in one of its files";
+        throw std::runtime_error(ERR);
+    }
+    return branch;
+}
+
+void ZDefTreeReader::Connect() {
+    /*
+     * A TChain replaces its tree, and so all of the branches and leaves, when
+     * it moves to the next file, so the pointers are looked up again from
+     * the names. The branch addresses set on the chain are carried over by
+     * the chain itself.
+     */
+    branches_.clear();
+    for (auto& i_name : entry_branch_names_) {
+        branches_.push_back(FindBranch(i_name));
+    }
+    for (auto& i_pair : variables_) {
+        variable& var = i_pair.second;
+        var.branch = FindBranch(var.branch_name);
+        var.leaf = var.branch->GetLeaf(var.leaf_name.c_str());
+        if (var.leaf == nullptr) {
+            const std::string ERR = "The TTree " + std::string(tree_->GetName()) + " has no variable " + i_pair.first + " in one of its files";
+            throw std::runtime_error(ERR);
+        }
+    }
+    for (auto& i_pair : pdf_sets_) {
+        pdf_set& pdf = i_pair.second;
+        pdf.size_branch = FindBranch(pdf.size_name);
+        pdf.central_branch = pdf.compact ? FindBranch(pdf.central_name) : nullptr;
+        pdf.array_branch = FindBranch(pdf.array_name);
+    }
+
+    // Only the baskets of our branches are prefetched
+    if (CACHE_SIZE_ > 0) {
+        for (auto& i_name : branch_names_) {
+            tree_->AddBranchToCache(i_name.c_str(), true);
+        }
+    }
+
+    tree_number_ = tree_->GetTreeNumber();
+}
+
+Long64_t ZDefTreeReader::LoadEntry(const Long64_t ENTRY) {
+    // Returns the entry number in the tree of the current file
+    const Long64_t LOCAL = tree_->LoadTree(ENTRY);
+    if (LOCAL < 0) {
+        throw std::runtime_error("ZDefTreeReader could not load an entry");
+    }
+    if (tree_number_ != tree_->GetTreeNumber()) {
+        Connect();
+    }
+    return LOCAL;
+}
+
+void ZDefTreeReader::GetEntry(const Long64_t ENTRY) {
+    const Long64_t LOCAL = LoadEntry(ENTRY);
+
+    // Only decompress the branches we need
+    for (auto& i_branch : branches_) {
+        i_branch->GetEntry(LOCAL);
+    }
+    for (auto& i_pair : variables_) {
+        variable& var = i_pair.second;
+        switch (var.type) {
+            case LEAF_DOUBLE:
+                var.value = LeafValue<Double_t>(var.leaf, var.index);
+                break;
+            case LEAF_FLOAT:
+                var.value = LeafValue<Float_t>(var.leaf, var.index);
+                break;
+            case LEAF_INT:
+                var.value = LeafValue<Int_t>(var.leaf, var.index);
+                break;
+            case LEAF_UINT:
+                var.value = LeafValue<UInt_t>(var.leaf, var.index);
+                break;
+            case LEAF_USHORT:
+                var.value = LeafValue<UShort_t>(var.leaf, var.index);
+                break;
+            case LEAF_BOOL:
+                var.value = LeafValue<Bool_t>(var.leaf, var.index);
+                break;
+            case LEAF_LONG64:
+                var.value = LeafValue<Long64_t>(var.leaf, var.index);
+                break;
+        }
+    }
+    for (auto& i_set : used_pdf_sets_) {
+        pdf_set& pdf = pdf_sets_[i_set];
+        ReadPDFEntry(pdf, LOCAL);
+        pdf.decoded.clear();
+        DecodePDF(pdf, &pdf.decoded);
+    }
+}
+
+TTree* GetTTree(const std::string& TFILE, const std::string& TTREE) {
+    // Open the TFile
+    TFile* tfile = new TFile(TFILE.c_str(), "READ");
+    if (!tfile || tfile->IsZombie()) {
+        const std::string ERR = "Could not open the file " + TFILE;
+        throw std::runtime_error(ERR);
+    }
+
+    // Load the tree
+    TTree* tree = nullptr;
+    tfile->GetObject(TTREE.c_str(), tree);
+    if (!tree) {
+        const std::string ERR = "Could not open the TTree " + TTREE;
+        throw std::runtime_error(ERR);
+    }
+
+    return tree;
+}
+
+std::vector<std::string> ExpandFileLists(const std::vector<std::string>& ARGS) {
+    std::vector<std::string> files;
+    for (auto& i_arg : ARGS) {
+        if (i_arg.empty() || i_arg[0] != '@') {
+            files.push_back(i_arg);
+            continue;
+        }
+        std::ifstream list(i_arg.substr(1).c_str());
+        if (!list) {
+            throw std::runtime_error("Failed to read " + i_arg.substr(1));
+        }
+        std::string line;
+        while (std::getline(list, line)) {
+            if (!line.empty() && line[0] != '#') {
+                files.push_back(line);
+            }
+        }
+    }
+    return files;
+}
+
+double GetWeight(const int WEIGHT_SIZE, const double WEIGHTS[], const int WEIGHT_IDS[]) {
+    double weight = 1.;
+
+    // Loop over the weights and use it if it is one of correct
+    for (int i = 0; i < WEIGHT_SIZE; ++i) {
+        switch (WEIGHT_IDS[i]) {
+            case zf::WeightID::GEN_MC:
+            case zf::WeightID::PILEUP:
+            case zf::WeightID::VETO:
+            case zf::WeightID::LOOSE:
+            case zf::WeightID::MEDIUM:
+            case zf::WeightID::TIGHT:
+            case zf::WeightID::SINGLE_TRIG:
+            case zf::WeightID::DOUBLE_TRIG:
+            case zf::WeightID::GSF_RECO:
+                weight *= WEIGHTS[i];
+                break;
+            default:
+                break;
+        }
+    }
+
+    return weight;
+}
@@ -0,0 +1,206 @@
+#ifndef ZDEF_TREE_READER_H_
+#define ZDEF_TREE_READER_H_
+
+// Standard Library
+#include <map>
+#include <string>
+#include <vector>
+
+// ROOT
+#include <TBranch.h>
+#include <TChain.h>
+#include <TLeaf.h>
+#include <TTree.h>
+
+/*
+ * Reads a tree written by ZDefinitionTree with either the leaf-list layout
+ * ("reco", "truth", and "event_info" branches) or the split layout (one
+ * branch per variable). Variables are requested by their leaf-list names,
+ * for example ("reco", "z_pt") or ("event_info", "event_number").
+ *
+ * Every other branch is disabled, and only the branches holding requested
+ * variables are read by GetEntry, through a TTreeCache of CACHE_SIZE bytes
+ * that fetches their baskets in large reads. With PARALLEL_UNZIP the cache
+ * decompresses the baskets in a separate thread, ahead of the loop. The tree
+ * may be a TChain of many files; the reader follows it from file to file.
+ */
+class ZDefTreeReader {
+    public:
+        static const Long64_t DEFAULT_CACHE_SIZE = 30000000;
+
+        explicit ZDefTreeReader(
+            TTree* tree,
+            const Long64_t CACHE_SIZE = DEFAULT_CACHE_SIZE,
+            const bool PARALLEL_UNZIP = true
+        );
+
+        // Reads TREE_NAME from each of the FILES as one TChain, which the
+        // reader owns
+        ZDefTreeReader(
+            const std::vector<std::string>& FILES,
+            const std::string& TREE_NAME,
+            const Long64_t CACHE_SIZE = DEFAULT_CACHE_SIZE,
+            const bool PARALLEL_UNZIP = true
+        );
+
+        ~ZDefTreeReader();
+
+        // Returns a reference to the value of the variable, which is updated
+        // by every call to GetEntry. Throws if the tree has no such variable.
+        const double& Variable(const std::string& BRANCH, const std::string& LEAF);
+
+        // Requests the variable, like Variable, and returns the index of its
+        // column in the batches filled by ReadBatch
+        size_t Column(const std::string& BRANCH, const std::string& LEAF);
+
+        // Also read weight_size, weights, and weight_ids
+        void UseWeights();
+
+        // The product of the standard analysis weights of the current entry;
+        // see GetWeight
+        double Weight() const;
+
+        // Also read the PDF weights of SET ("cteq", "mstw", or "nnpdf"),
+        // decoding them if they were stored as ratios to the central member
+        void UsePDFWeights(const std::string& SET);
+
+        // The PDF weights of SET for the current entry
+        const std::vector<double>& PDFWeights(const std::string& SET);
+
+        // The PDF weights of SET for the entries FIRST to FIRST + N - 1, read
+        // through the cache and decoded in a single pass. The weights of
+        // entry FIRST + i are weights[offsets[i]] up to weights[offsets[i +
+        // 1]]. Returns the number of entries read.
+        struct pdf_block {
+            std::vector<size_t> offsets;
+            std::vector<double> weights;
+        };
+        Long64_t ReadPDFBlock(const std::string& SET, const Long64_t FIRST, const Long64_t N, pdf_block* block);
+
+        // The requested variables of the entries FIRST to FIRST + N - 1, one
+        // column per variable in the order they were requested. The value of
+        // the variable with index COLUMN for entry FIRST + i is
+        // columns[COLUMN][i]. If UseWeights has been called, weights[i] is
+        // Weight() for that entry, and its individual weights and their IDs
+        // are weight_values and weight_ids from weight_offsets[i] up to
+        // weight_offsets[i + 1]. The PDF weights of each set passed to
+        // UsePDFWeights are in pdf[SET], as from ReadPDFBlock. Returns the
+        // number of entries read.
+        struct batch {
+            Long64_t first;
+            Long64_t size;
+            std::vector<std::vector<double> > columns;
+            std::vector<double> weights;
+            std::vector<size_t> weight_offsets;
+            std::vector<double> weight_values;
+            std::vector<int> weight_ids;
+            std::map<std::string, pdf_block> pdf;
+        };
+        Long64_t ReadBatch(const Long64_t FIRST, const Long64_t N, batch* out);
+
+        // Read the requested variables of an entry
+        void GetEntry(const Long64_t ENTRY);
+
+        Long64_t GetEntries() const { return tree_->GetEntries(); }
+        bool IsSplit() const { return is_split_; }
+        bool IsMC() const { return is_mc_; }
+        TTree* GetTree() const { return tree_; }
+
+        // Filled by GetEntry if UseWeights has been called
+        static const int MAX_SIZE = 100;
+        int weight_size;
+        double weights[MAX_SIZE];
+        int weight_ids[MAX_SIZE];
+
+    protected:
+        // The types a leaf of a ZDefinitionTree can have
+        enum leaf_type {
+            LEAF_DOUBLE,
+            LEAF_FLOAT,
+            LEAF_INT,
+            LEAF_UINT,
+            LEAF_USHORT,
+            LEAF_BOOL,
+            LEAF_LONG64
+        };
+
+        struct variable {
+            std::string branch_name;
+            std::string leaf_name;
+            TBranch* branch;
+            TLeaf* leaf;
+            leaf_type type;
+            int index;
+            double value;
+        };
+
+        // The branches and buffers of a PDF set. The buffers grow to the
+        // largest set read, and the array branch is pointed at them again
+        // when they do.
+        struct pdf_set {
+            bool compact;
+            std::string size_name;
+            std::string central_name;
+            std::string array_name;
+            TBranch* size_branch;
+            TBranch* central_branch;
+            TBranch* array_branch;
+            int size;
+            double central;
+            std::vector<double> weights;
+            std::vector<unsigned short> ratios;
+            std::vector<double> decoded;
+        };
+        std::map<std::string, pdf_set> pdf_sets_;
+        std::vector<std::string> used_pdf_sets_;
+
+        pdf_set& GetPDFSet(const std::string& SET);
+        void ReadPDFEntry(pdf_set& pdf, const Long64_t ENTRY);
+        void DecodePDF(const pdf_set& PDF, std::vector<double>* out) const;
+
+        TTree* tree_;
+        TChain* chain_;  // Only set if we own it
+        bool is_split_;
+        bool is_mc_;
+        const Long64_t CACHE_SIZE_;
+
+        // Keyed on BRANCH.LEAF; std::map does not move its values, so the
+        // references returned by Variable stay valid
+        std::map<std::string, variable> variables_;
+        // The variables in the order they were requested
+        std::vector<variable*> columns_;
+        // The branches read by GetEntry, each only once, and the names of
+        // every branch we read, which are the ones in the cache
+        std::vector<std::string> entry_branch_names_;
+        std::vector<TBranch*> branches_;
+        std::vector<std::string> branch_names_;
+        bool use_weights_;
+
+        // The tree of the chain that the branch pointers belong to; -1 when
+        // they must be looked up again
+        int tree_number_;
+
+        void Init(const bool PARALLEL_UNZIP);
+        void AddBranch(const std::string& NAME, const bool READ_IN_GETENTRY);
+        Long64_t LoadEntry(const Long64_t ENTRY);
+        void Connect();
+        TBranch* FindBranch(const std::string& NAME) const;
+
+    private:
+        ZDefTreeReader(const ZDefTreeReader&);
+        ZDefTreeReader& operator=(const ZDefTreeReader&);
+};
+
+// Opens TFILE and returns the tree at the path TTREE in it, throwing if
+// either can not be read. The file is left open for the tree.
+TTree* GetTTree(const std::string& TFILE, const std::string& TTREE);
+
+// The ARGS, with each one starting with "@" replaced by the files listed in
+// it, one per line; lines starting with "#" are skipped
+std::vector<std::string> ExpandFileLists(const std::vector<std::string>& ARGS);
+
+// The product of the weights used for the analysis: the generator, pileup,
+// electron ID, trigger, and GSF reconstruction weights
+double GetWeight(const int WEIGHT_SIZE, const double WEIGHTS[], const int WEIGHT_IDS[]);
+
+#endif  // ZDEF_TREE_READER_H_
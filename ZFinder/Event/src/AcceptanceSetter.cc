@@ -21,6 +21,28 @@ namespace zf {
         }
     }
 
+    double AcceptanceSetter::MaximumAbsEta(const std::string& CUT) {
+        // The "+" and "-" halves have the same limit as the whole region
+        const std::string PREFIX = "acc(";
+        if (CUT.compare(0, PREFIX.size(), PREFIX) != 0) {
+            return -1;
+        }
+        std::string region = CUT.substr(PREFIX.size());
+        region = region.substr(0, region.find_first_of("+-)"));
+        if (region == "EB") {
+            return EB_MAX_;
+        } else if (region == "EE" || region == "ET" || region == "NT") {
+            return EEP_MAX_;
+        } else if (region == "HF" || region == "DETECTOR") {
+            return HFP_MAX_;
+        } else if (region == "MUON_TIGHT") {
+            return MUON_TIGHT_MAX_;
+        } else if (region == "MUON_LOOSE") {
+            return MUON_LOOSE_MAX_;
+        }
+        return -1;
+    }
+
     void AcceptanceSetter::SetCut_(ZFinderElectron* zf_elec) {
         const double WEIGHT = 1.;
         const double ETA = zf_elec->eta();
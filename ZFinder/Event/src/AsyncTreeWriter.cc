@@ -0,0 +1,146 @@
+#include "ZFinder/Event/interface/AsyncTreeWriter.h"
+
+// Standard Library
+#include <chrono>  // std::chrono::milliseconds
+#include <cstring>  // memcpy
+
+
+namespace zf {
+    // Constructor
+    AsyncTreeWriter::AsyncTreeWriter(const size_t N_SLOTS) :
+        N_SLOTS_(N_SLOTS),
+        slot_size_(0),
+        head_(0),
+        tail_(0),
+        stop_(false),
+        running_(false),
+        flushed_(false)
+    {
+        if (N_SLOTS_ == 0) {
+            throw "In AsyncTreeWriter, the ring buffer must have at least one slot!";
+        }
+    }
+
+    AsyncTreeWriter::~AsyncTreeWriter() {
+        Flush();
+    }
+
+    int AsyncTreeWriter::AddTree(TTree* tree, void* tree_row, const size_t ROW_SIZE, const extra_function& SET_EXTRA) {
+        if (running_ || flushed_) {
+            throw "In AsyncTreeWriter, trees can not be added after the first Fill!";
+        }
+        tree_info info;
+        info.tree = tree;
+        info.tree_row = tree_row;
+        info.row_size = ROW_SIZE;
+        info.set_extra = SET_EXTRA;
+        trees_.push_back(info);
+        return trees_.size() - 1;
+    }
+
+    void AsyncTreeWriter::Start() {
+        /*
+         * Size the slots for the largest row, rounded up so that every row
+         * starts 8 byte aligned, and start the I/O thread.
+         */
+        size_t max_row = 0;
+        for (auto& i_tree : trees_) {
+            if (i_tree.row_size > max_row) {
+                max_row = i_tree.row_size;
+            }
+        }
+        slot_size_ = HEADER_SIZE_ + ((max_row + HEADER_SIZE_ - 1) / HEADER_SIZE_) * HEADER_SIZE_;
+        buffer_.resize(N_SLOTS_ * slot_size_);
+        extras_.resize(N_SLOTS_);
+        running_ = true;
+        thread_ = std::thread(&AsyncTreeWriter::Run, this);
+    }
+
+    void AsyncTreeWriter::Fill(const int TREE_ID, const void* ROW, const std::vector<char>* EXTRA) {
+        // After Flush there is no thread, so write directly
+        if (flushed_) {
+            FillTree(TREE_ID, ROW, EXTRA != nullptr ? *EXTRA : std::vector<char>());
+            return;
+        }
+        if (!running_) {
+            Start();
+        }
+
+        // Wait for a free slot. The ring is full when head_ is a whole lap
+        // ahead of tail_.
+        const size_t HEAD = head_.load(std::memory_order_relaxed);
+        if (HEAD - tail_.load(std::memory_order_acquire) >= N_SLOTS_) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (HEAD - tail_.load(std::memory_order_acquire) >= N_SLOTS_) {
+                not_empty_.notify_one();
+                not_full_.wait_for(lock, std::chrono::milliseconds(1));
+            }
+        }
+
+        // Copy the row in and publish it
+        char* slot = &buffer_[(HEAD % N_SLOTS_) * slot_size_];
+        memcpy(slot, &TREE_ID, sizeof(TREE_ID));
+        memcpy(slot + HEADER_SIZE_, ROW, trees_[TREE_ID].row_size);
+        std::vector<char>& extra = extras_[HEAD % N_SLOTS_];
+        if (EXTRA != nullptr) {
+            extra.assign(EXTRA->begin(), EXTRA->end());
+        }
+        else {
+            extra.clear();
+        }
+        head_.store(HEAD + 1, std::memory_order_release);
+
+        // Only wake the I/O thread when it may be waiting on an empty ring
+        if (HEAD == tail_.load(std::memory_order_acquire)) {
+            not_empty_.notify_one();
+        }
+    }
+
+    void AsyncTreeWriter::Run() {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            const size_t HEAD = head_.load(std::memory_order_acquire);
+            if (tail == HEAD) {
+                // Stop only once everything queued has been written
+                if (stop_.load(std::memory_order_acquire)) {
+                    if (tail == head_.load(std::memory_order_acquire)) {
+                        break;
+                    }
+                    continue;
+                }
+                // The timeout covers a notify sent between the check above
+                // and the wait
+                std::unique_lock<std::mutex> lock(mutex_);
+                not_empty_.wait_for(lock, std::chrono::milliseconds(1));
+                continue;
+            }
+
+            const char* SLOT = &buffer_[(tail % N_SLOTS_) * slot_size_];
+            int tree_id;
+            memcpy(&tree_id, SLOT, sizeof(tree_id));
+            FillTree(tree_id, SLOT + HEADER_SIZE_, extras_[tail % N_SLOTS_]);
+            ++tail;
+            tail_.store(tail, std::memory_order_release);
+            not_full_.notify_one();
+        }
+    }
+
+    void AsyncTreeWriter::FillTree(const int TREE_ID, const void* ROW, const std::vector<char>& EXTRA) {
+        const tree_info& INFO = trees_[TREE_ID];
+        memcpy(INFO.tree_row, ROW, INFO.row_size);
+        if (INFO.set_extra) {
+            INFO.set_extra(EXTRA);
+        }
+        INFO.tree->Fill();
+    }
+
+    void AsyncTreeWriter::Flush() {
+        if (running_) {
+            stop_.store(true, std::memory_order_release);
+            not_empty_.notify_one();
+            thread_.join();
+            running_ = false;
+        }
+        flushed_ = true;
+    }
+}  // namespace zf
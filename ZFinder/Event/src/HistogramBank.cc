@@ -0,0 +1,253 @@
+#include "ZFinder/Event/interface/HistogramBank.h"
+
+// Standard Library
+#include <algorithm>  // std::upper_bound
+#include <cmath>  // sqrt
+
+// ROOT
+#include "TH1D.h"  // TH1D
+#include "TH2D.h"  // TH2D
+
+
+namespace zf {
+    int HistogramBank::axis::FindBin(const double X) const {
+        // NaN ends up in the overflow, as in TAxis::FindBin
+        if (X < low) {
+            return 0;
+        }
+        else if (!(X < high)) {
+            return nbins + 1;
+        }
+        if (edges.empty()) {
+            return 1 + static_cast<int>(nbins * (X - low) / (high - low));
+        }
+        return std::upper_bound(edges.begin(), edges.end(), X) - edges.begin();
+    }
+
+    int HistogramBank::Book1D(
+            const std::string& NAME,
+            const std::string& TITLE,
+            const int NBINS,
+            const double LOW,
+            const double HIGH
+            ) {
+        histogram histo;
+        histo.name = NAME;
+        histo.title = TITLE;
+        histo.is_2d = false;
+        histo.x.nbins = NBINS;
+        histo.x.low = LOW;
+        histo.x.high = HIGH;
+        return Book(histo);
+    }
+
+    int HistogramBank::Book1D(
+            const std::string& NAME,
+            const std::string& TITLE,
+            const int NBINS,
+            const double* EDGES
+            ) {
+        histogram histo;
+        histo.name = NAME;
+        histo.title = TITLE;
+        histo.is_2d = false;
+        histo.x.nbins = NBINS;
+        histo.x.edges.assign(EDGES, EDGES + NBINS + 1);
+        histo.x.low = EDGES[0];
+        histo.x.high = EDGES[NBINS];
+        return Book(histo);
+    }
+
+    int HistogramBank::Book2D(
+            const std::string& NAME,
+            const std::string& TITLE,
+            const int NBINS_X,
+            const double* EDGES_X,
+            const int NBINS_Y,
+            const double* EDGES_Y
+            ) {
+        histogram histo;
+        histo.name = NAME;
+        histo.title = TITLE;
+        histo.is_2d = true;
+        histo.x.nbins = NBINS_X;
+        histo.x.edges.assign(EDGES_X, EDGES_X + NBINS_X + 1);
+        histo.x.low = EDGES_X[0];
+        histo.x.high = EDGES_X[NBINS_X];
+        histo.y.nbins = NBINS_Y;
+        histo.y.edges.assign(EDGES_Y, EDGES_Y + NBINS_Y + 1);
+        histo.y.low = EDGES_Y[0];
+        histo.y.high = EDGES_Y[NBINS_Y];
+        return Book(histo);
+    }
+
+    int HistogramBank::Book(const histogram& HISTO) {
+        histograms_.push_back(HISTO);
+        histogram& histo = histograms_.back();
+        if (!histo.is_2d) {
+            histo.y.nbins = 0;
+            histo.y.low = 0;
+            histo.y.high = 0;
+        }
+        histo.offset = -1;
+        histo.entries = 0;
+        histo.has_sumw2 = false;
+        return histograms_.size() - 1;
+    }
+
+    void HistogramBank::SetXTitle(const int ID, const std::string& TITLE) {
+        histograms_.at(ID).x_title = TITLE;
+    }
+
+    void HistogramBank::SetYTitle(const int ID, const std::string& TITLE) {
+        histograms_.at(ID).y_title = TITLE;
+    }
+
+    int HistogramBank::NCells(const histogram& HISTO) const {
+        if (HISTO.is_2d) {
+            return (HISTO.x.nbins + 2) * (HISTO.y.nbins + 2);
+        }
+        return HISTO.x.nbins + 2;
+    }
+
+    double* HistogramBank::Allocate(histogram& histo) {
+        if (histo.offset < 0) {
+            histo.offset = bins_.size();
+            bins_.resize(bins_.size() + 2 * NCells(histo) + N_STATS_, 0.);
+        }
+        return &bins_[histo.offset];
+    }
+
+    HistogramBank::entry HistogramBank::MakeEntry(const int ID, const double X) const {
+        const histogram& HISTO = histograms_[ID];
+        const int BIN = HISTO.x.FindBin(X);
+        entry new_entry;
+        new_entry.id = ID;
+        new_entry.cell = BIN;
+        new_entry.in_range = (BIN > 0 && BIN <= HISTO.x.nbins);
+        new_entry.x = X;
+        new_entry.y = 0.;
+        return new_entry;
+    }
+
+    HistogramBank::entry HistogramBank::MakeEntry(const int ID, const double X, const double Y) const {
+        const histogram& HISTO = histograms_[ID];
+        const int BIN_X = HISTO.x.FindBin(X);
+        const int BIN_Y = HISTO.y.FindBin(Y);
+        entry new_entry;
+        new_entry.id = ID;
+        new_entry.cell = BIN_Y * (HISTO.x.nbins + 2) + BIN_X;
+        new_entry.in_range = (
+                BIN_X > 0 && BIN_X <= HISTO.x.nbins
+                && BIN_Y > 0 && BIN_Y <= HISTO.y.nbins
+                );
+        new_entry.x = X;
+        new_entry.y = Y;
+        return new_entry;
+    }
+
+    void HistogramBank::Fill(const int ID, const double X, const double WEIGHT) {
+        Fill(MakeEntry(ID, X), WEIGHT);
+    }
+
+    void HistogramBank::Fill(const int ID, const double X, const double Y, const double WEIGHT) {
+        Fill(MakeEntry(ID, X, Y), WEIGHT);
+    }
+
+    void HistogramBank::Fill(const entry& ENTRY, const double WEIGHT) {
+        histogram& histo = histograms_[ENTRY.id];
+        double* bins = Allocate(histo);
+        const int N_CELLS = NCells(histo);
+        histo.entries += 1;
+        if (WEIGHT != 1.) {
+            histo.has_sumw2 = true;
+        }
+        bins[ENTRY.cell] += WEIGHT;
+        bins[N_CELLS + ENTRY.cell] += WEIGHT * WEIGHT;
+
+        // Like ROOT, the statistics only count entries inside the axis range
+        if (ENTRY.in_range) {
+            double* stats = bins + 2 * N_CELLS;
+            stats[0] += WEIGHT;
+            stats[1] += WEIGHT * WEIGHT;
+            stats[2] += WEIGHT * ENTRY.x;
+            stats[3] += WEIGHT * ENTRY.x * ENTRY.x;
+            stats[4] += WEIGHT * ENTRY.y;
+            stats[5] += WEIGHT * ENTRY.y * ENTRY.y;
+            stats[6] += WEIGHT * ENTRY.x * ENTRY.y;
+        }
+    }
+
+    void HistogramBank::Fill(const entry_vector& ENTRIES, const double WEIGHT) {
+        for (auto& i_entry : ENTRIES) {
+            Fill(i_entry, WEIGHT);
+        }
+    }
+
+    void HistogramBank::Write(TFileDirectory& tdir) {
+        /*
+         * Make each histogram, copy the bins and statistics into it, write
+         * it, and delete it, so that only one ROOT histogram exists at a
+         * time.
+         */
+        for (auto& i_histo : histograms_) {
+            TH1* root_histo = nullptr;
+            if (i_histo.is_2d) {
+                root_histo = tdir.make<TH2D>(
+                        i_histo.name.c_str(), i_histo.title.c_str(),
+                        i_histo.x.nbins, &i_histo.x.edges[0],
+                        i_histo.y.nbins, &i_histo.y.edges[0]
+                        );
+            }
+            else if (!i_histo.x.edges.empty()) {
+                root_histo = tdir.make<TH1D>(
+                        i_histo.name.c_str(), i_histo.title.c_str(),
+                        i_histo.x.nbins, &i_histo.x.edges[0]
+                        );
+            }
+            else {
+                root_histo = tdir.make<TH1D>(
+                        i_histo.name.c_str(), i_histo.title.c_str(),
+                        i_histo.x.nbins, i_histo.x.low, i_histo.x.high
+                        );
+            }
+            root_histo->GetXaxis()->SetTitle(i_histo.x_title.c_str());
+            root_histo->GetYaxis()->SetTitle(i_histo.y_title.c_str());
+
+            if (i_histo.offset >= 0) {
+                const double* BINS = &bins_[i_histo.offset];
+                const int N_CELLS = NCells(i_histo);
+                if (i_histo.has_sumw2) {
+                    root_histo->Sumw2();
+                }
+                for (int i_cell = 0; i_cell < N_CELLS; ++i_cell) {
+                    root_histo->SetBinContent(i_cell, BINS[i_cell]);
+                    if (i_histo.has_sumw2) {
+                        root_histo->SetBinError(i_cell, sqrt(BINS[N_CELLS + i_cell]));
+                    }
+                }
+                // SetBinContent changes the entries and statistics, so set
+                // them last
+                double stats[N_STATS_];
+                for (int i = 0; i < N_STATS_; ++i) {
+                    stats[i] = BINS[2 * N_CELLS + i];
+                }
+                root_histo->PutStats(stats);
+                root_histo->SetEntries(i_histo.entries);
+            }
+
+            tdir.cd();
+            root_histo->Write();
+            delete root_histo;
+        }
+    }
+
+    void HistogramBank::Clear() {
+        std::vector<double>().swap(bins_);
+        for (auto& i_histo : histograms_) {
+            i_histo.offset = -1;
+            i_histo.entries = 0;
+            i_histo.has_sumw2 = false;
+        }
+    }
+}  // namespace zf
@@ -1,8 +1,13 @@
 #include "ZFinder/Event/interface/ZDefinition.h"
 
 // Standard Libraries
+#include <algorithm>  // std::max
+#include <iomanip>  // std::setprecision
 #include <sstream>  // std::ostringstream
 
+// ZFinder Code
+#include "ZFinder/Event/interface/AcceptanceSetter.h"  // AcceptanceSetter
+
 
 namespace zf {
 
@@ -252,6 +257,68 @@ namespace zf {
         }
     }
 
+    double ZDefinition::MinimumPt(const int I_CUTSET) const {
+        /*
+         * Find the largest lower bound on the reco pt from the cuts in a cut
+         * set. Both "pt>X" and "!pt<X" set a lower bound.
+         */
+        double min_pt = 0.;
+        for (auto& i_cutinfo : cutinfo_[I_CUTSET]) {
+            if (i_cutinfo.comp_var != CV_PT) {
+                continue;
+            }
+            const bool IS_GT = (i_cutinfo.comp_type == CT_GT || i_cutinfo.comp_type == CT_GTE);
+            const bool IS_LT = (i_cutinfo.comp_type == CT_LT || i_cutinfo.comp_type == CT_LTE);
+            if ((IS_GT && !i_cutinfo.invert) || (IS_LT && i_cutinfo.invert)) {
+                min_pt = std::max(min_pt, i_cutinfo.comp_val);
+            }
+        }
+        return min_pt;
+    }
+
+    double ZDefinition::MaximumAbsEta(const int I_CUTSET) const {
+        /*
+         * Find the smallest upper bound on the reco |eta| from the cuts in a
+         * cut set, from "aeta<X", "!aeta>X", and the acceptance regions.
+         */
+        double max_eta = -1.;
+        for (auto& i_cutinfo : cutinfo_[I_CUTSET]) {
+            double bound = -1.;
+            if (i_cutinfo.comp_var == CV_AETA) {
+                const bool IS_GT = (i_cutinfo.comp_type == CT_GT || i_cutinfo.comp_type == CT_GTE);
+                const bool IS_LT = (i_cutinfo.comp_type == CT_LT || i_cutinfo.comp_type == CT_LTE);
+                if ((IS_LT && !i_cutinfo.invert) || (IS_GT && i_cutinfo.invert)) {
+                    bound = i_cutinfo.comp_val;
+                }
+            }
+            else if (i_cutinfo.comp_var == CV_NONE && !i_cutinfo.invert) {
+                bound = AcceptanceSetter::MaximumAbsEta(i_cutinfo.cut);
+            }
+            if (bound >= 0. && (max_eta < 0. || bound < max_eta)) {
+                max_eta = bound;
+            }
+        }
+        return max_eta;
+    }
+
+    std::string ZDefinition::CutLevelKey(const size_t I_LEVEL) const {
+        /*
+         * The cut level names drop the "!" used to invert a cut, and round
+         * the mass window, so build the key from the cuts themselves.
+         */
+        std::ostringstream key;
+        if (I_LEVEL < cutinfo_[0].size()) {
+            for (int i_cutset = 0; i_cutset < 2; ++i_cutset) {
+                const CutInfo& CUTINFO = cutinfo_[i_cutset].at(I_LEVEL);
+                key << (CUTINFO.invert ? "!" : "") << CUTINFO.cut << ";";
+            }
+        }
+        else {
+            key << std::setprecision(17) << "MASS;" << MZ_MIN_ << ";" << MZ_MAX_ << ";" << USE_MC_MASS_;
+        }
+        return key.str();
+    }
+
     bool ZDefinition::ComparisonCut(const CutInfo& CUTINFO, const int I_ELEC, ZFinderEvent* zf_event) {
         // An enum to track what cut we're making
         enum CUTTYPE {
@@ -1,49 +1,258 @@
 #include "ZFinder/Event/interface/ZDefinitionTree.h"
 
 // Standard Library
-#include <algorithm>
-#include <vector>  // std::min
+#include <algorithm>  // std::copy, std::min, std::sort
+#include <cctype>  // isalnum
+#include <cstring>  // memcpy
+#include <vector>  // std::vector
 
 // ZFinder Code
 #include "ZFinder/Event/interface/CutLevel.h"  // cutlevel_vector
+#include "ZFinder/Event/interface/WeightCoding.h"  // EncodeWeightRatio
 #include "ZFinder/Event/interface/WeightID.h"  // WeightID, STR_TO_WEIGHTID
 
 
 namespace zf {
+    namespace {
+        // The names of the PDF sets, in the order of row_struct
+        const char* const PDF_SET_NAMES[] = {"cteq", "mstw", "nnpdf"};
+    }
+
     // Constructor
-    ZDefinitionTree::ZDefinitionTree(const ZDefinition& zdef, TFileDirectory& tdir, const bool IS_MC) : IS_MC_(IS_MC) {
+    ZDefinitionTree::ZDefinitionTree(
+            const ZDefinition& zdef,
+            TFileDirectory& tdir,
+            const bool IS_MC,
+            const TreeLayout& LAYOUT,
+            AsyncTreeWriter* writer
+            ) : writer_(writer), writer_id_(-1), IS_MC_(IS_MC), LAYOUT_(LAYOUT), n_entries_(0), index_tree_(nullptr), columnar_(nullptr) {
         // Get the name of the cut we want
         zdef_name_ = zdef.NAME;
 
+        // With a writer the tree is filled on another thread, so its branches
+        // need their own copy of the row
+        branch_row_ = (writer_ != nullptr) ? &tree_row_ : &row_;
+        branch_pdfs_ = (writer_ != nullptr) ? tree_pdfs_ : row_pdfs_;
+        row_struct* row = branch_row_;
+
         // Make the directory to save files to
         tdir.cd();
 
         // Make the Tree to write to
         tree_ = new TTree(zdef.NAME.c_str(), zdef.NAME.c_str());
-        const std::string CODE = "z_m/D:z_y:z_phistar_born:z_phistar_dressed:z_phistar_naked:z_phistar_sc:z_pt:z_eta:e_pt0:e_pt1:e_eta0:e_eta1:e_phi0:e_phi1:e_rnine0:e_rnine1:n_true_pileup:e_charge0/I:e_charge1:n_verts:t0tight/O:t1tight";
-        tree_->Branch("reco", &reco_, CODE.c_str());
-        if (IS_MC_) {
-            tree_->Branch("truth", &truth_, CODE.c_str());
+        if (LAYOUT_.split_branches) {
+            MakeSplitBranches("reco", &row->split_reco);
+            if (IS_MC_) {
+                MakeSplitBranches("truth", &row->split_truth);
+            }
+            MakeBranch("event_number", &row->event.event_number, "event_number/i");
+            MakeBranch("run_number", &row->event.run_number, "run_number/i");
+            MakeBranch("is_mc", &row->event.is_mc, "is_mc/O");
+        }
+        else {
+            MakeBranch("reco", &row->reco, BRANCH_STRUCT_CODE);
+            if (IS_MC_) {
+                MakeBranch("truth", &row->truth, BRANCH_STRUCT_CODE);
+            }
+            MakeBranch("event_info", &row->event, EVENT_BRANCH_CODE);
         }
-        const std::string EVENT_CODE = "event_number/i:run_number:is_mc/O";
-        tree_->Branch("event_info", &event_, EVENT_CODE.c_str());
         if (IS_MC_) {
-            tree_->Branch("weight_size", &weight_size_, "weight_size/I");
-            tree_->Branch("weights", weights_, "weights[weight_size]/D");
-            tree_->Branch("weight_ids", weight_ids_, "weight_ids[weight_size]/I");
-            tree_->Branch("weight_cteq_size", &weight_cteq_size_, "weight_cteq_size/I");
-            tree_->Branch("weights_cteq", weights_cteq_, "weights_cteq[weight_cteq_size]/D");
-            tree_->Branch("weight_mstw_size", &weight_mstw_size_, "weight_mstw_size/I");
-            tree_->Branch("weights_mstw", weights_mstw_, "weights_mstw[weight_mstw_size]/D");
-            tree_->Branch("weight_nnpdf_size", &weight_nnpdf_size_, "weight_nnpdf_size/I");
-            tree_->Branch("weights_nnpdf", weights_nnpdf_, "weights_nnpdf[weight_nnpdf_size]/D");
-            tree_->Branch("weight_fsr", &weight_fsr_, "weight_fsr/D");
+            const bool IS_WEIGHT = true;
+            MakeBranch("weight_size", &row->weight_size, "weight_size/I", IS_WEIGHT);
+            MakeBranch("weights", row->weights, "weights[weight_size]/D", IS_WEIGHT);
+            MakeBranch("weight_ids", row->weight_ids, "weight_ids[weight_size]/I", IS_WEIGHT);
+            for (int i_set = 0; i_set < N_PDF_SETS_; ++i_set) {
+                MakePDFBranches(PDF_SET_NAMES[i_set], i_set);
+            }
+            MakeBranch("weight_fsr", &row->weight_fsr, "weight_fsr/D", IS_WEIGHT);
+        }
+
+        // Only MC rows carry PDF weights
+        if (writer_ != nullptr && IS_MC_) {
+            writer_id_ = writer_->AddTree(
+                    tree_, &tree_row_, sizeof(tree_row_),
+                    [this](const std::vector<char>& EXTRA) { UnpackPDFWeights(EXTRA); }
+                    );
+        }
+        else if (writer_ != nullptr) {
+            writer_id_ = writer_->AddTree(tree_, &tree_row_, sizeof(tree_row_));
+        }
+
+        if (!LAYOUT_.columnar_dir.empty()) {
+            columnar_ = new ColumnarWriter();
+            AddColumns();
+        }
+    }
+
+    TBranch* ZDefinitionTree::MakeBranch(
+            const std::string& NAME,
+            void* address,
+            const std::string& LEAF_LIST,
+            const bool IS_WEIGHT
+            ) {
+        TBranch* branch = tree_->Branch(NAME.c_str(), address, LEAF_LIST.c_str(), LAYOUT_.basket_size);
+        const int COMPRESSION = IS_WEIGHT ? LAYOUT_.weight_compression : LAYOUT_.compression;
+        if (branch != nullptr && COMPRESSION >= 0) {
+            branch->SetCompressionSettings(COMPRESSION);
+        }
+        return branch;
+    }
+
+    void ZDefinitionTree::MakePDFBranches(const std::string& SET, const int I_SET) {
+        /*
+         * The PDF weights are variable length arrays, so only the members
+         * the event has are written. The buffers start with one member so
+         * that the branches have an address; they grow with the largest set
+         * seen.
+         */
+        const bool IS_WEIGHT = true;
+        const std::string SIZE = "weight_" + SET + "_size";
+        MakeBranch(SIZE, &branch_row_->weight_pdf_size[I_SET], SIZE + "/I", IS_WEIGHT);
+        row_pdfs_[I_SET].weights.resize(1);
+        row_pdfs_[I_SET].ratios.resize(1);
+        tree_pdfs_[I_SET].weights.resize(1);
+        tree_pdfs_[I_SET].ratios.resize(1);
+        pdf_buffer* pdf = &branch_pdfs_[I_SET];
+        if (LAYOUT_.compact_pdf_weights) {
+            const std::string CENTRAL = "weight_" + SET + "_central";
+            pdf->array_name = "weights_" + SET + "_ratio";
+            MakeBranch(CENTRAL, &branch_row_->weight_pdf_central[I_SET], CENTRAL + "/D", IS_WEIGHT);
+            MakeBranch(pdf->array_name, &pdf->ratios[0], pdf->array_name + "[" + SIZE + "]/s", IS_WEIGHT);
+        }
+        else {
+            pdf->array_name = "weights_" + SET;
+            MakeBranch(pdf->array_name, &pdf->weights[0], pdf->array_name + "[" + SIZE + "]/D", IS_WEIGHT);
+        }
+    }
+
+    void ZDefinitionTree::GrowPDFBuffer(pdf_buffer* pdf, const size_t SIZE) {
+        void* address = nullptr;
+        if (LAYOUT_.compact_pdf_weights) {
+            if (pdf->ratios.size() < SIZE) {
+                pdf->ratios.resize(SIZE);
+                address = &pdf->ratios[0];
+            }
+        }
+        else if (pdf->weights.size() < SIZE) {
+            pdf->weights.resize(SIZE);
+            address = &pdf->weights[0];
+        }
+        // The vector moved, so the branch reading it must move too
+        const bool IS_BRANCH = (pdf >= branch_pdfs_ && pdf < branch_pdfs_ + N_PDF_SETS_);
+        if (address != nullptr && IS_BRANCH) {
+            tree_->SetBranchAddress(pdf->array_name.c_str(), address);
+        }
+    }
+
+    void ZDefinitionTree::CopyPDFWeights(
+            const std::vector<double>& PDF_WEIGHTS,
+            const int I_SET,
+            pdf_buffer* pdf
+            ) {
+        const int SIZE = PDF_WEIGHTS.size();
+        row_.weight_pdf_size[I_SET] = SIZE;
+        GrowPDFBuffer(pdf, SIZE);
+
+        if (LAYOUT_.compact_pdf_weights) {
+            const double CENTRAL = (SIZE > 0) ? PDF_WEIGHTS[0] : 0.;
+            row_.weight_pdf_central[I_SET] = CENTRAL;
+            for (int i = 0; i < SIZE; ++i) {
+                pdf->ratios[i] = EncodeWeightRatio(PDF_WEIGHTS[i], CENTRAL);
+            }
+        }
+        else {
+            std::copy(PDF_WEIGHTS.begin(), PDF_WEIGHTS.end(), pdf->weights.begin());
+        }
+    }
+
+    void ZDefinitionTree::PackPDFWeights() {
+        /*
+         * The sets are packed one after the other; their sizes travel in the
+         * row, which the writer copies before calling UnpackPDFWeights.
+         */
+        pdf_extra_.clear();
+        for (int i_set = 0; i_set < N_PDF_SETS_; ++i_set) {
+            const pdf_buffer& PDF = row_pdfs_[i_set];
+            const int SIZE = row_.weight_pdf_size[i_set];
+            const char* begin = LAYOUT_.compact_pdf_weights
+                ? reinterpret_cast<const char*>(&PDF.ratios[0])
+                : reinterpret_cast<const char*>(&PDF.weights[0]);
+            const size_t N_BYTES = SIZE * (LAYOUT_.compact_pdf_weights ? sizeof(unsigned short) : sizeof(double));
+            pdf_extra_.insert(pdf_extra_.end(), begin, begin + N_BYTES);
         }
     }
 
+    void ZDefinitionTree::UnpackPDFWeights(const std::vector<char>& EXTRA) {
+        size_t offset = 0;
+        for (int i_set = 0; i_set < N_PDF_SETS_; ++i_set) {
+            pdf_buffer* pdf = &tree_pdfs_[i_set];
+            const int SIZE = tree_row_.weight_pdf_size[i_set];
+            GrowPDFBuffer(pdf, SIZE);
+            char* to = LAYOUT_.compact_pdf_weights
+                ? reinterpret_cast<char*>(&pdf->ratios[0])
+                : reinterpret_cast<char*>(&pdf->weights[0]);
+            const size_t N_BYTES = SIZE * (LAYOUT_.compact_pdf_weights ? sizeof(unsigned short) : sizeof(double));
+            if (offset + N_BYTES > EXTRA.size()) {
+                throw "In ZDefinitionTree, the PDF weights of a row are shorter than their sizes!";
+            }
+            memcpy(to, &EXTRA[offset], N_BYTES);
+            offset += N_BYTES;
+        }
+    }
+
+    void ZDefinitionTree::MakeSplitBranches(const std::string& PREFIX, split_branch_struct* branch) {
+        /*
+         * Make one branch per variable, named PREFIX_variable. The electron
+         * quantities are arrays of length 2, so reco_e_pt[0] is the old
+         * reco.e_pt0.
+         */
+        const std::string P = PREFIX + "_";
+        MakeBranch(P + "z_m", &branch->z_m, P + "z_m/F");
+        MakeBranch(P + "z_y", &branch->z_y, P + "z_y/F");
+        MakeBranch(P + "z_phistar_born", &branch->z_phistar_born, P + "z_phistar_born/F");
+        MakeBranch(P + "z_phistar_dressed", &branch->z_phistar_dressed, P + "z_phistar_dressed/F");
+        MakeBranch(P + "z_phistar_naked", &branch->z_phistar_naked, P + "z_phistar_naked/F");
+        MakeBranch(P + "z_phistar_sc", &branch->z_phistar_sc, P + "z_phistar_sc/F");
+        MakeBranch(P + "z_pt", &branch->z_pt, P + "z_pt/F");
+        MakeBranch(P + "z_eta", &branch->z_eta, P + "z_eta/F");
+        MakeBranch(P + "e_pt", branch->e_pt, P + "e_pt[2]/F");
+        MakeBranch(P + "e_eta", branch->e_eta, P + "e_eta[2]/F");
+        MakeBranch(P + "e_phi", branch->e_phi, P + "e_phi[2]/F");
+        MakeBranch(P + "e_rnine", branch->e_rnine, P + "e_rnine[2]/F");
+        MakeBranch(P + "n_true_pileup", &branch->n_true_pileup, P + "n_true_pileup/F");
+        MakeBranch(P + "e_charge", branch->e_charge, P + "e_charge[2]/I");
+        MakeBranch(P + "n_verts", &branch->n_verts, P + "n_verts/I");
+        MakeBranch(P + "t0tight", &branch->t0tight, P + "t0tight/O");
+        MakeBranch(P + "t1tight", &branch->t1tight, P + "t1tight/O");
+    }
+
+    void ZDefinitionTree::CopySplitBranch(const branch_struct& FROM, split_branch_struct* to) {
+        to->z_m = FROM.z_m;
+        to->z_y = FROM.z_y;
+        to->z_phistar_born = FROM.z_phistar_born;
+        to->z_phistar_dressed = FROM.z_phistar_dressed;
+        to->z_phistar_naked = FROM.z_phistar_naked;
+        to->z_phistar_sc = FROM.z_phistar_sc;
+        to->z_pt = FROM.z_pt;
+        to->z_eta = FROM.z_eta;
+        for (int i = 0; i < 2; ++i) {
+            to->e_pt[i] = FROM.e_pt[i];
+            to->e_eta[i] = FROM.e_eta[i];
+            to->e_phi[i] = FROM.e_phi[i];
+            to->e_rnine[i] = FROM.e_rnine[i];
+            to->e_charge[i] = FROM.e_charge[i];
+        }
+        to->n_true_pileup = FROM.n_true_pileup;
+        to->n_verts = FROM.n_verts;
+        to->t0tight = FROM.t0tight;
+        to->t1tight = FROM.t1tight;
+    }
+
     ZDefinitionTree::~ZDefinitionTree() {
         // Clean up our pointer
         delete tree_;
+        delete index_tree_;
+        delete columnar_;
     }
 
     void ZDefinitionTree::Fill(const ZFinderEvent& zf_event) {
@@ -53,9 +262,9 @@ namespace zf {
         }
 
         // Clear our branches
-        reco_.clear_values();
-        truth_.clear_values();
-        event_.clear_values();
+        row_.reco.clear_values();
+        row_.truth.clear_values();
+        row_.event.clear_values();
         weight_id_vector_.clear();
 
         // Set the weights
@@ -79,102 +288,234 @@ namespace zf {
             // Loop over out vector of weights and save them to the arrays so that
             // the tree can grab the values. If the vector is longer than
             // MAX_SIZE_, we stop there so as not to overflow our array!
-            weight_size_ = weight_id_vector_.size();
-            for (int i = 0; i < std::min(weight_size_, MAX_SIZE_); ++i) {
+            row_.weight_size = std::min(static_cast<int>(weight_id_vector_.size()), MAX_SIZE_);
+            for (int i = 0; i < row_.weight_size; ++i) {
                 const int WEIGHT_ID = weight_id_vector_.at(i).first;
                 const double WEIGHT = weight_id_vector_.at(i).second;
-                weights_[i] = WEIGHT;
-                weight_ids_[i] = WEIGHT_ID;
-            }
-            weight_cteq_size_ = zf_event.weights_cteq.size();
-            for (int i = 0; i < std::min(weight_cteq_size_, MAX_SIZE_PDF_); ++i) {
-              weights_cteq_[i] = zf_event.weights_cteq[i];
-            }
-            weight_mstw_size_ = zf_event.weights_mstw.size();
-            for (int i = 0; i < std::min(weight_mstw_size_, MAX_SIZE_PDF_); ++i) {
-              weights_mstw_[i] = zf_event.weights_mstw[i];
+                row_.weights[i] = WEIGHT;
+                row_.weight_ids[i] = WEIGHT_ID;
             }
-            weight_nnpdf_size_ = zf_event.weights_nnpdf.size();
-            for (int i = 0; i < std::min(weight_nnpdf_size_, MAX_SIZE_PDF_); ++i) {
-              weights_nnpdf_[i] = zf_event.weights_nnpdf[i];
+            const std::vector<double>* PDF_WEIGHTS[N_PDF_SETS_] = {
+                &zf_event.weights_cteq,
+                &zf_event.weights_mstw,
+                &zf_event.weights_nnpdf
+            };
+            for (int i_set = 0; i_set < N_PDF_SETS_; ++i_set) {
+                CopyPDFWeights(*PDF_WEIGHTS[i_set], i_set, &row_pdfs_[i_set]);
             }
 
-            weight_fsr_=zf_event.weight_fsr;
+            row_.weight_fsr=zf_event.weight_fsr;
          }
 
-        // Reco
-        reco_.z_m = zf_event.reco_z.m;
-        reco_.z_y = zf_event.reco_z.y;
-        reco_.z_phistar_dressed = zf_event.reco_z.phistar;
-        reco_.z_phistar_born = zf_event.reco_z.bornPhistar;
-        reco_.z_phistar_naked = zf_event.reco_z.nakedPhistar;
-        reco_.z_phistar_sc = zf_event.reco_z.scPhistar;
-        reco_.z_pt = zf_event.reco_z.pt;
-        reco_.z_eta = zf_event.reco_z.eta;
-        reco_.n_verts = zf_event.reco_vert.num;
-        if (zf_event.e0 != nullptr) {
-            reco_.e_pt[0] = zf_event.e0->pt();
-            reco_.e_eta[0] = zf_event.e0->eta();
-            reco_.e_phi[0] = zf_event.e0->phi();
-            reco_.e_rnine[0] = zf_event.e0->r9();
-            reco_.e_charge[0] = zf_event.e0->charge();
-        }
-        if (zf_event.e1 != nullptr) {
-            reco_.e_pt[1] = zf_event.e1->pt();
-            reco_.e_eta[1] = zf_event.e1->eta();
-            reco_.e_phi[1] = zf_event.e1->phi();
-            reco_.e_rnine[1] = zf_event.e1->r9();
-            reco_.e_charge[1] = zf_event.e1->charge();
-            if (zf_event.GetZDef(zdef_name_) != nullptr) {
-                    const cutlevel_vector* clv = zf_event.GetZDef(zdef_name_);
-                    reco_.t0tight = clv->back().second.t0p1_pass;
-                    reco_.t1tight = clv->back().second.t1p0_pass;
-                }
+        // Reco and Truth; the tight flags are those of this ZDefinition
+        const cutlevel_vector* clv = zf_event.GetZDef(zdef_name_);
+        row_.reco.fill(zf_event, false);
+        if (zf_event.e1 != nullptr && clv != nullptr) {
+            row_.reco.t0tight = clv->back().second.t0p1_pass;
+            row_.reco.t1tight = clv->back().second.t1p0_pass;
         }
-        // Truth
         if (IS_MC_ && !zf_event.is_real_data) {
-            truth_.z_m = zf_event.truth_z.m;
-            truth_.z_y = zf_event.truth_z.y;
-            truth_.z_phistar_dressed = zf_event.truth_z.phistar;
-            truth_.z_phistar_born = zf_event.truth_z.bornPhistar;
-            truth_.z_phistar_naked = zf_event.truth_z.nakedPhistar;
-            truth_.z_phistar_sc = zf_event.truth_z.scPhistar;
-            truth_.z_pt = zf_event.truth_z.pt;
-            truth_.z_eta = zf_event.truth_z.eta;
-            truth_.n_verts = zf_event.truth_vert.num;
-            truth_.n_true_pileup = zf_event.truth_vert.true_num;
-            if (zf_event.e0_truth != nullptr) {
-                truth_.e_pt[0] = zf_event.e0_truth->pt();
-                truth_.e_eta[0] = zf_event.e0_truth->eta();
-                truth_.e_phi[0] = zf_event.e0_truth->phi();
-                truth_.e_rnine[0] = zf_event.e0_truth->r9();
-                truth_.e_charge[0] = zf_event.e0_truth->charge();
-            }
-            if (zf_event.e1_truth != nullptr) {
-                truth_.e_pt[1] = zf_event.e1_truth->pt();
-                truth_.e_eta[1] = zf_event.e1_truth->eta();
-                truth_.e_phi[1] = zf_event.e1_truth->phi();
-                truth_.e_rnine[1] = zf_event.e1_truth->r9();
-                truth_.e_charge[1] = zf_event.e1_truth->charge();
-                if (zf_event.GetZDef(zdef_name_) != nullptr) {
-                    const cutlevel_vector* clv = zf_event.GetZDef(zdef_name_);
-                    truth_.t0tight = clv->back().second.t0p1_pass;
-                    truth_.t1tight = clv->back().second.t1p0_pass;
-                }
+            row_.truth.fill(zf_event, true);
+            if (zf_event.e1_truth != nullptr && clv != nullptr) {
+                row_.truth.t0tight = clv->back().second.t0p1_pass;
+                row_.truth.t1tight = clv->back().second.t1p0_pass;
             }
         }
         // General Event info
-        event_.is_mc = !zf_event.is_real_data;
-        event_.event_number = zf_event.id.event_num;
-        event_.run_number = zf_event.id.run_num;
+        row_.event.fill(zf_event);
 
         // Fill if there is a good Z in either truth or reco
         if (zf_event.truth_z.m > -1 || zf_event.reco_z.m > -1) {
-            tree_->Fill();
+            if (LAYOUT_.split_branches) {
+                CopySplitBranch(row_.reco, &row_.split_reco);
+                CopySplitBranch(row_.truth, &row_.split_truth);
+            }
+            if (writer_ != nullptr) {
+                if (IS_MC_) {
+                    PackPDFWeights();
+                }
+                writer_->Fill(writer_id_, &row_, IS_MC_ ? &pdf_extra_ : nullptr);
+            }
+            else {
+                tree_->Fill();
+            }
+            if (LAYOUT_.event_index) {
+                index_record record;
+                record.run_number = zf_event.id.run_num;
+                record.lumi_number = zf_event.id.lumi_num;
+                record.event_number = zf_event.id.event_num;
+                record.entry = n_entries_;
+                index_.push_back(record);
+            }
+            if (columnar_ != nullptr) {
+                AppendColumns(zf_event);
+            }
+            ++n_entries_;
         }
     }
 
+    bool ZDefinitionTree::index_record::operator<(const index_record& OTHER) const {
+        if (run_number != OTHER.run_number) {
+            return run_number < OTHER.run_number;
+        }
+        if (lumi_number != OTHER.lumi_number) {
+            return lumi_number < OTHER.lumi_number;
+        }
+        if (event_number != OTHER.event_number) {
+            return event_number < OTHER.event_number;
+        }
+        return entry < OTHER.entry;
+    }
+
+    void ZDefinitionTree::WriteIndex() {
+        /*
+         * The index is written as its own tree next to the ZDefinition tree.
+         * Every record also stores the size of the index it came from, so
+         * that a reader can recover the entry numbers after hadd has
+         * appended the trees (and indexes) of several jobs.
+         */
+        if (!LAYOUT_.event_index || index_tree_ != nullptr) {
+            return;
+        }
+        std::sort(index_.begin(), index_.end());
+
+        tree_->GetDirectory()->cd();
+        index_tree_ = new TTree("event_index", "event_index");
+        index_record record;
+        Long64_t index_size = index_.size();
+        index_tree_->Branch("run_number", &record.run_number, "run_number/i");
+        index_tree_->Branch("lumi_number", &record.lumi_number, "lumi_number/i");
+        index_tree_->Branch("event_number", &record.event_number, "event_number/i");
+        index_tree_->Branch("entry", &record.entry, "entry/L");
+        index_tree_->Branch("index_size", &index_size, "index_size/L");
+        for (auto& i_record : index_) {
+            record = i_record;
+            index_tree_->Fill();
+        }
+        // The branches point at record and index_size, which go out of
+        // scope; the tree is written later by the TFileService
+        index_tree_->ResetBranchAddresses();
+        std::vector<index_record>().swap(index_);
+    }
+
+    void ZDefinitionTree::WriteColumns() {
+        /*
+         * The file is named after the ZDefinition, with everything but
+         * letters and numbers replaced by "_".
+         */
+        if (columnar_ == nullptr) {
+            return;
+        }
+        std::string name = zdef_name_;
+        for (auto& i_char : name) {
+            if (!isalnum(i_char)) {
+                i_char = '_';
+            }
+        }
+        columnar_->Write(LAYOUT_.columnar_dir + "/" + name + ".zcol", LAYOUT_.columnar_group_by_run);
+        delete columnar_;
+        columnar_ = nullptr;
+    }
+
+    void ZDefinitionTree::AddColumns() {
+        /*
+         * The columns have the names of the split layout branches. The
+         * kinematic variables are single precision, as in the split layout,
+         * and the PDF weights are stored in full, never as ratios.
+         */
+        AddKinematicColumns("reco");
+        if (IS_MC_) {
+            AddKinematicColumns("truth");
+        }
+        columnar_->AddColumn<uint32_t>("event_number");
+        columnar_->AddColumn<uint32_t>("run_number");
+        columnar_->AddColumn<bool>("is_mc");
+        if (IS_MC_) {
+            const uint32_t VARIABLE = 0;
+            columnar_->AddColumn<double>("weights", VARIABLE);
+            columnar_->AddColumn<int32_t>("weight_ids", VARIABLE);
+            columnar_->AddColumn<double>("weights_cteq", VARIABLE);
+            columnar_->AddColumn<double>("weights_mstw", VARIABLE);
+            columnar_->AddColumn<double>("weights_nnpdf", VARIABLE);
+            columnar_->AddColumn<double>("weight_fsr");
+        }
+    }
+
+    void ZDefinitionTree::AddKinematicColumns(const std::string& PREFIX) {
+        const std::string P = PREFIX + "_";
+        columnar_->AddColumn<float>(P + "z_m");
+        columnar_->AddColumn<float>(P + "z_y");
+        columnar_->AddColumn<float>(P + "z_phistar_born");
+        columnar_->AddColumn<float>(P + "z_phistar_dressed");
+        columnar_->AddColumn<float>(P + "z_phistar_naked");
+        columnar_->AddColumn<float>(P + "z_phistar_sc");
+        columnar_->AddColumn<float>(P + "z_pt");
+        columnar_->AddColumn<float>(P + "z_eta");
+        columnar_->AddColumn<float>(P + "e_pt", 2);
+        columnar_->AddColumn<float>(P + "e_eta", 2);
+        columnar_->AddColumn<float>(P + "e_phi", 2);
+        columnar_->AddColumn<float>(P + "e_rnine", 2);
+        columnar_->AddColumn<float>(P + "n_true_pileup");
+        columnar_->AddColumn<int32_t>(P + "e_charge", 2);
+        columnar_->AddColumn<int32_t>(P + "n_verts");
+        columnar_->AddColumn<bool>(P + "t0tight");
+        columnar_->AddColumn<bool>(P + "t1tight");
+    }
+
+    void ZDefinitionTree::AppendColumns(const ZFinderEvent& zf_event) {
+        int i_col = 0;
+        AppendKinematicColumns(row_.reco, &i_col);
+        if (IS_MC_) {
+            AppendKinematicColumns(row_.truth, &i_col);
+        }
+        columnar_->Append<uint32_t>(i_col++, row_.event.event_number);
+        columnar_->Append<uint32_t>(i_col++, row_.event.run_number);
+        columnar_->Append<bool>(i_col++, row_.event.is_mc);
+        if (IS_MC_) {
+            columnar_->Append<double>(i_col++, row_.weights, row_.weight_size);
+            columnar_->Append<int32_t>(i_col++, row_.weight_ids, row_.weight_size);
+            columnar_->Append(i_col++, zf_event.weights_cteq.data(), zf_event.weights_cteq.size());
+            columnar_->Append(i_col++, zf_event.weights_mstw.data(), zf_event.weights_mstw.size());
+            columnar_->Append(i_col++, zf_event.weights_nnpdf.data(), zf_event.weights_nnpdf.size());
+            columnar_->Append<double>(i_col++, row_.weight_fsr);
+        }
+        columnar_->EndRow(row_.event.run_number);
+    }
+
+    void ZDefinitionTree::AppendKinematicColumns(const branch_struct& BRANCH, int* i_col) {
+        const float Z_VALUES[] = {
+            static_cast<float>(BRANCH.z_m),
+            static_cast<float>(BRANCH.z_y),
+            static_cast<float>(BRANCH.z_phistar_born),
+            static_cast<float>(BRANCH.z_phistar_dressed),
+            static_cast<float>(BRANCH.z_phistar_naked),
+            static_cast<float>(BRANCH.z_phistar_sc),
+            static_cast<float>(BRANCH.z_pt),
+            static_cast<float>(BRANCH.z_eta)
+        };
+        for (auto& i_value : Z_VALUES) {
+            columnar_->Append<float>((*i_col)++, i_value);
+        }
+        const double* ELECTRON_VALUES[] = {BRANCH.e_pt, BRANCH.e_eta, BRANCH.e_phi, BRANCH.e_rnine};
+        for (auto& i_values : ELECTRON_VALUES) {
+            const float VALUES[2] = {static_cast<float>(i_values[0]), static_cast<float>(i_values[1])};
+            columnar_->Append<float>((*i_col)++, VALUES, 2);
+        }
+        columnar_->Append<float>((*i_col)++, BRANCH.n_true_pileup);
+        columnar_->Append<int32_t>((*i_col)++, BRANCH.e_charge, 2);
+        columnar_->Append<int32_t>((*i_col)++, BRANCH.n_verts);
+        columnar_->Append<bool>((*i_col)++, BRANCH.t0tight);
+        columnar_->Append<bool>((*i_col)++, BRANCH.t1tight);
+    }
+
     void ZDefinitionTree::FillCutWeights(cutlevel_vector const * const CUT_LEVEL_VECTOR) {
+        GetCutWeights(CUT_LEVEL_VECTOR, &weight_id_vector_);
+    }
+
+    void ZDefinitionTree::GetCutWeights(
+            cutlevel_vector const * const CUT_LEVEL_VECTOR,
+            std::vector<std::pair<int, double>>* weight_id_vector
+            ) {
         if (CUT_LEVEL_VECTOR != nullptr) {
             // Check if we pass via Tag 0 Probe 1, or Tag 1 Probe 1
             CutLevel last_cutlevel = CUT_LEVEL_VECTOR->back().second;
@@ -202,11 +543,11 @@ namespace zf {
                 // The Tag has a WeightID
                 if (tag_it != STR_TO_WEIGHTID.end()) {
                     const int WEIGHTID = tag_it->second;
-                    weight_id_vector_.push_back(std::make_pair(WEIGHTID, tag_weight));
+                    weight_id_vector->push_back(std::make_pair(WEIGHTID, tag_weight));
                 }
                 if (probe_it != STR_TO_WEIGHTID.end()) {
                     const int WEIGHTID = probe_it->second;
-                    weight_id_vector_.push_back(std::make_pair(WEIGHTID, probe_weight));
+                    weight_id_vector->push_back(std::make_pair(WEIGHTID, probe_weight));
                 }
             }
         }
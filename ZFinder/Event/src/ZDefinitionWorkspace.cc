@@ -0,0 +1,179 @@
+#include "ZFinder/Event/interface/ZDefinitionWorkspace.h"
+
+// Standard Library
+#include <utility>  // std::swap
+
+// ZFinder Code
+#include "ZFinder/Event/interface/CutLevel.h"  // cutlevel_vector
+
+
+namespace zf {
+    // Constructor
+    ZDefinitionWorkspace::ZDefinitionWorkspace(
+            const ZDefinition& zdef,
+            TFileDirectory& tdir,
+            const bool USE_MC,
+            const bool IS_MC,
+            const int BATCH_SIZE
+            ) :
+        USE_MC_(USE_MC),
+        DATA_TYPE_(USE_MC ? TRUTH_MC : (IS_MC ? RECO_MC : DATA)),
+        BATCH_SIZE_(BATCH_SIZE > 0 ? BATCH_SIZE : 1),
+        tdir_(tdir),
+        written_(false)
+    {
+        zdef_name_ = zdef.NAME;
+
+        // The last level of the cutlevel_vector is the mass cut, which is
+        // ignored. Events are selected by the cut before the last one, and
+        // are in the numerator if they also pass the last one.
+        const int N_CUTS = static_cast<int>(zdef.clv.size()) - 1;
+        numerator_level_ = N_CUTS - 1;
+        denominator_level_ = N_CUTS - 2;
+        batch_.reserve(BATCH_SIZE_);
+
+        // Make the store in our directory of the output file, so its
+        // baskets are written out as they fill
+        tdir.cd();
+        tree_ = new TTree("workspace_store", "workspace_store");
+        tree_->Branch("z_mass", &tree_row_.z_mass, "z_mass/D");
+        tree_->Branch("z_eta", &tree_row_.z_eta, "z_eta/D");
+        tree_->Branch("z_y", &tree_row_.z_y, "z_y/D");
+        tree_->Branch("z_pt", &tree_row_.z_pt, "z_pt/D");
+        tree_->Branch("phistar", &tree_row_.phistar, "phistar/D");
+        tree_->Branch("e0_pt", &tree_row_.e0_pt, "e0_pt/D");
+        tree_->Branch("e1_pt", &tree_row_.e1_pt, "e1_pt/D");
+        tree_->Branch("e0_eta", &tree_row_.e0_eta, "e0_eta/D");
+        tree_->Branch("e1_eta", &tree_row_.e1_eta, "e1_eta/D");
+        tree_->Branch("e0_charge", &tree_row_.e0_charge, "e0_charge/D");
+        tree_->Branch("e1_charge", &tree_row_.e1_charge, "e1_charge/D");
+        tree_->Branch("n_vert", &tree_row_.n_vert, "n_vert/D");
+        tree_->Branch("event_num", &tree_row_.event_num, "event_num/D");
+        tree_->Branch("weight", &tree_row_.weight, "weight/D");
+        tree_->Branch("data_type", &tree_row_.data_type, "data_type/I");
+        tree_->Branch("numerator", &tree_row_.numerator, "numerator/I");
+        tree_->Branch("degenerate", &tree_row_.degenerate, "degenerate/I");
+        tree_->Branch("pass_all", &tree_row_.pass_all, "pass_all/I");
+    }
+
+    ZDefinitionWorkspace::~ZDefinitionWorkspace() {
+        // Clean up our pointer
+        delete tree_;
+    }
+
+    void ZDefinitionWorkspace::Fill(const ZFinderEvent& zf_event) {
+        /*
+         * An event is saved if it passes the denominator level in either
+         * electron order. If it passes the numerator level in only one
+         * order, that order is used for e0 and e1; otherwise tag 0, probe 1
+         * is preferred, as in ZDefinitionTree.
+         */
+        const cutlevel_vector* clv = zf_event.GetZDef(zdef_name_);
+        if (clv == nullptr || numerator_level_ < 0) {
+            return;
+        }
+        const ZFinderEvent::ZData& ZDATA = USE_MC_ ? zf_event.truth_z : zf_event.reco_z;
+        const ZFinderElectron* e0 = USE_MC_ ? zf_event.e0_truth : zf_event.e0;
+        const ZFinderElectron* e1 = USE_MC_ ? zf_event.e1_truth : zf_event.e1;
+        if (ZDATA.m <= -1 || e0 == nullptr || e1 == nullptr) {
+            return;
+        }
+
+        // Which electron orders pass each level
+        const CutLevel& NUMERATOR = (*clv)[numerator_level_].second;
+        bool den_t0p1 = true;
+        bool den_t1p0 = true;
+        double den_t0p1_eff = zf_event.event_weight;
+        double den_t1p0_eff = zf_event.event_weight;
+        if (denominator_level_ >= 0) {
+            const CutLevel& DENOMINATOR = (*clv)[denominator_level_].second;
+            den_t0p1 = DENOMINATOR.t0p1_pass;
+            den_t1p0 = DENOMINATOR.t1p0_pass;
+            den_t0p1_eff = DENOMINATOR.t0p1_eff;
+            den_t1p0_eff = DENOMINATOR.t1p0_eff;
+        }
+        if (!den_t0p1 && !den_t1p0) {
+            return;
+        }
+
+        row_struct row;
+        bool swapped = false;
+        if (NUMERATOR.t0p1_pass || NUMERATOR.t1p0_pass) {
+            row.numerator = 1;
+            swapped = !NUMERATOR.t0p1_pass;
+        }
+        else {
+            row.numerator = 0;
+            swapped = !den_t0p1;
+        }
+        if (NUMERATOR.t0p1_pass && NUMERATOR.t1p0_pass) {
+            row.degenerate = DEGENERATE_NUMERATOR;
+        }
+        else if (den_t0p1 && den_t1p0) {
+            row.degenerate = DEGENERATE_DENOMINATOR;
+        }
+        else {
+            row.degenerate = NOT_DEGENERATE;
+        }
+        if (swapped) {
+            std::swap(e0, e1);
+        }
+
+        // Truth events only get the natural weight of the MC, as in
+        // ZDefinitionWriter
+        if (USE_MC_) {
+            row.weight = zf_event.event_weight;
+        }
+        else {
+            row.weight = swapped ? den_t1p0_eff : den_t0p1_eff;
+        }
+
+        row.z_mass = ZDATA.m;
+        row.z_eta = ZDATA.eta;
+        row.z_y = ZDATA.y;
+        row.z_pt = ZDATA.pt;
+        row.phistar = ZDATA.phistar;
+        row.e0_pt = e0->pt();
+        row.e1_pt = e1->pt();
+        row.e0_eta = e0->eta();
+        row.e1_eta = e1->eta();
+        row.e0_charge = e0->charge();
+        row.e1_charge = e1->charge();
+        row.n_vert = USE_MC_ ? zf_event.truth_vert.num : zf_event.reco_vert.num;
+        row.event_num = zf_event.id.event_num;
+        row.data_type = DATA_TYPE_;
+        row.pass_all = clv->back().second.pass ? 1 : 0;
+
+        batch_.push_back(row);
+        if (batch_.size() >= BATCH_SIZE_) {
+            AppendBatch();
+        }
+    }
+
+    void ZDefinitionWorkspace::AppendBatch() {
+        for (auto& i_row : batch_) {
+            tree_row_ = i_row;
+            tree_->Fill();
+        }
+        batch_.clear();
+    }
+
+    void ZDefinitionWorkspace::Write() {
+        /*
+         * Only the store is written. Making the RooDataSet here would hold
+         * every event in memory a second time and write it to the file
+         * twice, and job outputs could not be merged, so it is made from
+         * the merged stores by scripts/make_workspace instead.
+         */
+        if (written_) {
+            return;
+        }
+        written_ = true;
+        AppendBatch();
+
+        tdir_.cd();
+        tree_->Write();
+        delete tree_;
+        tree_ = nullptr;
+    }
+}  // namespace zf
@@ -1,7 +1,7 @@
 #include "ZFinder/Event/interface/ZDefinitionWriter.h"
 
 // Standard Library
-#include <utility>  // std::make_pair
+#include <cstring>  // strncpy
 #include <sstream>  // std::ostringstream
 
 // ZFinder Code
@@ -10,16 +10,58 @@
 
 namespace zf {
     // Constructor
-    ZDefinitionWriter::ZDefinitionWriter(const ZDefinition& zdef, TFileDirectory& tdir, const bool USE_MC) : USE_MC_(USE_MC) {
+    ZDefinitionWriter::ZDefinitionWriter(
+            const ZDefinition& zdef,
+            TFileDirectory& tdir,
+            const bool USE_MC,
+            const std::vector<ZDefinitionWriter*>& previous,
+            const bool PREFILTERED
+            ) : USE_MC_(USE_MC), PREFILTERED_(PREFILTERED), n_shared_levels_(0), owns_all_events_plot_(true), all_events_plot_(nullptr), tdir_(tdir) {
         // Get the name of the cut we want
         zdef_name = zdef.NAME;
+        for (size_t i = 0; i < zdef.clv.size(); ++i) {
+            level_keys_.push_back(zdef.CutLevelKey(i));
+        }
+
+        // Find the previous writer that has the most cut levels in common
+        // with us
+        ZDefinitionWriter* shared_writer = nullptr;
+        for (auto& i_writer : previous) {
+            if (i_writer->USE_MC_ != USE_MC_) {
+                continue;
+            }
+            if (shared_writer == nullptr) {
+                shared_writer = i_writer;
+            }
+            size_t n_same = 0;
+            while (n_same < level_keys_.size()
+                    && n_same < i_writer->level_keys_.size()
+                    && level_keys_[n_same] == i_writer->level_keys_[n_same]) {
+                ++n_same;
+            }
+            if (n_same > n_shared_levels_) {
+                n_shared_levels_ = n_same;
+                shared_writer = i_writer;
+            }
+        }
 
-        // Add the "0 All Events" set of plots
+        // Add the "0 All Events" set of plots, which is the same for every
+        // ZDefinition. With the prefilter it only has the events that passed
+        // it, which the title says; the name is kept for the scripts.
         // Make our TFileDirectory for the plotter
-        TFileDirectory t_subdir_0 = tdir.mkdir("0 All Events", "0 All Events");
-        all_events_plot_ = new ZFinderPlotter(t_subdir_0, USE_MC_);
+        const std::string ALL_EVENTS_TITLE = PREFILTERED_ ? "0 All Events (prefiltered)" : "0 All Events";
+        TFileDirectory t_subdir_0 = tdir.mkdir("0 All Events", ALL_EVENTS_TITLE);
+        level_names_.push_back("0 All Events");
+        if (shared_writer != nullptr) {
+            all_events_plot_ = shared_writer->all_events_plot_;
+            all_events_plot_->AddDirectory(t_subdir_0);
+            owns_all_events_plot_ = false;
+        }
+        else {
+            all_events_plot_ = new ZFinderPlotter(t_subdir_0, USE_MC_);
+        }
 
-        // Fill zf_ploters
+        // Fill zf_plotters_
         // Cut names in the output start with this number and count up
         int counter = 1;
         for (auto& i_cutlevel : zdef.clv) {
@@ -29,67 +71,131 @@ namespace zf {
             std::ostringstream oss;
             oss << counter;
             std::string level_name = oss.str() + " " + CUT_NAME;
+            level_names_.push_back(level_name);
             ++counter;
 
             // Make our TFileDirectory for the plotter
             TFileDirectory t_subdir = tdir.mkdir(level_name.c_str(), level_name.c_str());
 
-            // Set up the plotter
-            ZFinderPlotter zf_plotter(t_subdir, USE_MC_);
-            std::pair<std::string, ZFinderPlotter> plot_pair(CUT_NAME, zf_plotter);
-            zf_plotters.insert(plot_pair);
+            // Set up the plotter, or reuse the one from the writer with the
+            // same cuts
+            const size_t I_LEVEL = zf_plotters_.size();
+            if (I_LEVEL < n_shared_levels_) {
+                ZFinderPlotter* zf_plotter = shared_writer->zf_plotters_[I_LEVEL];
+                zf_plotter->AddDirectory(t_subdir);
+                zf_plotters_.push_back(zf_plotter);
+            }
+            else {
+                zf_plotters_.push_back(new ZFinderPlotter(t_subdir, USE_MC_));
+            }
         }
+        cutflow_.resize(level_names_.size());
     }
 
     ZDefinitionWriter::~ZDefinitionWriter(){
-        // Clean up our pointer
-        delete all_events_plot_;
+        // Clean up our pointers, but not those owned by another writer
+        if (owns_all_events_plot_) {
+            delete all_events_plot_;
+        }
+        for (size_t i = n_shared_levels_; i < zf_plotters_.size(); ++i) {
+            delete zf_plotters_[i];
+        }
     }
 
     void ZDefinitionWriter::Fill(const ZFinderEvent& zf_event, const int electron_0, const int electron_1) {
         /*
          * We loop over the cutlevel_vector specified by the name given to use
          * by the zdef in the constructor. We then plot the event until it
-         * fails a cut, then we stop.
+         * fails a cut, then we stop. Plotters shared with another writer are
+         * skipped, since that writer fills them, but every level is counted
+         * in our cutflow.
          */
+        // If every plotter is shared there is nothing to plot
+        const bool HAS_OWN_PLOTS = owns_all_events_plot_ || n_shared_levels_ < zf_plotters_.size();
+
+        // The quantities plotted and their bins are the same at every cut
+        // level, so find them once
+        if (HAS_OWN_PLOTS) {
+            all_events_plot_->MakeEntries(zf_event, electron_0, electron_1, &entries_);
+        }
+
         // All events plot, which is always filled
         const double GEN_WEIGHT = zf_event.event_weight;
-        all_events_plot_->Fill(zf_event, electron_0, electron_1, GEN_WEIGHT);
+        Count(0, GEN_WEIGHT, GEN_WEIGHT);
+        if (owns_all_events_plot_) {
+            all_events_plot_->Fill(zf_event, entries_, GEN_WEIGHT);
+        }
 
         // Cutlevel_vector loop
         const cutlevel_vector* clv = zf_event.GetZDef(zdef_name);
         if (clv != nullptr) {
-            bool cont = true;
             // Loop over cuts until one fails
-            for (auto& i_cutlevel : *clv) {
-                const std::string CUT_NAME = i_cutlevel.first;
-                cont = i_cutlevel.second.pass && cont;
+            for (size_t i_level = 0; i_level < clv->size() && i_level < zf_plotters_.size(); ++i_level) {
+                const CutLevel& CUT_LEVEL = (*clv)[i_level].second;
                 // Check if cut fails, if it does break, otherwise fill the
                 // histogram associated with the cut
-                if (cont) {
-                    // We only want to apply the weights to reco events. For
-                    // gen level (when USE_MC_ is set to true, we only want the
-                    // "natural weight" of the MC events, which is the GEN_WEIGHT.
-                    double weight = GEN_WEIGHT;
-                    if (!USE_MC_) {
-                        if (i_cutlevel.second.t0p1_pass) {
-                            weight = i_cutlevel.second.t0p1_eff;
-                        }
-                        else if (i_cutlevel.second.t1p0_pass) {
-                            weight = i_cutlevel.second.t1p0_eff;
-                        }
+                if (!CUT_LEVEL.pass) {  // We stop at the first failed cut
+                    break;
+                }
+                // We only want to apply the weights to reco events. For
+                // gen level (when USE_MC_ is set to true, we only want the
+                // "natural weight" of the MC events, which is the GEN_WEIGHT.
+                double weight = GEN_WEIGHT;
+                if (!USE_MC_) {
+                    if (CUT_LEVEL.t0p1_pass) {
+                        weight = CUT_LEVEL.t0p1_eff;
                     }
-                    // Fill the plot
-                    auto i_map_plotter = zf_plotters.find(CUT_NAME);
-                    if (i_map_plotter != zf_plotters.end()) {
-                        i_map_plotter->second.Fill(zf_event, electron_0, electron_1, weight);
+                    else if (CUT_LEVEL.t1p0_pass) {
+                        weight = CUT_LEVEL.t1p0_eff;
                     }
                 }
-                else {  // We stop at the first failed cut
-                    break;
+                Count(i_level + 1, GEN_WEIGHT, weight);
+                if (i_level < n_shared_levels_) {
+                    continue;
                 }
+                // Fill the plot
+                zf_plotters_[i_level]->Fill(zf_event, entries_, weight);
             }
         }
     }
 
+    void ZDefinitionWriter::Write() {
+        if (owns_all_events_plot_) {
+            all_events_plot_->Write();
+        }
+        for (size_t i = n_shared_levels_; i < zf_plotters_.size(); ++i) {
+            zf_plotters_[i]->Write();
+        }
+
+        // One row per cut level. Merged files have one set of rows per job,
+        // which readers sum by level.
+        tdir_.cd();
+        TTree* cutflow_tree = new TTree("cutflow", PREFILTERED_ ? "cutflow (prefiltered)" : "cutflow");
+        int level;
+        char name[256];
+        cutflow_counter counter;
+        cutflow_tree->Branch("level", &level, "level/I");
+        cutflow_tree->Branch("name", name, "name/C");
+        cutflow_tree->Branch("n_raw", &counter.n_raw, "n_raw/L");
+        cutflow_tree->Branch("sum_weight", &counter.sum_weight, "sum_weight/D");
+        cutflow_tree->Branch("sum_full_weight", &counter.sum_full_weight, "sum_full_weight/D");
+        cutflow_tree->Branch("sum_full_weight2", &counter.sum_full_weight2, "sum_full_weight2/D");
+        for (size_t i = 0; i < cutflow_.size(); ++i) {
+            level = i;
+            strncpy(name, level_names_[i].c_str(), sizeof(name) - 1);
+            name[sizeof(name) - 1] = '\0';
+            counter = cutflow_[i];
+            cutflow_tree->Fill();
+        }
+        cutflow_tree->Write();
+        delete cutflow_tree;
+    }
+
+    void ZDefinitionWriter::Count(const size_t I_LEVEL, const double WEIGHT, const double FULL_WEIGHT) {
+        cutflow_counter& counter = cutflow_[I_LEVEL];
+        ++counter.n_raw;
+        counter.sum_weight += WEIGHT;
+        counter.sum_full_weight += FULL_WEIGHT;
+        counter.sum_full_weight2 += FULL_WEIGHT * FULL_WEIGHT;
+    }
 }  // namespace zf
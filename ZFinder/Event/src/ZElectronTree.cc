@@ -0,0 +1,151 @@
+#include "ZFinder/Event/interface/ZElectronTree.h"
+
+// Standard Library
+#include <sstream>  // std::ostringstream
+#include <string>  // std::string
+
+// ZFinder Code
+#include "ZFinder/Event/interface/CutBits.h"  // CUT_BIT_NAMES, CUT_BIT_WEIGHTED_NAMES
+
+
+namespace zf {
+    // Constructor
+    ZElectronTree::ZElectronTree(TFileDirectory& tdir, const bool IS_MC) : IS_MC_(IS_MC) {
+        // Make sure our bitmask is big enough to hold every cut
+        if (static_cast<int>(CUT_BIT_NAMES.size()) > MAX_CUT_BITS) {
+            throw "In ZElectronTree, CUT_BIT_NAMES has more than MAX_CUT_BITS entries!";
+        }
+
+        // Make the directory to save files to
+        tdir.cd();
+
+        // Make the Tree to write to
+        tree_ = new TTree("electrons", "electrons");
+        const std::string ELEC_CODE = "e_pt[2]/F:e_eta[2]:e_phi[2]:e_rnine[2]:e_charge[2]/I";
+        const std::string Z_CODE = "z_m/F:z_y:z_phistar:z_pt";
+        tree_->Branch("reco", &reco_, ELEC_CODE.c_str());
+        tree_->Branch("reco_z", &reco_z_, Z_CODE.c_str());
+        tree_->Branch("trig", &trig_, ELEC_CODE.c_str());
+        if (IS_MC_) {
+            tree_->Branch("truth", &truth_, ELEC_CODE.c_str());
+            tree_->Branch("truth_z", &truth_z_, Z_CODE.c_str());
+        }
+        tree_->Branch("cut_bits", cut_bits_, "cut_bits[2]/l");
+        tree_->Branch("cut_known", cut_known_, "cut_known[2]/l");
+        std::ostringstream weight_code;
+        weight_code << "cut_weights[2][" << N_WEIGHTED_CUTS << "]/F";
+        tree_->Branch("cut_weights", cut_weights_, weight_code.str().c_str());
+        tree_->Branch("event_weight", &event_weight_, "event_weight/D");
+        const std::string EVENT_CODE = "event_number/i:run_number:lumi_number:is_mc/O";
+        tree_->Branch("event_info", &event_, EVENT_CODE.c_str());
+    }
+
+    ZElectronTree::~ZElectronTree() {
+        // Clean up our pointer
+        delete tree_;
+    }
+
+    void ZElectronTree::Fill(const ZFinderEvent& zf_event) {
+        // Clear our branches
+        reco_.clear_values();
+        truth_.clear_values();
+        trig_.clear_values();
+        reco_z_.clear_values();
+        truth_z_.clear_values();
+        event_.clear_values();
+        for (int i = 0; i < 2; ++i) {
+            cut_bits_[i] = 0;
+            cut_known_[i] = 0;
+            for (int j = 0; j < N_WEIGHTED_CUTS; ++j) {
+                cut_weights_[i][j] = 1.;
+            }
+        }
+
+        // Reco
+        if (zf_event.e0 != nullptr) {
+            FillElectron(*zf_event.e0, 0, &reco_);
+            FillCuts(*zf_event.e0, 0);
+        }
+        if (zf_event.e1 != nullptr) {
+            FillElectron(*zf_event.e1, 1, &reco_);
+            FillCuts(*zf_event.e1, 1);
+        }
+        reco_z_.z_m = zf_event.reco_z.m;
+        reco_z_.z_y = zf_event.reco_z.y;
+        reco_z_.z_phistar = zf_event.reco_z.phistar;
+        reco_z_.z_pt = zf_event.reco_z.pt;
+
+        // Trigger
+        if (zf_event.e0_trig != nullptr) {
+            FillElectron(*zf_event.e0_trig, 0, &trig_);
+        }
+        if (zf_event.e1_trig != nullptr) {
+            FillElectron(*zf_event.e1_trig, 1, &trig_);
+        }
+
+        // Truth
+        if (IS_MC_ && !zf_event.is_real_data) {
+            if (zf_event.e0_truth != nullptr) {
+                FillElectron(*zf_event.e0_truth, 0, &truth_);
+            }
+            if (zf_event.e1_truth != nullptr) {
+                FillElectron(*zf_event.e1_truth, 1, &truth_);
+            }
+            truth_z_.z_m = zf_event.truth_z.m;
+            truth_z_.z_y = zf_event.truth_z.y;
+            truth_z_.z_phistar = zf_event.truth_z.phistar;
+            truth_z_.z_pt = zf_event.truth_z.pt;
+        }
+
+        // General Event info
+        event_weight_ = zf_event.event_weight;
+        event_.is_mc = !zf_event.is_real_data;
+        event_.event_number = zf_event.id.event_num;
+        event_.run_number = zf_event.id.run_num;
+        event_.lumi_number = zf_event.id.lumi_num;
+
+        tree_->Fill();
+    }
+
+    void ZElectronTree::FillElectron(
+            const ZFinderElectron& ZF_ELEC,
+            const int I_ELEC,
+            electron_branch* branch
+            ) {
+        branch->pt[I_ELEC] = ZF_ELEC.pt();
+        branch->eta[I_ELEC] = ZF_ELEC.eta();
+        branch->phi[I_ELEC] = ZF_ELEC.phi();
+        branch->rnine[I_ELEC] = ZF_ELEC.r9();
+        branch->charge[I_ELEC] = ZF_ELEC.charge();
+    }
+
+    void ZElectronTree::FillCuts(const ZFinderElectron& ZF_ELEC, const int I_ELEC) {
+        /*
+         * Set a bit for every cut the electron has a result for, and a second
+         * bit if it passed. Then save the weights of the cuts that have scale
+         * factors.
+         */
+        for (unsigned int i_bit = 0; i_bit < CUT_BIT_NAMES.size(); ++i_bit) {
+            const CutResult* cr = ZF_ELEC.GetCutResult(CUT_BIT_NAMES[i_bit]);
+            if (cr != nullptr) {
+                const ULong64_t BIT = 1ULL << i_bit;
+                cut_known_[I_ELEC] |= BIT;
+                if (cr->passed) {
+                    cut_bits_[I_ELEC] |= BIT;
+                }
+            }
+        }
+        for (int i_weight = 0; i_weight < N_WEIGHTED_CUTS; ++i_weight) {
+            const double WEIGHT = ZF_ELEC.CutWeight(CUT_BIT_WEIGHTED_NAMES[i_weight]);
+            // CutWeight returns -1 if there is no result, which ZDefinition
+            // treats as a weight of 1
+            if (WEIGHT >= 0.) {
+                cut_weights_[I_ELEC][i_weight] = WEIGHT;
+            }
+        }
+    }
+
+    TFile* ZElectronTree::GetCurrentFile() {
+        return tree_->GetCurrentFile();
+    }
+}  // namespace zf
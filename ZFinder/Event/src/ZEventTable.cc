@@ -0,0 +1,194 @@
+#include "ZFinder/Event/interface/ZEventTable.h"
+
+// Standard Library
+#include <algorithm>  // std::copy
+#include <cstring>  // strncpy
+
+// ZFinder Code
+#include "ZFinder/Event/interface/CutLevel.h"  // cutlevel_vector
+#include "ZFinder/Event/interface/WeightID.h"  // WeightID
+#include "ZFinder/Event/interface/ZDefinitionTree.h"  // ZDefinitionTree::GetCutWeights
+
+
+namespace zf {
+    namespace {
+        // Grow buffer to at least SIZE members, and if that moved it point
+        // the branch NAME at its new memory
+        template<typename T>
+        void GrowBuffer(TTree* tree, const char* NAME, const size_t SIZE, std::vector<T>* buffer) {
+            if (buffer->size() < SIZE) {
+                buffer->resize(SIZE);
+                tree->SetBranchAddress(NAME, &(*buffer)[0]);
+            }
+        }
+    }
+
+    // Constructor
+    ZEventTable::ZEventTable(
+            const std::vector<ZDefinition*>& zdefs,
+            TFileDirectory& tdir,
+            const bool IS_MC
+            ) : IS_MC_(IS_MC) {
+        if (static_cast<int>(zdefs.size()) > MAX_ZDEFS_) {
+            throw "In ZEventTable, there are more ZDefinitions than bits in zdef_pass!";
+        }
+        for (auto& i_zdef : zdefs) {
+            zdef_names_.push_back(i_zdef->NAME);
+        }
+
+        // Make the directory to save files to
+        tdir.cd();
+
+        // Save the name of the ZDefinition for each bit
+        TTree* zdef_tree = new TTree("zdefs", "zdefs");
+        int index;
+        char name[256];
+        zdef_tree->Branch("index", &index, "index/I");
+        zdef_tree->Branch("name", name, "name/C");
+        for (unsigned int i = 0; i < zdef_names_.size(); ++i) {
+            index = i;
+            strncpy(name, zdef_names_[i].c_str(), sizeof(name) - 1);
+            name[sizeof(name) - 1] = '\0';
+            zdef_tree->Fill();
+        }
+        // index and name go out of scope; the tree must not keep pointing
+        // at them when it is written or deleted
+        zdef_tree->ResetBranchAddresses();
+
+        // Start with one member so that the branches have an address
+        weights_cteq_.resize(1);
+        weights_mstw_.resize(1);
+        weights_nnpdf_.resize(1);
+        zdef_weight_zdefs_.resize(1);
+        zdef_weight_ids_.resize(1);
+        zdef_weights_.resize(1);
+
+        // Make the Tree to write to
+        tree_ = new TTree("events", "events");
+        tree_->Branch("reco", &reco_, BRANCH_STRUCT_CODE);
+        if (IS_MC_) {
+            tree_->Branch("truth", &truth_, BRANCH_STRUCT_CODE);
+        }
+        tree_->Branch("event_info", &event_, EVENT_BRANCH_CODE);
+        tree_->Branch("zdef_pass", &zdef_pass_, "zdef_pass/l");
+        tree_->Branch("zdef_t0p1", &zdef_t0p1_, "zdef_t0p1/l");
+        tree_->Branch("zdef_t1p0", &zdef_t1p0_, "zdef_t1p0/l");
+        if (IS_MC_) {
+            tree_->Branch("weight_size", &weight_size_, "weight_size/I");
+            tree_->Branch("weights", weights_, "weights[weight_size]/D");
+            tree_->Branch("weight_ids", weight_ids_, "weight_ids[weight_size]/I");
+            tree_->Branch("weight_cteq_size", &weight_cteq_size_, "weight_cteq_size/I");
+            tree_->Branch("weights_cteq", &weights_cteq_[0], "weights_cteq[weight_cteq_size]/D");
+            tree_->Branch("weight_mstw_size", &weight_mstw_size_, "weight_mstw_size/I");
+            tree_->Branch("weights_mstw", &weights_mstw_[0], "weights_mstw[weight_mstw_size]/D");
+            tree_->Branch("weight_nnpdf_size", &weight_nnpdf_size_, "weight_nnpdf_size/I");
+            tree_->Branch("weights_nnpdf", &weights_nnpdf_[0], "weights_nnpdf[weight_nnpdf_size]/D");
+            tree_->Branch("weight_fsr", &weight_fsr_, "weight_fsr/D");
+            tree_->Branch("zdef_weight_size", &zdef_weight_size_, "zdef_weight_size/I");
+            tree_->Branch("zdef_weight_zdefs", &zdef_weight_zdefs_[0], "zdef_weight_zdefs[zdef_weight_size]/I");
+            tree_->Branch("zdef_weight_ids", &zdef_weight_ids_[0], "zdef_weight_ids[zdef_weight_size]/I");
+            tree_->Branch("zdef_weights", &zdef_weights_[0], "zdef_weights[zdef_weight_size]/D");
+        }
+    }
+
+    ZEventTable::~ZEventTable() {
+        // Clean up our pointer
+        delete tree_;
+    }
+
+    void ZEventTable::Fill(const ZFinderEvent& zf_event) {
+        // Fill only if there is a good Z in either truth or reco
+        if (zf_event.truth_z.m <= -1 && zf_event.reco_z.m <= -1) {
+            return;
+        }
+
+        // Find the ZDefinitions the event passes, and save their weights
+        zdef_pass_ = 0;
+        zdef_t0p1_ = 0;
+        zdef_t1p0_ = 0;
+        std::vector<std::pair<int, double>> weight_id_vector;
+        std::vector<int> weight_zdef_vector;
+        for (unsigned int i_zdef = 0; i_zdef < zdef_names_.size(); ++i_zdef) {
+            if (!zf_event.ZDefPassed(zdef_names_[i_zdef])) {
+                continue;
+            }
+            const ULong64_t BIT = 1ULL << i_zdef;
+            zdef_pass_ |= BIT;
+            const cutlevel_vector* clv = zf_event.GetZDef(zdef_names_[i_zdef]);
+            if (clv != nullptr) {
+                if (clv->back().second.t0p1_pass) {
+                    zdef_t0p1_ |= BIT;
+                }
+                if (clv->back().second.t1p0_pass) {
+                    zdef_t1p0_ |= BIT;
+                }
+                if (IS_MC_) {
+                    ZDefinitionTree::GetCutWeights(clv, &weight_id_vector);
+                    weight_zdef_vector.resize(weight_id_vector.size(), i_zdef);
+                }
+            }
+        }
+
+        // If the event passes no ZDefinition there is nothing to save
+        if (zdef_pass_ == 0) {
+            return;
+        }
+
+        // Clear our branches
+        reco_.clear_values();
+        truth_.clear_values();
+        event_.clear_values();
+
+        // Set the weights
+        if (IS_MC_) {
+            const std::vector<std::pair<int, double>> EVENT_WEIGHTS = {
+                std::make_pair(WeightID::GEN_MC, zf_event.weight_natural_mc),
+                std::make_pair(WeightID::PILEUP, zf_event.weight_vertex),
+                std::make_pair(WeightID::PILEUP_PLUS, zf_event.weight_vertex_plus),
+                std::make_pair(WeightID::PILEUP_MINUS, zf_event.weight_vertex_minus)
+            };
+            weight_size_ = EVENT_WEIGHTS.size();
+            for (int i = 0; i < weight_size_; ++i) {
+                weight_ids_[i] = EVENT_WEIGHTS[i].first;
+                weights_[i] = EVENT_WEIGHTS[i].second;
+            }
+
+            zdef_weight_size_ = weight_id_vector.size();
+            GrowBuffer(tree_, "zdef_weight_zdefs", zdef_weight_size_, &zdef_weight_zdefs_);
+            GrowBuffer(tree_, "zdef_weight_ids", zdef_weight_size_, &zdef_weight_ids_);
+            GrowBuffer(tree_, "zdef_weights", zdef_weight_size_, &zdef_weights_);
+            for (int i = 0; i < zdef_weight_size_; ++i) {
+                zdef_weight_zdefs_[i] = weight_zdef_vector[i];
+                zdef_weight_ids_[i] = weight_id_vector[i].first;
+                zdef_weights_[i] = weight_id_vector[i].second;
+            }
+
+            weight_cteq_size_ = zf_event.weights_cteq.size();
+            GrowBuffer(tree_, "weights_cteq", weight_cteq_size_, &weights_cteq_);
+            std::copy(zf_event.weights_cteq.begin(), zf_event.weights_cteq.end(), weights_cteq_.begin());
+            weight_mstw_size_ = zf_event.weights_mstw.size();
+            GrowBuffer(tree_, "weights_mstw", weight_mstw_size_, &weights_mstw_);
+            std::copy(zf_event.weights_mstw.begin(), zf_event.weights_mstw.end(), weights_mstw_.begin());
+            weight_nnpdf_size_ = zf_event.weights_nnpdf.size();
+            GrowBuffer(tree_, "weights_nnpdf", weight_nnpdf_size_, &weights_nnpdf_);
+            std::copy(zf_event.weights_nnpdf.begin(), zf_event.weights_nnpdf.end(), weights_nnpdf_.begin());
+
+            weight_fsr_ = zf_event.weight_fsr;
+        }
+
+        // Reco and Truth
+        reco_.fill(zf_event, false);
+        if (IS_MC_ && !zf_event.is_real_data) {
+            truth_.fill(zf_event, true);
+        }
+
+        // General Event info
+        event_.fill(zf_event);
+
+        tree_->Fill();
+    }
+
+    TFile* ZEventTable::GetCurrentFile() {
+        return tree_->GetCurrentFile();
+    }
+}  // namespace zf
@@ -23,9 +23,11 @@ Implementation:
 
 // standard library files
 #include <algorithm>  // std::find
+#include <cmath>  // fabs
 #include <map>  // std::map
 #include <string>  // std::string
-#include <utility>  // std::pair
+#include <utility>  // std::pair, std::make_pair
+#include <vector>  // std::vector
 
 // user include files
 #include "FWCore/Framework/interface/Frameworkfwd.h"
@@ -37,6 +39,8 @@ Implementation:
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 
 // CMSSW
+#include "DataFormats/Common/interface/Handle.h"  // edm::Handle
+#include "FWCore/Utilities/interface/InputTag.h"  // edm::InputTag
 #include "FWCore/ServiceRegistry/interface/Service.h" // edm::Service
 #include "CommonTools/UtilAlgos/interface/TFileService.h" // TFileService
 
@@ -47,6 +51,8 @@ Implementation:
 
 // Electrons
 #include "DataFormats/EgammaCandidates/interface/GsfElectron.h"  // GsfElectron
+#include "DataFormats/EgammaCandidates/interface/PhotonFwd.h"  // reco::PhotonCollection
+#include "DataFormats/RecoCandidate/interface/RecoEcalCandidateFwd.h"  // reco::RecoEcalCandidateCollection
 #include "SimDataFormats/GeneratorProducts/interface/HepMCProduct.h"  // GenParticle
 
 // Root
@@ -54,12 +60,17 @@ Implementation:
 
 // ZFinder
 #include "ZFinder/Event/interface/AcceptanceSetter.h"  // AcceptanceSetter
+#include "ZFinder/Event/interface/AsyncTreeWriter.h"  // AsyncTreeWriter
+#include "ZFinder/Event/interface/CompactZFinderEvent.h"  // CompactZFinderEvent
 #include "ZFinder/Event/interface/SetterBase.h"  // SetterBase
 #include "ZFinder/Event/interface/TruthMatchSetter.h"  // TruthMatchSetter
 #include "ZFinder/Event/interface/ZDefinition.h"  // ZDefinition
 #include "ZFinder/Event/interface/ZDefinitionTree.h"  // ZDefinitionTree
+#include "ZFinder/Event/interface/ZDefinitionWorkspace.h"  // ZDefinitionWorkspace
 #include "ZFinder/Event/interface/ZDefinitionWriter.h"  // ZDefinitionWriter
 #include "ZFinder/Event/interface/ZEfficiencies.h" // ZEfficiencies
+#include "ZFinder/Event/interface/ZElectronTree.h"  // ZElectronTree
+#include "ZFinder/Event/interface/ZEventTable.h"  // ZEventTable
 #include "ZFinder/Event/interface/ZFinderEvent.h"  // ZFinderEvent
 #include "ZFinder/Event/interface/ZTriggerEfficiencies.h" // ZTriggerEfficiencies
 
@@ -92,12 +103,30 @@ class ZFinder : public edm::EDAnalyzer {
         std::vector<zf::ZDefinition*> zdefs_;
         std::vector<zf::ZDefinitionWriter*> zdef_plotters_;
         std::vector<zf::ZDefinitionTree*> zdef_tuples_;
+        std::vector<zf::ZDefinitionWorkspace*> zdef_workspaces_;
+        zf::AsyncTreeWriter* tree_writer_;
+        zf::ZElectronTree* electron_tuple_;
+        zf::ZEventTable* event_table_;
+        edm::InputTag zfinder_event_tag_;
         zf::ZEfficiencies zeffs_;
         zf::ZTriggerEfficiencies ztrgeffs_;
         bool is_mc_;
         TH1I* unweighted_counter_;
         TH1D* weighted_counter_;
 
+        // Early rejection of data events that can not pass any ZDefinition,
+        // checked before building the ZFinderEvent
+        bool PassPrefilter(const edm::Event& iEvent) const;
+        bool use_prefilter_;
+        // The smallest pt and largest |eta| (or -1 for any) an electron
+        // needs to pass each cut set of a ZDefinition
+        struct prefilter_cuts {
+            double min_pt[2];
+            double max_abs_eta[2];
+        };
+        std::vector<prefilter_cuts> prefilter_cuts_;
+        TH1I* prefiltered_counter_;
+
 };
 
 //
@@ -111,12 +140,16 @@ class ZFinder : public edm::EDAnalyzer {
 //
 // constructors and destructor
 //
-ZFinder::ZFinder(const edm::ParameterSet& iConfig) : iConfig_(iConfig) {
+ZFinder::ZFinder(const edm::ParameterSet& iConfig) : iConfig_(iConfig), tree_writer_(nullptr), electron_tuple_(nullptr), event_table_(nullptr), prefiltered_counter_(nullptr) {
     //now do what ever initialization is needed
 
     // is_mc_ is used to determine if we should make truth objects
     is_mc_ = iConfig.getParameter<bool>("is_mc");
 
+    // If set, read the event built by ZFinderEventProducer instead of
+    // building it here
+    zfinder_event_tag_ = iConfig.getUntrackedParameter<edm::InputTag>("zfinderEventInputTag", edm::InputTag());
+
     // Setup Cut Setters
     zf::AcceptanceSetter* accset = new zf::AcceptanceSetter();
     setters_.push_back(accset);
@@ -139,6 +172,53 @@ ZFinder::ZFinder(const edm::ParameterSet& iConfig) : iConfig_(iConfig) {
 
     // Setup ZDefinitions and plotters
     zdef_psets_ = iConfig.getUntrackedParameter<std::vector<edm::ParameterSet> >("ZDefinitions");
+    // With the prefilter (see below) the plots only get the events that pass
+    // it, which the writers note in their titles
+    use_prefilter_ = iConfig.getUntrackedParameter<bool>("use_prefilter", false)
+        && !is_mc_
+        && zfinder_event_tag_.label().empty()
+        && !zdef_psets_.empty();
+    // Either save one tree per ZDefinition, or a single table of events
+    // with a ZDefinition pass bitmask
+    const bool USE_EVENT_TABLE = iConfig.getUntrackedParameter<bool>("use_event_table", false);
+    std::vector<zf::ZDefinition*> reco_zdefs;
+    zf::ZDefinitionTree::TreeLayout tree_layout;
+    tree_layout.split_branches = iConfig.getUntrackedParameter<bool>("tree_split_branches", false);
+    tree_layout.basket_size = iConfig.getUntrackedParameter<int>("tree_basket_size", 32000);
+    tree_layout.compression = iConfig.getUntrackedParameter<int>("tree_compression", -1);
+    tree_layout.weight_compression = iConfig.getUntrackedParameter<int>("tree_weight_compression", -1);
+    tree_layout.compact_pdf_weights = iConfig.getUntrackedParameter<bool>("tree_compact_pdf_weights", false);
+    tree_layout.event_index = iConfig.getUntrackedParameter<bool>("tree_event_index", false);
+    tree_layout.columnar_dir = iConfig.getUntrackedParameter<std::string>("tree_columnar_dir", "");
+    tree_layout.columnar_group_by_run = iConfig.getUntrackedParameter<bool>("tree_columnar_group_by_run", false);
+    // Optionally save the selected events of each ZDefinition in a
+    // RooWorkspace, appending them to the output file in batches
+    const bool STORE_WORKSPACES = iConfig.getUntrackedParameter<bool>("store_workspaces", false);
+    const int WORKSPACE_BATCH_SIZE = iConfig.getUntrackedParameter<int>("workspace_batch_size", 1000);
+    const bool STORE_ELECTRON_CUTS = iConfig.getUntrackedParameter<bool>("store_electron_cuts", false);
+    // Optionally fill the ZDefinition trees on a separate I/O thread, with at
+    // most tree_writer_slots events waiting to be written. The workspace and
+    // electron trees are filled in analyze and write to the same TFile, which
+    // two threads can not do at once, so the writer is not used with them.
+    const int TREE_WRITER_SLOTS = iConfig.getUntrackedParameter<int>("tree_writer_slots", 0);
+    // The event table has a single fixed layout and is always filled in the
+    // event loop, so none of the ZDefinitionTree options apply to it
+    const zf::ZDefinitionTree::TreeLayout DEFAULT_LAYOUT;
+    if (USE_EVENT_TABLE && (
+                tree_layout.split_branches != DEFAULT_LAYOUT.split_branches
+                || tree_layout.basket_size != DEFAULT_LAYOUT.basket_size
+                || tree_layout.compression != DEFAULT_LAYOUT.compression
+                || tree_layout.weight_compression != DEFAULT_LAYOUT.weight_compression
+                || tree_layout.compact_pdf_weights != DEFAULT_LAYOUT.compact_pdf_weights
+                || tree_layout.event_index != DEFAULT_LAYOUT.event_index
+                || tree_layout.columnar_dir != DEFAULT_LAYOUT.columnar_dir
+                || tree_layout.columnar_group_by_run != DEFAULT_LAYOUT.columnar_group_by_run
+                || TREE_WRITER_SLOTS > 0)) {
+        throw "In ZFinder, use_event_table can not be combined with the tree_* options!";
+    }
+    if (TREE_WRITER_SLOTS > 0 && !USE_EVENT_TABLE && !STORE_WORKSPACES && !STORE_ELECTRON_CUTS) {
+        tree_writer_ = new zf::AsyncTreeWriter(TREE_WRITER_SLOTS);
+    }
     for (auto& i_pset : zdef_psets_) {
         // Unpack each of the zdef_psets and set up the variables to make both
         // a reco and a truth set
@@ -150,14 +230,19 @@ ZFinder::ZFinder(const edm::ParameterSet& iConfig) : iConfig_(iConfig) {
         bool use_truth_mass = i_pset.getUntrackedParameter<bool>("use_truth_mass");
 
         // Now we make the ZDefs for Reco/Truth, and use those to set up the
-        // plotters.
+        // plotters. Plotters for cut levels that an earlier ZDefinition
+        // already has are shared with it.
         // Reco
         zf::ZDefinition* zd_reco = new zf::ZDefinition(name_reco, cuts0, cuts1, min_mz, max_mz, use_truth_mass);
         zdefs_.push_back(zd_reco);
+        reco_zdefs.push_back(zd_reco);
         TFileDirectory tdir_zd(fs->mkdir(name_reco));
         bool use_truth = false;
-        zf::ZDefinitionWriter* zdwriter_reco = new zf::ZDefinitionWriter(*zd_reco, tdir_zd, use_truth);
+        zf::ZDefinitionWriter* zdwriter_reco = new zf::ZDefinitionWriter(*zd_reco, tdir_zd, use_truth, zdef_plotters_, use_prefilter_);
         zdef_plotters_.push_back(zdwriter_reco);
+        if (STORE_WORKSPACES) {
+            zdef_workspaces_.push_back(new zf::ZDefinitionWorkspace(*zd_reco, tdir_zd, use_truth, is_mc_, WORKSPACE_BATCH_SIZE));
+        }
 
         if (is_mc_) {
             std::string name_truth = i_pset.getUntrackedParameter<std::string>("name") + " MC";
@@ -166,15 +251,52 @@ ZFinder::ZFinder(const edm::ParameterSet& iConfig) : iConfig_(iConfig) {
             zdefs_.push_back(zd_truth);
             TFileDirectory tdir_zd_truth(fs->mkdir(name_truth));
             use_truth = true;
-            zf::ZDefinitionWriter* zdwriter_truth = new zf::ZDefinitionWriter(*zd_truth, tdir_zd_truth, use_truth);
+            zf::ZDefinitionWriter* zdwriter_truth = new zf::ZDefinitionWriter(*zd_truth, tdir_zd_truth, use_truth, zdef_plotters_, use_prefilter_);
             zdef_plotters_.push_back(zdwriter_truth);
+            if (STORE_WORKSPACES) {
+                zdef_workspaces_.push_back(new zf::ZDefinitionWorkspace(*zd_truth, tdir_zd_truth, use_truth, is_mc_, WORKSPACE_BATCH_SIZE));
+            }
         }
 
         // We use zd_reco, but that's only because both the "reco" and
         // "truth" quantities are stored in the same Tree, so there is no
         // need to make a second tree like there is with the plots.
-        zf::ZDefinitionTree* zdtree = new zf::ZDefinitionTree(*zd_reco, tdir_zd, is_mc_);
-        zdef_tuples_.push_back(zdtree);
+        if (!USE_EVENT_TABLE) {
+            zf::ZDefinitionTree* zdtree = new zf::ZDefinitionTree(*zd_reco, tdir_zd, is_mc_, tree_layout, tree_writer_);
+            zdef_tuples_.push_back(zdtree);
+        }
+    }
+    if (USE_EVENT_TABLE) {
+        TFileDirectory tdir_table(fs->mkdir("Event Table"));
+        event_table_ = new zf::ZEventTable(reco_zdefs, tdir_table, is_mc_);
+    }
+
+    // Optionally skip events before building the ZFinderEvent if their raw
+    // electron candidates can not pass any ZDefinition: an event needs two
+    // candidates, one within the pt and eta requirements of cuts0 and the
+    // other within those of cuts1. This is only done for data, because in MC
+    // the generator level plots need every event.
+    if (use_prefilter_) {
+        for (auto& i_zdef : zdefs_) {
+            prefilter_cuts cuts;
+            for (int i_cutset = 0; i_cutset < 2; ++i_cutset) {
+                cuts.min_pt[i_cutset] = i_zdef->MinimumPt(i_cutset);
+                cuts.max_abs_eta[i_cutset] = i_zdef->MaximumAbsEta(i_cutset);
+            }
+            prefilter_cuts_.push_back(cuts);
+        }
+        // Skipped events are still counted by unweighted_counter_ and
+        // weighted_counter_; this records how many there were
+        prefiltered_counter_ = fs->make<TH1I>("prefiltered_counter", "Prefiltered Event Count", 3, 0, 2);
+        prefiltered_counter_->GetXaxis()->SetTitle("");
+        prefiltered_counter_->GetYaxis()->SetTitle("Number of events skipped by the prefilter");
+    }
+
+    // Optionally save the electrons and all their cut results so that new
+    // ZDefinitions can be applied to the output later
+    if (STORE_ELECTRON_CUTS) {
+        TFileDirectory tdir_elec(fs->mkdir("Electron Cuts"));
+        electron_tuple_ = new zf::ZElectronTree(tdir_elec, is_mc_);
     }
 }
 
@@ -192,9 +314,16 @@ ZFinder::~ZFinder() {
     for (auto& i_zdefp : zdef_plotters_) {
         delete i_zdefp;
     }
+    // Stop the I/O thread before deleting the trees it fills
+    delete tree_writer_;
     for (auto& i_zdeft : zdef_tuples_) {
         delete i_zdeft;
     }
+    for (auto& i_zdefw : zdef_workspaces_) {
+        delete i_zdefw;
+    }
+    delete electron_tuple_;
+    delete event_table_;
 }
 
 
@@ -209,8 +338,26 @@ void ZFinder::analyze(const edm::Event& iEvent, const edm::EventSetup& iSetup) {
     // We count every event, even if they do not pass any cuts
     unweighted_counter_->Fill(1);
 
-    // Construct a ZFinderEvent
-    zf::ZFinderEvent zfe(iEvent, iSetup, iConfig_);
+    // Skip events that can not make a Z for any ZDefinition. These are data,
+    // so the natural weight is 1.
+    if (use_prefilter_ && !PassPrefilter(iEvent)) {
+        weighted_counter_->Fill(1, 1.);
+        prefiltered_counter_->Fill(1);
+        return;
+    }
+
+    // Construct a ZFinderEvent, either from the shared product or from
+    // scratch
+    zf::ZFinderEvent* zfe_ptr = nullptr;
+    if (zfinder_event_tag_.label().empty()) {
+        zfe_ptr = new zf::ZFinderEvent(iEvent, iSetup, iConfig_);
+    }
+    else {
+        edm::Handle<zf::CompactZFinderEvent> compact_h;
+        iEvent.getByLabel(zfinder_event_tag_, compact_h);
+        zfe_ptr = new zf::ZFinderEvent(*compact_h);
+    }
+    zf::ZFinderEvent& zfe = *zfe_ptr;
 
     // For MC, some events are weighted even without any additional
     // reweighting, so we count those, again, even if they don't pass any cuts.
@@ -231,6 +378,10 @@ void ZFinder::analyze(const edm::Event& iEvent, const edm::EventSetup& iSetup) {
             zeffs_.SetWeights(&zfe);
             ztrgeffs_.SetWeights(&zfe);
         }
+        // Save the electrons for reselection
+        if (electron_tuple_ != nullptr) {
+            electron_tuple_->Fill(zfe);
+        }
         // Set all ZDefs
         for (auto& i_zdef : zdefs_) {
             i_zdef->ApplySelection(&zfe);
@@ -243,7 +394,84 @@ void ZFinder::analyze(const edm::Event& iEvent, const edm::EventSetup& iSetup) {
         for (auto& i_zdeft : zdef_tuples_) {
             i_zdeft->Fill(zfe);
         }
+        for (auto& i_zdefw : zdef_workspaces_) {
+            i_zdefw->Fill(zfe);
+        }
+        if (event_table_ != nullptr) {
+            event_table_->Fill(zfe);
+        }
     }
+
+    delete zfe_ptr;
+}
+
+bool ZFinder::PassPrefilter(const edm::Event& iEvent) const {
+    /*
+     * Check the electron candidates in the raw collections that ZFinderEvent
+     * builds its reco electrons from against the pt and eta requirements of
+     * each ZDefinition. This must never reject an event that ZFinderEvent
+     * could make a passing Z from, so every selection here is looser than
+     * (or equal to) the one in ZFinderEvent.
+     */
+    const bool USE_MUON_ACCEPTANCE = iConfig_.getParameter<bool>("use_muon_acceptance");
+    const double EXTENDED_MAXIMUM_ETA = iConfig_.getParameter<double>("extended_maximum_eta");
+
+    // The pt and |eta| of each candidate
+    std::vector<std::pair<double, double> > candidates;
+
+    // GSF electrons
+    edm::Handle<reco::GsfElectronCollection> gsf_h;
+    iEvent.getByLabel(iConfig_.getParameter<edm::InputTag>("ecalElectronsInputTag"), gsf_h);
+    for (auto& i_elec : *gsf_h) {
+        if (USE_MUON_ACCEPTANCE && fabs(i_elec.eta()) > EXTENDED_MAXIMUM_ETA) {
+            continue;
+        }
+        candidates.push_back(std::make_pair(i_elec.pt(), fabs(i_elec.eta())));
+    }
+
+    // HF and NT electrons are never in the muon acceptance
+    if (!USE_MUON_ACCEPTANCE) {
+        edm::Handle<reco::RecoEcalCandidateCollection> hf_h;
+        iEvent.getByLabel(iConfig_.getParameter<edm::InputTag>("hfElectronsInputTag"), hf_h);
+        for (auto& i_elec : *hf_h) {
+            candidates.push_back(std::make_pair(i_elec.pt(), fabs(i_elec.eta())));
+        }
+        edm::Handle<reco::PhotonCollection> nt_h;
+        iEvent.getByLabel(iConfig_.getParameter<edm::InputTag>("ntElectronsInputTag"), nt_h);
+        for (auto& i_elec : *nt_h) {
+            // Same eta window as ZFinderEvent::InitNTElectrons
+            if (2.5 < fabs(i_elec.eta()) && fabs(i_elec.eta()) < 2.850) {
+                candidates.push_back(std::make_pair(i_elec.pt(), fabs(i_elec.eta())));
+            }
+        }
+    }
+    if (candidates.size() < 2) {
+        return false;
+    }
+
+    /*
+     * A ZDefinition can be passed if one candidate passes cuts0 and a
+     * different one passes cuts1, which is the case when both sets have a
+     * candidate and together they have at least two.
+     */
+    for (auto& i_cuts : prefilter_cuts_) {
+        int n_pass[2] = {0, 0};
+        int n_either = 0;
+        for (auto& i_cand : candidates) {
+            bool pass[2];
+            for (int i_cutset = 0; i_cutset < 2; ++i_cutset) {
+                const double MAX_ETA = i_cuts.max_abs_eta[i_cutset];
+                pass[i_cutset] = i_cand.first >= i_cuts.min_pt[i_cutset]
+                    && (MAX_ETA < 0 || i_cand.second <= MAX_ETA);
+                n_pass[i_cutset] += pass[i_cutset];
+            }
+            n_either += (pass[0] || pass[1]);
+        }
+        if (n_pass[0] > 0 && n_pass[1] > 0 && n_either >= 2) {
+            return true;
+        }
+    }
+    return false;
 }
 
 // ------------ method called once each job just before starting event loop  ------------
@@ -258,6 +486,23 @@ void ZFinder::endJob() {
     TFile* file = nullptr;
     std::vector<TFile*> seen;
 
+    // Finish filling the trees before writing them
+    if (tree_writer_ != nullptr) {
+        tree_writer_->Flush();
+    }
+    for (auto& i_zdeft : zdef_tuples_) {
+        i_zdeft->WriteIndex();
+        i_zdeft->WriteColumns();
+    }
+
+    // The plotters only make their histograms when written
+    for (auto& i_zdefp : zdef_plotters_) {
+        i_zdefp->Write();
+    }
+    for (auto& i_zdefw : zdef_workspaces_) {
+        i_zdefw->Write();
+    }
+
     for (auto& i_zdeft : zdef_tuples_) {
         file = i_zdeft->GetCurrentFile();
         // Check if we have seen this file before. If we have not then
@@ -267,6 +512,20 @@ void ZFinder::endJob() {
             seen.push_back(file);
         }
     }
+    if (electron_tuple_ != nullptr) {
+        file = electron_tuple_->GetCurrentFile();
+        if (std::find(seen.begin(), seen.end(), file) == seen.end()) {
+            file->Write();
+            seen.push_back(file);
+        }
+    }
+    if (event_table_ != nullptr) {
+        file = event_table_->GetCurrentFile();
+        if (std::find(seen.begin(), seen.end(), file) == seen.end()) {
+            file->Write();
+            seen.push_back(file);
+        }
+    }
 }
 
 // ------------ method called when starting to processes a run  ------------
@@ -7,7 +7,11 @@
 // ROOT
 #include "Math/VectorUtil.h"  // Phi_mpi_pi
 
+// CMSSW
+#include "DataFormats/GsfTrackReco/interface/GsfTrack.h"  // reco::GsfTrack
+
 // ZFinder
+#include "ZFinder/Event/interface/CutBits.h"  // CUT_BIT_NAMES, CUT_BIT_WEIGHTED_NAMES, CutBitIndex
 #include "ZFinder/Event/interface/PDGID.h"  // PDGID enum (ELECTRON, POSITRON, etc.)
 
 
@@ -31,6 +35,15 @@ namespace zf {
         ecal_iso_ = input_electron.dr03EcalRecHitSumEt();
         hcal_iso_ = input_electron.dr03HcalTowerSumEt();
         one_over_e_mins_one_over_p_ = (1.0/input_electron.ecalEnergy() - input_electron.eSuperClusterOverP()/input_electron.ecalEnergy());
+        missing_hits_ = input_electron.gsfTrack()->hitPattern().numberOfLostTrackerHits();
+        is_eb_ = input_electron.isEB();
+        is_ee_ = input_electron.isEE();
+        // These need the event (vertexes, conversions, isolation) and so are
+        // set by ZFinderEvent
+        d0_ = -1;
+        dz_ = -1;
+        pf_iso_ = -1;
+        has_conversion_ = false;
         charge_ = input_electron.charge();
         sc_eta_ = input_electron.superCluster()->eta();
         // Get SC phi and correct for the magnetic field
@@ -63,6 +76,13 @@ namespace zf {
         ecal_iso_ = -1;
         hcal_iso_ = -1;
         one_over_e_mins_one_over_p_ = -1;
+        d0_ = -1;
+        dz_ = -1;
+        pf_iso_ = -1;
+        missing_hits_ = -1;
+        has_conversion_ = false;
+        is_eb_ = false;
+        is_ee_ = false;
         // Using the input_electron Data Group ID Number, determine if the input_electron is an
         // electron or positron
         if (input_electron.pdgId() == PDGID::ELECTRON) {
@@ -97,6 +117,13 @@ namespace zf {
         ecal_iso_ = -1;
         hcal_iso_ = -1;
         one_over_e_mins_one_over_p_ = -1;
+        d0_ = -1;
+        dz_ = -1;
+        pf_iso_ = -1;
+        missing_hits_ = -1;
+        has_conversion_ = false;
+        is_eb_ = false;
+        is_ee_ = false;
         sc_eta_ = -10;
         sc_phi_ = -10;
         //born:
@@ -136,6 +163,13 @@ namespace zf {
         ecal_iso_ = -1;
         hcal_iso_ = -1;
         one_over_e_mins_one_over_p_ = -1;
+        d0_ = -1;
+        dz_ = -1;
+        pf_iso_ = -1;
+        missing_hits_ = -1;
+        has_conversion_ = false;
+        is_eb_ = false;
+        is_ee_ = false;
         sc_eta_ = -10;
         sc_phi_ = -10;
         charge_ = input_electron.charge();
@@ -161,6 +195,13 @@ namespace zf {
         ecal_iso_ = -1;
         hcal_iso_ = -1;
         one_over_e_mins_one_over_p_ = -1;
+        d0_ = -1;
+        dz_ = -1;
+        pf_iso_ = -1;
+        missing_hits_ = -1;
+        has_conversion_ = false;
+        is_eb_ = false;
+        is_ee_ = false;
         sc_eta_ = -10;
         sc_phi_ = -10;
         charge_ = 0;  // No charge because no tracker
@@ -185,11 +226,125 @@ namespace zf {
         ecal_iso_ = -1;
         hcal_iso_ = -1;
         one_over_e_mins_one_over_p_ = -1;
+        d0_ = -1;
+        dz_ = -1;
+        pf_iso_ = -1;
+        missing_hits_ = -1;
+        has_conversion_ = false;
+        is_eb_ = false;
+        is_ee_ = false;
         sc_eta_ = -10;
         sc_phi_ = -10;
         charge_ = 0;  // No charge
     }
 
+    ZFinderElectron::ZFinderElectron(const CompactElectron& COMPACT) {
+        /*
+         * Rebuild an electron from the copy stored by ZFinderEventProducer.
+         * There is no underlying CMSSW object, so candidate_ is null.
+         */
+        candidate_type_ = static_cast<ElectronType>(COMPACT.type);
+        candidate_ = nullptr;
+        pt_ = COMPACT.pt;
+        eta_ = COMPACT.eta;
+        phi_ = COMPACT.phi;
+        bornPt_ = COMPACT.born_pt;
+        bornEta_ = COMPACT.born_eta;
+        bornPhi_ = COMPACT.born_phi;
+        nakedPt_ = COMPACT.naked_pt;
+        nakedEta_ = COMPACT.naked_eta;
+        nakedPhi_ = COMPACT.naked_phi;
+        r9_ = COMPACT.r9;
+        sigma_ieta_ieta_ = COMPACT.sigma_ieta_ieta;
+        h_over_e_ = COMPACT.h_over_e;
+        deta_in_ = COMPACT.deta_in;
+        dphi_in_ = COMPACT.dphi_in;
+        track_iso_ = COMPACT.track_iso;
+        ecal_iso_ = COMPACT.ecal_iso;
+        hcal_iso_ = COMPACT.hcal_iso;
+        one_over_e_mins_one_over_p_ = COMPACT.one_over_e_mins_one_over_p;
+        d0_ = COMPACT.d0;
+        dz_ = COMPACT.dz;
+        pf_iso_ = COMPACT.pf_iso;
+        missing_hits_ = COMPACT.missing_hits;
+        has_conversion_ = COMPACT.has_conversion;
+        is_eb_ = COMPACT.is_eb;
+        is_ee_ = COMPACT.is_ee;
+        charge_ = COMPACT.charge;
+        sc_eta_ = COMPACT.sc_eta;
+        sc_phi_ = COMPACT.sc_phi;
+
+        // Restore the cuts. Only the cuts in CUT_BIT_WEIGHTED_NAMES can have
+        // a weight other than 1.
+        for (unsigned int i_bit = 0; i_bit < CUT_BIT_NAMES.size(); ++i_bit) {
+            const unsigned long long BIT = 1ULL << i_bit;
+            if (COMPACT.cut_known & BIT) {
+                double weight = 1.;
+                const int I_WEIGHT = CutBitIndex(CUT_BIT_WEIGHTED_NAMES, CUT_BIT_NAMES[i_bit]);
+                if (I_WEIGHT >= 0 && I_WEIGHT < static_cast<int>(COMPACT.cut_weights.size())) {
+                    weight = COMPACT.cut_weights[I_WEIGHT];
+                }
+                AddCutResult(CUT_BIT_NAMES[i_bit], COMPACT.cut_bits & BIT, weight);
+            }
+        }
+    }
+
+    CompactElectron ZFinderElectron::GetCompact() const {
+        /*
+         * Flatten the electron so it can be put in the edm::Event. Cuts not in
+         * CUT_BIT_NAMES are dropped.
+         */
+        CompactElectron compact;
+        compact.type = candidate_type_;
+        compact.charge = charge_;
+        compact.pt = pt_;
+        compact.eta = eta_;
+        compact.phi = phi_;
+        compact.born_pt = bornPt_;
+        compact.born_eta = bornEta_;
+        compact.born_phi = bornPhi_;
+        compact.naked_pt = nakedPt_;
+        compact.naked_eta = nakedEta_;
+        compact.naked_phi = nakedPhi_;
+        compact.sc_eta = sc_eta_;
+        compact.sc_phi = sc_phi_;
+        compact.r9 = r9_;
+        compact.sigma_ieta_ieta = sigma_ieta_ieta_;
+        compact.h_over_e = h_over_e_;
+        compact.deta_in = deta_in_;
+        compact.dphi_in = dphi_in_;
+        compact.track_iso = track_iso_;
+        compact.ecal_iso = ecal_iso_;
+        compact.hcal_iso = hcal_iso_;
+        compact.one_over_e_mins_one_over_p = one_over_e_mins_one_over_p_;
+        compact.d0 = d0_;
+        compact.dz = dz_;
+        compact.pf_iso = pf_iso_;
+        compact.missing_hits = missing_hits_;
+        compact.has_conversion = has_conversion_;
+        compact.is_eb = is_eb_;
+        compact.is_ee = is_ee_;
+
+        for (unsigned int i_bit = 0; i_bit < CUT_BIT_NAMES.size(); ++i_bit) {
+            const CutResult* cr = GetCutResult(CUT_BIT_NAMES[i_bit]);
+            if (cr != nullptr) {
+                const unsigned long long BIT = 1ULL << i_bit;
+                compact.cut_known |= BIT;
+                if (cr->passed) {
+                    compact.cut_bits |= BIT;
+                }
+            }
+        }
+        for (int i_weight = 0; i_weight < N_WEIGHTED_CUTS; ++i_weight) {
+            const double WEIGHT = CutWeight(CUT_BIT_WEIGHTED_NAMES[i_weight]);
+            if (WEIGHT >= 0.) {
+                compact.cut_weights[i_weight] = WEIGHT;
+            }
+        }
+
+        return compact;
+    }
+
     const CutResult* ZFinderElectron::GetCutResult(const std::string& cut_name) const {
         /* Return a CutResult based on the name */
         // Find the cut
@@ -1,7 +1,7 @@
 #include "ZFinder/Event/interface/ZFinderEvent.h"
 
 // Standard Library
-#include <algorithm>  // std::sort, std::swap
+#include <algorithm>  // std::sort, std::swap, std::max
 #include <iostream>  // std::cout, std::endl
 
 // CMSSW
@@ -13,7 +13,10 @@
 #include "DataFormats/EgammaReco/interface/SuperClusterFwd.h"  // reco::SuperClusterCollection, reco::SuperClusterRef
 #include "DataFormats/HLTReco/interface/TriggerEvent.h" // trigger::TriggerEvent
 #include "DataFormats/RecoCandidate/interface/RecoEcalCandidateFwd.h"  // reco::RecoEcalCandidateCollection
+#include "DataFormats/VertexReco/interface/VertexFwd.h"  // reco::VertexRef
 #include "EgammaAnalysis/ElectronTools/interface/EGammaCutBasedEleId.h"  // EgammaCutBasedEleId::PassWP, EgammaCutBasedEleId::*
+#include "EgammaAnalysis/ElectronTools/interface/ElectronEffectiveArea.h"  // ElectronEffectiveArea
+#include "RecoEgamma/EgammaTools/interface/ConversionTools.h"  // ConversionTools::hasMatchedConversion
 #include "SimDataFormats/GeneratorProducts/interface/GenEventInfoProduct.h"  // GenEventInfoProduct
 #include "SimDataFormats/PileupSummaryInfo/interface/PileupSummaryInfo.h"  // PileupSummaryInfo
 
@@ -377,6 +380,24 @@ namespace zf {
             const double ISO_EM = (*(isoVals[1]))[ele_ref];
             const double ISO_NH = (*(isoVals[2]))[ele_ref];
 
+            // Track, conversion, and isolation variables. These are computed
+            // here so that analyzers reading the ZFinderEventProducer output
+            // do not need to refetch the collections. Code from:
+            // http://cmslxr.fnal.gov/source/EgammaAnalysis/ElectronTools/src/EGammaCutBasedEleId.cc?v=CMSSW_5_3_20#0111
+            if (vtx_h->size() > 0) {
+                reco::VertexRef vtx(vtx_h, 0);
+                zf_electron->set_d0(electron.gsfTrack()->dxy(vtx->position()));
+                zf_electron->set_dz(electron.gsfTrack()->dz(vtx->position()));
+            }
+            else {
+                zf_electron->set_d0(electron.gsfTrack()->dxy());
+                zf_electron->set_dz(electron.gsfTrack()->dz());
+            }
+            zf_electron->set_has_conversion(ConversionTools::hasMatchedConversion(electron, conversions_h, beamSpot.position()));
+            const double AEFF = ElectronEffectiveArea::GetElectronEffectiveArea(ElectronEffectiveArea::kEleGammaAndNeutralHadronIso03, electron.eta(), ElectronEffectiveArea::kEleEAData2011);
+            const double ISO_N = std::max(ISO_NH + ISO_EM - std::max(RHO_ISO, 0.) * AEFF, 0.);
+            zf_electron->set_pf_iso((ISO_N + ISO_CH) / electron.pt());
+
             // test ID
             // working points
             const bool VETO = EgammaCutBasedEleId::PassWP(EgammaCutBasedEleId::VETO, ele_ref, conversions_h, beamSpot, vtx_h, ISO_CH, ISO_EM, ISO_NH, RHO_ISO);
@@ -1218,6 +1239,161 @@ namespace zf {
         }
     }
 
+    ZFinderEvent::ZFinderEvent(const CompactZFinderEvent& COMPACT) {
+        /*
+         * Rebuild the event from the product of ZFinderEventProducer. The
+         * electrons are owned by this event just as if they had been made
+         * from the edm::Event.
+         */
+        InitVariables();
+
+        is_real_data = COMPACT.is_real_data;
+        id.run_num = COMPACT.run_num;
+        id.lumi_num = COMPACT.lumi_num;
+        id.event_num = COMPACT.event_num;
+
+        if (COMPACT.reco_bs.size() == 3) {
+            reco_bs.x = COMPACT.reco_bs[0];
+            reco_bs.y = COMPACT.reco_bs[1];
+            reco_bs.z = COMPACT.reco_bs[2];
+        }
+        SetVertexes(COMPACT.reco_vert, &reco_vert);
+        SetVertexes(COMPACT.truth_vert, &truth_vert);
+        SetZData(COMPACT.reco_z, &reco_z);
+        SetZData(COMPACT.truth_z, &truth_z);
+
+        if (COMPACT.weights.size() == 6) {
+            event_weight = COMPACT.weights[0];
+            weight_fsr = COMPACT.weights[1];
+            weight_vertex = COMPACT.weights[2];
+            weight_vertex_plus = COMPACT.weights[3];
+            weight_vertex_minus = COMPACT.weights[4];
+            weight_natural_mc = COMPACT.weights[5];
+        }
+        weights_cteq = COMPACT.weights_cteq;
+        weights_mstw = COMPACT.weights_mstw;
+        weights_nnpdf = COMPACT.weights_nnpdf;
+
+        for (auto& i_elec : COMPACT.reco_electrons) {
+            reco_electrons_.push_back(new ZFinderElectron(i_elec));
+        }
+        for (auto& i_elec : COMPACT.truth_electrons) {
+            truth_electrons_.push_back(new ZFinderElectron(i_elec));
+        }
+        for (auto& i_elec : COMPACT.hlt_electrons) {
+            hlt_electrons_.push_back(new ZFinderElectron(i_elec));
+        }
+        n_reco_electrons = COMPACT.n_reco_electrons;
+
+        e0 = ElectronAt(reco_electrons_, COMPACT.e0);
+        e1 = ElectronAt(reco_electrons_, COMPACT.e1);
+        e0_truth = ElectronAt(truth_electrons_, COMPACT.e0_truth);
+        e1_truth = ElectronAt(truth_electrons_, COMPACT.e1_truth);
+        e0_trig = ElectronAt(hlt_electrons_, COMPACT.e0_trig);
+        e1_trig = ElectronAt(hlt_electrons_, COMPACT.e1_trig);
+    }
+
+    CompactZFinderEvent ZFinderEvent::GetCompact() const {
+        /*
+         * Flatten the event so that it can be put into the edm::Event. The
+         * special electrons are stored as indices into the electron vectors.
+         */
+        CompactZFinderEvent compact;
+
+        compact.is_real_data = is_real_data;
+        compact.run_num = id.run_num;
+        compact.lumi_num = id.lumi_num;
+        compact.event_num = id.event_num;
+
+        compact.reco_bs = {reco_bs.x, reco_bs.y, reco_bs.z};
+        compact.reco_vert = {static_cast<double>(reco_vert.num), reco_vert.true_num, reco_vert.x, reco_vert.y, reco_vert.z};
+        compact.truth_vert = {static_cast<double>(truth_vert.num), truth_vert.true_num, truth_vert.x, truth_vert.y, truth_vert.z};
+        compact.reco_z = {reco_z.m, reco_z.pt, reco_z.y, reco_z.phistar, reco_z.bornPhistar, reco_z.nakedPhistar, reco_z.scPhistar, reco_z.eta, reco_z.deltaR, reco_z.other_y, reco_z.other_phistar};
+        compact.truth_z = {truth_z.m, truth_z.pt, truth_z.y, truth_z.phistar, truth_z.bornPhistar, truth_z.nakedPhistar, truth_z.scPhistar, truth_z.eta, truth_z.deltaR, truth_z.other_y, truth_z.other_phistar};
+
+        compact.weights = {event_weight, weight_fsr, weight_vertex, weight_vertex_plus, weight_vertex_minus, weight_natural_mc};
+        compact.weights_cteq = weights_cteq;
+        compact.weights_mstw = weights_mstw;
+        compact.weights_nnpdf = weights_nnpdf;
+
+        for (auto& i_elec : reco_electrons_) {
+            compact.reco_electrons.push_back(i_elec->GetCompact());
+        }
+        for (auto& i_elec : truth_electrons_) {
+            compact.truth_electrons.push_back(i_elec->GetCompact());
+        }
+        for (auto& i_elec : hlt_electrons_) {
+            compact.hlt_electrons.push_back(i_elec->GetCompact());
+        }
+        compact.n_reco_electrons = n_reco_electrons;
+
+        compact.e0 = ElectronIndex(reco_electrons_, e0);
+        compact.e1 = ElectronIndex(reco_electrons_, e1);
+        compact.e0_truth = ElectronIndex(truth_electrons_, e0_truth);
+        compact.e1_truth = ElectronIndex(truth_electrons_, e1_truth);
+        compact.e0_trig = ElectronIndex(hlt_electrons_, e0_trig);
+        compact.e1_trig = ElectronIndex(hlt_electrons_, e1_trig);
+
+        return compact;
+    }
+
+    int ZFinderEvent::ElectronIndex(
+            const std::vector<ZFinderElectron*>& ELECTRONS,
+            const ZFinderElectron* const ELECTRON
+            ) {
+        /* Return the position of ELECTRON in ELECTRONS, or -1 */
+        if (ELECTRON == nullptr) {
+            return -1;
+        }
+        for (unsigned int i = 0; i < ELECTRONS.size(); ++i) {
+            if (ELECTRONS[i] == ELECTRON) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    ZFinderElectron* ZFinderEvent::ElectronAt(
+            const std::vector<ZFinderElectron*>& ELECTRONS,
+            const int INDEX
+            ) {
+        /* Return the electron at INDEX, or nullptr if it is out of range */
+        if (INDEX < 0 || INDEX >= static_cast<int>(ELECTRONS.size())) {
+            return nullptr;
+        }
+        return ELECTRONS[INDEX];
+    }
+
+    void ZFinderEvent::SetVertexes(const std::vector<double>& VALUES, Vertexes* vert) {
+        /* Unpack the order used in GetCompact() */
+        if (VALUES.size() != 5) {
+            return;
+        }
+        vert->num = static_cast<int>(VALUES[0]);
+        vert->true_num = VALUES[1];
+        vert->x = VALUES[2];
+        vert->y = VALUES[3];
+        vert->z = VALUES[4];
+    }
+
+    void ZFinderEvent::SetZData(const std::vector<double>& VALUES, ZData* zdata) {
+        /* Unpack the order used in GetCompact() */
+        if (VALUES.size() != 11) {
+            return;
+        }
+        zdata->m = VALUES[0];
+        zdata->pt = VALUES[1];
+        zdata->y = VALUES[2];
+        zdata->phistar = VALUES[3];
+        zdata->bornPhistar = VALUES[4];
+        zdata->nakedPhistar = VALUES[5];
+        zdata->scPhistar = VALUES[6];
+        zdata->eta = VALUES[7];
+        zdata->deltaR = VALUES[8];
+        zdata->other_y = VALUES[9];
+        zdata->other_phistar = VALUES[10];
+    }
+
     ZFinderEvent::~ZFinderEvent() {
         // Clean up all the heap variables we have declared
         for (auto& i_elec : reco_electrons_) {
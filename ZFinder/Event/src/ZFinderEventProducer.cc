@@ -0,0 +1,91 @@
+// -*- C++ -*-
+//
+// Package:    ZFinder
+// Class:      ZFinderEventProducer
+//
+/**\class ZFinderEventProducer ZFinderEventProducer.cc ZFinder/Event/src/ZFinderEventProducer.cc
+
+Description: Builds a ZFinderEvent once per event and stores a flat copy of it
+(zf::CompactZFinderEvent) in the edm::Event.
+
+Implementation:
+ZFinder, TrigEff, and IDPlotter all need the same GSF electrons with their
+EGamma IDs, PF isolation, and trigger matches. Building them requires fetching
+the electrons, isolation ValueMaps, conversions, beamspot, vertexes, and rho,
+and calling EgammaCutBasedEleId::PassWP for every working point. This module
+does that once; the analyzers read the product with the
+ZFinderEvent(const CompactZFinderEvent&) constructor instead.
+*/
+//
+// Original Author:  Alexander Gude
+//
+
+
+// system include files
+#include <memory>
+
+// user include files
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/EDProducer.h"
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+// ZFinder
+#include "ZFinder/Event/interface/CompactZFinderEvent.h"  // CompactZFinderEvent
+#include "ZFinder/Event/interface/ZFinderEvent.h"  // ZFinderEvent
+
+//
+// class declaration
+//
+
+class ZFinderEventProducer : public edm::EDProducer {
+    public:
+        explicit ZFinderEventProducer(const edm::ParameterSet&);
+        ~ZFinderEventProducer();
+
+        static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+    private:
+        virtual void produce(edm::Event&, const edm::EventSetup&);
+
+        // ----------member data ---------------------------
+        // ZFinderEvent reads its input tags from this on every event
+        const edm::ParameterSet iConfig_;
+};
+
+//
+// constructors and destructor
+//
+ZFinderEventProducer::ZFinderEventProducer(const edm::ParameterSet& iConfig) : iConfig_(iConfig) {
+    produces<zf::CompactZFinderEvent>();
+}
+
+ZFinderEventProducer::~ZFinderEventProducer() {
+}
+
+//
+// member functions
+//
+
+// ------------ method called to produce the data  ------------
+void ZFinderEventProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+    // Build the event exactly as ZFinder does, then flatten it
+    zf::ZFinderEvent zfe(iEvent, iSetup, iConfig_);
+    std::auto_ptr<zf::CompactZFinderEvent> compact(new zf::CompactZFinderEvent(zfe.GetCompact()));
+    iEvent.put(compact);
+}
+
+// ------------ method fills 'descriptions' with the allowed parameters for the module  ------------
+void ZFinderEventProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+    //The following says we do not know what parameters are allowed so do no validation
+    // Please change this to state exactly what you do use, even if it is no parameters
+    edm::ParameterSetDescription desc;
+    desc.setUnknown();
+    descriptions.addDefault(desc);
+}
+
+//define this as a plug-in
+DEFINE_FWK_MODULE(ZFinderEventProducer);
@@ -1,6 +1,9 @@
+#include "ZFinder/Event/interface/CompactZFinderEvent.h"
 #include "ZFinder/Event/interface/ZFinderEvent.h"
 
 namespace { namespace {
  //say which template classes should have dictionaries
  edm::Wrapper<zf::ZFinderEvent> dummy1;
+ edm::Wrapper<zf::CompactZFinderEvent> dummy2;
+ std::vector<zf::CompactElectron> dummy3;
 } }
@@ -56,8 +56,16 @@ from CommonTools.ParticleFlow.Tools.pfIsolation import setupPFElectronIso
 process.eleIsoSequence = setupPFElectronIso(process, 'CalibratedElectrons:calibratedGsfElectrons')
 process.pfiso = cms.Sequence(process.pfParticleSelectionSequence + process.eleIsoSequence)
 
-process.IDPlotter = cms.EDAnalyzer('IDPlotter',
+# Build the electrons and their IDs once; the analyzer reads them from the event
+# and plots only the GSF electrons (ecalElectronsInputTag), as it did when it
+# read that collection itself
+from ZFinder.Event.zfinder_cfi import ZFinderEventProducer
+process.ZFinderEventProducer = ZFinderEventProducer.clone(
         ecalElectronsInputTag = cms.InputTag("CalibratedElectrons", "calibratedGsfElectrons"),
+        )
+
+process.IDPlotter = cms.EDAnalyzer('IDPlotter',
+        zfinderEventInputTag = cms.InputTag("ZFinderEventProducer"),
 )
 
 
@@ -67,5 +75,6 @@ process.p = cms.Path(
         * process.CalibratedElectrons
         * process.kt6PFJetsForIsolation
         * process.pfiso
+        * process.ZFinderEventProducer
         * process.IDPlotter
         )
@@ -19,6 +19,7 @@
 
 
 // system include files
+#include <cmath>  // fabs
 #include <memory>
 
 // user include files
@@ -33,15 +34,12 @@
 // CMSSW
 #include "FWCore/ServiceRegistry/interface/Service.h" // edm::Service
 #include "CommonTools/UtilAlgos/interface/TFileService.h" // TFileService
-#include "DataFormats/VertexReco/interface/VertexFwd.h"
-#include "DataFormats/Common/interface/ValueMap.h"  // edm:ValueMap
-#include "EgammaAnalysis/ElectronTools/interface/ElectronEffectiveArea.h"
-#include "RecoEgamma/EgammaTools/interface/ConversionTools.h"
+#include "DataFormats/Common/interface/Handle.h"  // edm::Handle
+#include "FWCore/Utilities/interface/InputTag.h"  // edm::InputTag
 #include "DataFormats/HepMCCandidate/interface/GenParticle.h"  // reco::GenParticle
 
-// Electrons
-#include "DataFormats/EgammaCandidates/interface/GsfElectron.h"  // GsfElectron
-#include "DataFormats/GsfTrackReco/interface/GsfTrack.h"  // GsfTrack
+// ZFinder
+#include "ZFinder/Event/interface/CompactZFinderEvent.h"  // CompactZFinderEvent, CompactElectron
 
 // ROOT
 #include <TH1D.h>
@@ -68,19 +66,10 @@ class IDPlotter : public edm::EDAnalyzer {
         virtual void beginLuminosityBlock(edm::LuminosityBlock const&, edm::EventSetup const&);
         virtual void endLuminosityBlock(edm::LuminosityBlock const&, edm::EventSetup const&);
 
-        void fill_histograms(const reco::GsfElectron& electron, const double ISO, const double PT, const bool CON_MATCH);
-
-double get_iso(
-        const double ISO_CH,
-        const double ISO_EM,
-        const double ISO_NH,
-        const double RHO,
-        const double PT,
-        const double ETA
-        );
+        void fill_histograms(const zf::CompactElectron& electron);
 
         // ----------member data ---------------------------
-        edm::InputTag ecal_electron_;
+        edm::InputTag zfinder_event_;
         double min_pt_;
         double max_eta_;
         TH1D* r9_;
@@ -98,7 +87,6 @@ double get_iso(
         TH1D* mhits_;
         TH1D* conversion_match_;
         TH1D* iso_;
-        edm::Handle<reco::VertexCollection> reco_vertices_;
 };
 
 //
@@ -221,8 +209,8 @@ IDPlotter::IDPlotter(const edm::ParameterSet& iConfig) {
     iso_->GetXaxis()->SetTitle("PF Isolation");
     iso_->GetYaxis()->SetTitle("Counts");
 
-    // Get the tag of the electrons we want
-    ecal_electron_ = iConfig.getParameter<edm::InputTag>("ecalElectronsInputTag");
+    // Get the tag of the ZFinderEventProducer output
+    zfinder_event_ = iConfig.getParameter<edm::InputTag>("zfinderEventInputTag");
 
     // Set the acceptance of the electrons
     min_pt_ = 20;
@@ -272,118 +260,49 @@ IDPlotter::analyze(const edm::Event& iEvent, const edm::EventSetup& iSetup) {
         }
     }
 
-    // Get the electrons
-    edm::Handle<reco::GsfElectronCollection> els_h;
-    iEvent.getByLabel(ecal_electron_, els_h);
-
-    iEvent.getByLabel("offlinePrimaryVertices", reco_vertices_);
-
-    // ISO
-    edm::Handle< edm::ValueMap<double> > IsoDepositVals_CH;
-    edm::Handle< edm::ValueMap<double> > IsoDepositVals_EM;
-    edm::Handle< edm::ValueMap<double> > IsoDepositVals_NH;
-    iEvent.getByLabel("elPFIsoValueCharged03PFIdPFIso", IsoDepositVals_CH);
-    iEvent.getByLabel("elPFIsoValueGamma03PFIdPFIso", IsoDepositVals_EM);
-    iEvent.getByLabel("elPFIsoValueNeutral03PFIdPFIso", IsoDepositVals_NH);
-
-    // rho for isolation
-    // The python uses:
-    // cms.InputTag("kt6PFJetsForIsolation", "rho")
-    edm::Handle<double> rho_iso_h;
-    iEvent.getByLabel("kt6PFJetsForIsolation", "rho", rho_iso_h);
-    const double RHO_ISO = *(rho_iso_h.product());
-
-    // beam spot
-    edm::Handle<reco::BeamSpot> beamspot_h;
-    iEvent.getByLabel("offlineBeamSpot", beamspot_h);
-    const reco::BeamSpot &beamspot = *(beamspot_h.product());
-
-    // conversions
-    edm::Handle<reco::ConversionCollection> conversions_h;
-    iEvent.getByLabel("allConversions", conversions_h);
-
-    for (unsigned int i = 0; i < els_h->size(); ++i) {
-        const reco::GsfElectron electron = els_h->at(i);
-
-        if (electron.pt() > min_pt_ && fabs(electron.eta()) < max_eta_) {
-            // get reference to electron and the electron
-            reco::GsfElectronRef ele_ref(els_h, i);
-
-            // get particle flow isolation
-            const double ISO_CH = (*IsoDepositVals_CH)[ele_ref];
-            const double ISO_EM = (*IsoDepositVals_EM)[ele_ref];
-            const double ISO_NH = (*IsoDepositVals_NH)[ele_ref];
-
-            // Fill the histograms
-            const double ISO = get_iso(
-                    ISO_CH,
-                    ISO_EM,
-                    ISO_NH,
-                    RHO_ISO,
-                    electron.pt(),
-                    electron.eta()
-                    );
-            bool vtxFitConversion = ConversionTools::hasMatchedConversion(electron, conversions_h, beamspot.position());
-
-            fill_histograms(electron, ISO, electron.pt(), vtxFitConversion);
+    // The electrons and their ID variables are computed once by
+    // ZFinderEventProducer
+    edm::Handle<zf::CompactZFinderEvent> zfe_h;
+    iEvent.getByLabel(zfinder_event_, zfe_h);
+    const zf::CompactZFinderEvent& zfe = *zfe_h;
+
+    for (auto& i_elec : zfe.reco_electrons) {
+        // The event also has the HF and NT electrons; only plot those from
+        // ecalElectronsInputTag, which are all the plotter used to read
+        if (i_elec.CutPassed("type_gsf") != 1) {
+            continue;
+        }
+        if (i_elec.pt > min_pt_ && fabs(i_elec.eta) < max_eta_) {
+            fill_histograms(i_elec);
         }
     }
 }
 
-double IDPlotter::get_iso(
-        const double ISO_CH,
-        const double ISO_EM,
-        const double ISO_NH,
-        const double RHO,
-        const double PT,
-        const double ETA
-        ) {
-    // effective area for isolation
-    float AEFF = ElectronEffectiveArea::GetElectronEffectiveArea(ElectronEffectiveArea::kEleGammaAndNeutralHadronIso03, ETA, ElectronEffectiveArea::kEleEAData2011);
-
-    // apply to neutrals
-    const double RHO_PRIME = std::max(RHO, 0.0);
-    const double ISO_N = std::max(ISO_NH + ISO_EM - RHO_PRIME * AEFF, 0.0);
-
-    // compute final isolation
-    return (ISO_N + ISO_CH) / PT;
-}
-
-void IDPlotter::fill_histograms(const reco::GsfElectron& electron, const double ISO, const double PT, const bool CON_MATCH) {
-    r9_->Fill(electron.r9());
-    if (electron.isEB()) {
-        sigma_ieta_ieta_eb_->Fill(electron.sigmaIetaIeta());
-    }
-    else if (electron.isEE()) {
-        sigma_ieta_ieta_ee_->Fill(electron.sigmaIetaIeta());
-    }
-    h_over_e_->Fill(electron.hadronicOverEm());
-    deta_in_->Fill(electron.deltaEtaSuperClusterTrackAtVtx());
-    dphi_in_->Fill(electron.deltaPhiSuperClusterTrackAtVtx());
-    track_iso_->Fill(electron.dr03TkSumPt()/PT);
-    ecal_iso_->Fill(electron.dr03EcalRecHitSumEt()/PT);
-    hcal_iso_->Fill(electron.dr03HcalTowerSumEt()/PT);
-    one_over_e_mins_one_over_p_->Fill((1.0/electron.ecalEnergy() - electron.eSuperClusterOverP()/electron.ecalEnergy()));
-    // Get the vertex parameter. Code from: http://cmslxr.fnal.gov/source/EgammaAnalysis/ElectronTools/src/EGammaCutBasedEleId.cc?v=CMSSW_5_3_20#0111
-    double d0vtx = 0.0;
-    double dzvtx = 0.0;
-    if (reco_vertices_->size() > 0) {
-        reco::VertexRef vtx(reco_vertices_, 0);
-        d0vtx = electron.gsfTrack()->dxy(vtx->position());
-        dzvtx = electron.gsfTrack()->dz(vtx->position());
+void IDPlotter::fill_histograms(const zf::CompactElectron& electron) {
+    const double PT = electron.pt;
+    r9_->Fill(electron.r9);
+    if (electron.is_eb) {
+        sigma_ieta_ieta_eb_->Fill(electron.sigma_ieta_ieta);
     }
-    else {
-        d0vtx = electron.gsfTrack()->dxy();
-        dzvtx = electron.gsfTrack()->dz();
+    else if (electron.is_ee) {
+        sigma_ieta_ieta_ee_->Fill(electron.sigma_ieta_ieta);
     }
-    d0_->Fill(d0vtx);
-    dz_->Fill(dzvtx);
+    h_over_e_->Fill(electron.h_over_e);
+    deta_in_->Fill(electron.deta_in);
+    dphi_in_->Fill(electron.dphi_in);
+    track_iso_->Fill(electron.track_iso/PT);
+    ecal_iso_->Fill(electron.ecal_iso/PT);
+    hcal_iso_->Fill(electron.hcal_iso/PT);
+    one_over_e_mins_one_over_p_->Fill(electron.one_over_e_mins_one_over_p);
+    // Vertex parameters relative to the first primary vertex
+    d0_->Fill(electron.d0);
+    dz_->Fill(electron.dz);
     // Missing hits
-    mhits_->Fill(electron.gsfTrack()->hitPattern().numberOfLostTrackerHits());
+    mhits_->Fill(electron.missing_hits);
     // Conversion prob
-    conversion_match_->Fill(CON_MATCH);
+    conversion_match_->Fill(electron.has_conversion);
     // ISO
-    iso_->Fill(ISO);
+    iso_->Fill(electron.pf_iso);
 }
 
 // ------------ method called once each job just before starting event loop  ------------
@@ -0,0 +1,595 @@
+// Standard Library
+#include <algorithm>  // std::upper_bound, std::min
+#include <cmath>  // sqrt, log, cos, sin, tan, cosh, sinh, asinh, atan2, pow
+#include <cstdint>  // uint32_t, uint64_t
+#include <cstdlib>  // atoi, atof, strtoull
+#include <functional>  // std::ref, std::cref
+#include <iostream>
+#include <stdexcept>  // std::runtime_error
+#include <string>
+#include <thread>  // std::thread
+#include <vector>
+
+// ROOT
+#include <TFile.h>
+#include <TH1D.h>
+
+// ZFinder
+#include "../Event/interface/ColumnarFile.h"  // zf::ColumnarWriter
+
+/*
+ * Generate toy Z to ee decays, smear the electrons, and fill the truth and
+ * reco phistar and Z pt histograms read by plotter.py. This is make_toys.py
+ * in C++, with the same physics and options.
+ *
+ * Usage:
+ *
+ *     make_toys.exe [options] output.root
+ *
+ * Options:
+ *
+ *     -n N           the number of events (default 1000000)
+ *     -s SEED        the seed (default 1)
+ *     -j N           the number of threads (default 4)
+ *     -m MASS        the Z mass (default 91.1876)
+ *     -w WIDTH       the width of the Gaussian Z mass (default 2.4952)
+ *     -a ALPHA       the shape of the Gamma Z pt (default 1.5)
+ *     -b BETA        the scale of the Gamma Z pt (default 10)
+ *     -e ETA         the Z eta is uniform in [-ETA, ETA] (default 2)
+ *     -p RESOLUTION  the electron pt smearing (default 0.1)
+ *     -t RESOLUTION  the electron eta smearing (default 0.01)
+ *     -f RESOLUTION  the electron phi smearing (default 0.01)
+ *     -c FILE        also write every event to a columnar file
+ *
+ * The random numbers come from Philox4x32-10, a counter-based generator:
+ * every draw is a function of the seed, the event number, and the number of
+ * the draw within the event, so the events do not depend on the number of
+ * threads or on the order they are generated in. Events are generated in
+ * batches, one stage of the generation at a time over arrays of the batch.
+ * Each thread fills its own bin counts, which are added at the end; the
+ * columnar file gets the batches in event order.
+ */
+
+namespace {
+    const double PI = 3.14159265358979323846;
+    const double E_MASS = 5.11e-4;
+
+    // The events generated by each thread at a time
+    const size_t BATCH_SIZE = 16384;
+
+    const double PHISTAR_BIN_EDGES[] = {
+        0.001, 0.004, 0.008, 0.012, 0.016, 0.020, 0.024, 0.029, 0.034,
+        0.039, 0.045, 0.052, 0.057, 0.064, 0.072, 0.081, 0.091, 0.102,
+        0.114, 0.128, 0.145, 0.165, 0.189, 0.219, 0.258, 0.312, 0.391,
+        0.524, 0.695, 0.918, 1.153, 1.496, 1.947, 2.522, 3.277
+    };
+    const int N_PHISTAR_BINS = sizeof(PHISTAR_BIN_EDGES) / sizeof(double) - 1;
+
+    struct toy_config {
+        double z_mass;
+        double z_width;
+        double pt_alpha;
+        double pt_beta;
+        double z_eta_max;
+        double pt_smear;
+        double eta_smear;
+        double phi_smear;
+        uint64_t seed;
+
+        toy_config() :
+            z_mass(91.1876),
+            z_width(2.4952),
+            pt_alpha(1.5),
+            pt_beta(10),
+            z_eta_max(2),
+            pt_smear(0.1),
+            eta_smear(0.01),
+            phi_smear(0.01),
+            seed(1) {}
+    };
+
+    /*
+     * Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as
+     * 1, 2, 3"). A block of four 32 bit numbers is a function of the 128
+     * bit counter and the 64 bit key alone.
+     */
+    inline void Philox(const uint32_t* COUNTER, const uint64_t KEY, uint32_t* out) {
+        uint32_t c0 = COUNTER[0];
+        uint32_t c1 = COUNTER[1];
+        uint32_t c2 = COUNTER[2];
+        uint32_t c3 = COUNTER[3];
+        uint32_t k0 = static_cast<uint32_t>(KEY);
+        uint32_t k1 = static_cast<uint32_t>(KEY >> 32);
+        for (int i_round = 0; i_round < 10; ++i_round) {
+            const uint64_t PRODUCT0 = static_cast<uint64_t>(0xD2511F53u) * c0;
+            const uint64_t PRODUCT1 = static_cast<uint64_t>(0xCD9E8D57u) * c2;
+            const uint32_t HI0 = static_cast<uint32_t>(PRODUCT0 >> 32);
+            const uint32_t HI1 = static_cast<uint32_t>(PRODUCT1 >> 32);
+            c0 = HI1 ^ c1 ^ k0;
+            c1 = static_cast<uint32_t>(PRODUCT1);
+            c2 = HI0 ^ c3 ^ k1;
+            c3 = static_cast<uint32_t>(PRODUCT0);
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        out[0] = c0;
+        out[1] = c1;
+        out[2] = c2;
+        out[3] = c3;
+    }
+
+    /*
+     * The draws of one event. Draw N is the Philox block with the counter
+     * (event low word, event high word, N, 0), so an event's numbers are the
+     * same wherever it is generated.
+     */
+    class event_stream {
+        public:
+            event_stream(const uint64_t SEED, const uint64_t EVENT) : seed_(SEED) {
+                counter_[0] = static_cast<uint32_t>(EVENT);
+                counter_[1] = static_cast<uint32_t>(EVENT >> 32);
+                counter_[2] = 0;
+                counter_[3] = 0;
+            }
+
+            // The four numbers of draw N
+            void Block(const uint32_t N, uint32_t* out) {
+                counter_[2] = N;
+                Philox(counter_, seed_, out);
+            }
+
+            // Two uniform numbers in (0, 1) with 53 bits each
+            void Uniforms(const uint32_t N, double* u) {
+                uint32_t block[4];
+                Block(N, block);
+                u[0] = ToDouble(block[0], block[1]);
+                u[1] = ToDouble(block[2], block[3]);
+            }
+
+            // Two independent standard normal numbers (Box-Muller)
+            void Normals(const uint32_t N, double* n) {
+                double u[2];
+                Uniforms(N, u);
+                const double R = sqrt(-2. * log(u[0]));
+                n[0] = R * cos(2. * PI * u[1]);
+                n[1] = R * sin(2. * PI * u[1]);
+            }
+
+            static double ToDouble(const uint32_t HIGH, const uint32_t LOW) {
+                const uint64_t BITS = ((static_cast<uint64_t>(HIGH) << 32) | LOW) >> 11;
+                return (BITS + 0.5) * (1. / 9007199254740992.);  // 2^-53
+            }
+
+        protected:
+            uint64_t seed_;
+            uint32_t counter_[4];
+    };
+
+    // The draws each event uses. The Gamma distribution needs a variable
+    // number of draws, so it gets the last ones.
+    enum draw {
+        DRAW_ANGLES_Z = 0,  // Z eta and phi
+        DRAW_ANGLES_E = 1,  // Electron theta and phi
+        DRAW_MASS = 2,  // Z mass (and one spare normal)
+        DRAW_SMEAR_PT = 3,  // pt smearing of both electrons
+        DRAW_SMEAR_ETA = 4,
+        DRAW_SMEAR_PHI = 5,
+        DRAW_GAMMA_BOOST = 6,  // For alpha < 1
+        DRAW_GAMMA = 7  // The first try of the Gamma distribution
+    };
+
+    /*
+     * Gamma(ALPHA, 1) by Marsaglia and Tsang. Each try uses one draw: 53
+     * bits for the Box-Muller radius, and 32 bits each for its angle and
+     * the acceptance test.
+     */
+    double Gamma(const double ALPHA, event_stream* stream) {
+        double boost = 1;
+        double alpha = ALPHA;
+        if (alpha < 1) {
+            double u[2];
+            stream->Uniforms(DRAW_GAMMA_BOOST, u);
+            boost = pow(u[0], 1. / alpha);
+            alpha += 1;
+        }
+        const double D = alpha - 1. / 3.;
+        const double C = 1. / sqrt(9. * D);
+        for (uint32_t i_try = DRAW_GAMMA; ; ++i_try) {
+            uint32_t block[4];
+            stream->Block(i_try, block);
+            const double U_RADIUS = event_stream::ToDouble(block[0], block[1]);
+            const double U_ANGLE = (block[2] + 0.5) * (1. / 4294967296.);
+            const double U_ACCEPT = (block[3] + 0.5) * (1. / 4294967296.);
+            const double X = sqrt(-2. * log(U_RADIUS)) * cos(2. * PI * U_ANGLE);
+            const double T = 1. + C * X;
+            if (T <= 0) {
+                continue;
+            }
+            const double V = T * T * T;
+            const double X2 = X * X;
+            if (U_ACCEPT < 1. - 0.0331 * X2 * X2
+                    || log(U_ACCEPT) < 0.5 * X2 + D * (1. - V + log(V))) {
+                return D * V * boost;
+            }
+        }
+    }
+
+    // Phistar as make_toys.py computes it
+    double Phistar(const double ETA0, const double PHI0, const double ETA1, const double PHI1) {
+        double dphi = PHI0 - PHI1;
+        // Account for 2pi = 0
+        if (dphi < 0) {
+            if (dphi > -PI) {
+                dphi = fabs(dphi);
+            }
+            if (dphi < -PI) {
+                dphi += 2 * PI;
+            }
+        }
+        if (dphi > PI) {
+            dphi = 2 * PI - dphi;
+        }
+        const double DETA = fabs(ETA0 - ETA1);
+        return (1. / cosh(DETA / 2.)) * (1. / tan(dphi / 2.));
+    }
+
+    // Boost (E, px, py, pz) by the velocity B, as TLorentzVector::Boost
+    inline void Boost(const double* B, double* p) {
+        const double B2 = B[0] * B[0] + B[1] * B[1] + B[2] * B[2];
+        const double GAMMA = 1. / sqrt(1. - B2);
+        const double BP = B[0] * p[1] + B[1] * p[2] + B[2] * p[3];
+        const double GAMMA2 = B2 > 0 ? (GAMMA - 1.) / B2 : 0.;
+        const double FACTOR = GAMMA2 * BP + GAMMA * p[0];
+        p[1] += FACTOR * B[0];
+        p[2] += FACTOR * B[1];
+        p[3] += FACTOR * B[2];
+        p[0] = GAMMA * (p[0] + BP);
+    }
+
+    /*
+     * A batch of events, one array per quantity. The electron arrays hold
+     * two values per event.
+     */
+    struct toy_batch {
+        uint64_t first_event;
+        size_t size;
+        std::vector<double> z_mass;
+        std::vector<double> z_pt;
+        std::vector<double> z_eta;
+        std::vector<double> z_phi;
+        std::vector<double> e_theta;  // Of the first electron, in the Z frame
+        std::vector<double> e_phi_rest;
+        std::vector<double> e_pt;
+        std::vector<double> e_eta;
+        std::vector<double> e_phi;
+        std::vector<double> smear_e_pt;
+        std::vector<double> smear_e_eta;
+        std::vector<double> smear_e_phi;
+        std::vector<double> phistar;
+        std::vector<double> smear_phistar;
+        std::vector<double> smear_z_pt;
+
+        void Resize(const size_t SIZE) {
+            size = SIZE;
+            std::vector<double>* const PER_EVENT[] = {&z_mass, &z_pt, &z_eta, &z_phi, &e_theta, &e_phi_rest, &phistar, &smear_phistar, &smear_z_pt};
+            for (auto& i_vec : PER_EVENT) {
+                i_vec->resize(SIZE);
+            }
+            std::vector<double>* const PER_ELECTRON[] = {&e_pt, &e_eta, &e_phi, &smear_e_pt, &smear_e_eta, &smear_e_phi};
+            for (auto& i_vec : PER_ELECTRON) {
+                i_vec->resize(2 * SIZE);
+            }
+        }
+    };
+
+    void GenerateBatch(const toy_config& CONFIG, toy_batch* batch) {
+        const size_t N = batch->size;
+
+        // The random draws
+        for (size_t i = 0; i < N; ++i) {
+            event_stream stream(CONFIG.seed, batch->first_event + i);
+            double u[2];
+            stream.Uniforms(DRAW_ANGLES_Z, u);
+            batch->z_eta[i] = CONFIG.z_eta_max * (2. * u[0] - 1.);
+            batch->z_phi[i] = PI * (2. * u[1] - 1.);
+            stream.Uniforms(DRAW_ANGLES_E, u);
+            batch->e_theta[i] = PI * u[0];
+            batch->e_phi_rest[i] = PI * (2. * u[1] - 1.);
+            double n[2];
+            stream.Normals(DRAW_MASS, n);
+            batch->z_mass[i] = CONFIG.z_mass + CONFIG.z_width * n[0];
+            stream.Normals(DRAW_SMEAR_PT, &batch->smear_e_pt[2 * i]);
+            stream.Normals(DRAW_SMEAR_ETA, &batch->smear_e_eta[2 * i]);
+            stream.Normals(DRAW_SMEAR_PHI, &batch->smear_e_phi[2 * i]);
+            batch->z_pt[i] = CONFIG.pt_beta * Gamma(CONFIG.pt_alpha, &stream);
+        }
+
+        // The electrons back to back in the Z frame, boosted to the lab
+        for (size_t i = 0; i < N; ++i) {
+            const double M = batch->z_mass[i];
+            const double ETA_REST = -log(tan(batch->e_theta[i] / 2.));
+            const double PT_REST = (M / 2.) / cosh(ETA_REST);
+            double e0[4];
+            e0[1] = PT_REST * cos(batch->e_phi_rest[i]);
+            e0[2] = PT_REST * sin(batch->e_phi_rest[i]);
+            e0[3] = PT_REST * sinh(ETA_REST);
+            e0[0] = sqrt(e0[1] * e0[1] + e0[2] * e0[2] + e0[3] * e0[3] + E_MASS * E_MASS);
+            double e1[4] = {M - e0[0], -e0[1], -e0[2], -e0[3]};
+
+            const double Z_PX = batch->z_pt[i] * cos(batch->z_phi[i]);
+            const double Z_PY = batch->z_pt[i] * sin(batch->z_phi[i]);
+            const double Z_PZ = batch->z_pt[i] * sinh(batch->z_eta[i]);
+            const double Z_E = sqrt(Z_PX * Z_PX + Z_PY * Z_PY + Z_PZ * Z_PZ + M * M);
+            const double BETA[3] = {Z_PX / Z_E, Z_PY / Z_E, Z_PZ / Z_E};
+            Boost(BETA, e0);
+            Boost(BETA, e1);
+
+            const double* ELECTRONS[2] = {e0, e1};
+            for (int i_e = 0; i_e < 2; ++i_e) {
+                const double* E = ELECTRONS[i_e];
+                const double PT = sqrt(E[1] * E[1] + E[2] * E[2]);
+                batch->e_pt[2 * i + i_e] = PT;
+                batch->e_eta[2 * i + i_e] = asinh(E[3] / PT);
+                batch->e_phi[2 * i + i_e] = atan2(E[2], E[1]);
+            }
+        }
+
+        // Smearing; the smear arrays hold the normal numbers until here
+        for (size_t i = 0; i < 2 * N; ++i) {
+            batch->smear_e_pt[i] = batch->e_pt[i] * (1. + CONFIG.pt_smear * batch->smear_e_pt[i]);
+            batch->smear_e_eta[i] = batch->e_eta[i] * (1. + CONFIG.eta_smear * batch->smear_e_eta[i]);
+            batch->smear_e_phi[i] = batch->e_phi[i] * (1. + CONFIG.phi_smear * batch->smear_e_phi[i]);
+        }
+
+        // Phistar and the reco Z pt
+        for (size_t i = 0; i < N; ++i) {
+            const size_t I0 = 2 * i;
+            const size_t I1 = 2 * i + 1;
+            batch->phistar[i] = Phistar(batch->e_eta[I0], batch->e_phi[I0], batch->e_eta[I1], batch->e_phi[I1]);
+            batch->smear_phistar[i] = Phistar(batch->smear_e_eta[I0], batch->smear_e_phi[I0], batch->smear_e_eta[I1], batch->smear_e_phi[I1]);
+            const double PX = batch->smear_e_pt[I0] * cos(batch->smear_e_phi[I0]) + batch->smear_e_pt[I1] * cos(batch->smear_e_phi[I1]);
+            const double PY = batch->smear_e_pt[I0] * sin(batch->smear_e_phi[I0]) + batch->smear_e_pt[I1] * sin(batch->smear_e_phi[I1]);
+            batch->smear_z_pt[i] = sqrt(PX * PX + PY * PY);
+        }
+    }
+
+    /*
+     * The counts of a histogram, with the underflow in bin 0 and the
+     * overflow in bin N + 1 as in ROOT.
+     */
+    struct toy_histogram {
+        std::string name;
+        std::vector<double> edges;
+        std::vector<double> counts;
+
+        toy_histogram(const std::string& NAME, const std::vector<double>& EDGES) :
+            name(NAME),
+            edges(EDGES),
+            counts(EDGES.size() + 1, 0.) {}
+
+        void Fill(const double X) {
+            if (!(X >= edges.front())) {  // Also NaN
+                counts[0] += 1;
+                return;
+            }
+            counts[std::upper_bound(edges.begin(), edges.end(), X) - edges.begin()] += 1;
+        }
+    };
+
+    enum histogram_id {
+        UNSMEARED_PHISTAR = 0,
+        SMEARED_PHISTAR = 1,
+        UNSMEARED_PT = 2,
+        SMEARED_PT = 3,
+        N_HISTOGRAMS = 4
+    };
+
+    std::vector<toy_histogram> MakeHistograms() {
+        const std::vector<double> PHISTAR_EDGES(PHISTAR_BIN_EDGES, PHISTAR_BIN_EDGES + N_PHISTAR_BINS + 1);
+        std::vector<double> pt_edges;
+        for (int i = 0; i <= 100; ++i) {
+            pt_edges.push_back(i);
+        }
+        std::vector<toy_histogram> histograms;
+        histograms.push_back(toy_histogram("unsmeared_phistar", PHISTAR_EDGES));
+        histograms.push_back(toy_histogram("smeared_phistar", PHISTAR_EDGES));
+        histograms.push_back(toy_histogram("unsmeared_pt", pt_edges));
+        histograms.push_back(toy_histogram("smeared_pt", pt_edges));
+        return histograms;
+    }
+
+    void FillHistograms(const toy_batch& BATCH, std::vector<toy_histogram>* histograms) {
+        for (size_t i = 0; i < BATCH.size; ++i) {
+            (*histograms)[UNSMEARED_PHISTAR].Fill(BATCH.phistar[i]);
+            (*histograms)[SMEARED_PHISTAR].Fill(BATCH.smear_phistar[i]);
+            (*histograms)[UNSMEARED_PT].Fill(BATCH.z_pt[i]);
+            (*histograms)[SMEARED_PT].Fill(BATCH.smear_z_pt[i]);
+        }
+    }
+
+    void RunThread(const toy_config& CONFIG, toy_batch* batch, std::vector<toy_histogram>* histograms) {
+        GenerateBatch(CONFIG, batch);
+        FillHistograms(*batch, histograms);
+    }
+
+    // The columns of the columnar file
+    struct toy_columns {
+        int z_mass;
+        int z_pt;
+        int z_eta;
+        int z_phi;
+        int e_pt;
+        int e_eta;
+        int e_phi;
+        int phistar;
+        int reco_e_pt;
+        int reco_e_eta;
+        int reco_e_phi;
+        int reco_phistar;
+        int reco_z_pt;
+
+        explicit toy_columns(zf::ColumnarWriter* writer) :
+            z_mass(writer->AddColumn<double>("z_mass")),
+            z_pt(writer->AddColumn<double>("z_pt")),
+            z_eta(writer->AddColumn<double>("z_eta")),
+            z_phi(writer->AddColumn<double>("z_phi")),
+            e_pt(writer->AddColumn<double>("e_pt", 2)),
+            e_eta(writer->AddColumn<double>("e_eta", 2)),
+            e_phi(writer->AddColumn<double>("e_phi", 2)),
+            phistar(writer->AddColumn<double>("z_phistar")),
+            reco_e_pt(writer->AddColumn<double>("reco_e_pt", 2)),
+            reco_e_eta(writer->AddColumn<double>("reco_e_eta", 2)),
+            reco_e_phi(writer->AddColumn<double>("reco_e_phi", 2)),
+            reco_phistar(writer->AddColumn<double>("reco_z_phistar")),
+            reco_z_pt(writer->AddColumn<double>("reco_z_pt")) {}
+
+        void Append(const toy_batch& BATCH, zf::ColumnarWriter* writer) const {
+            for (size_t i = 0; i < BATCH.size; ++i) {
+                writer->Append(z_mass, BATCH.z_mass[i]);
+                writer->Append(z_pt, BATCH.z_pt[i]);
+                writer->Append(z_eta, BATCH.z_eta[i]);
+                writer->Append(z_phi, BATCH.z_phi[i]);
+                writer->Append(e_pt, &BATCH.e_pt[2 * i], 2);
+                writer->Append(e_eta, &BATCH.e_eta[2 * i], 2);
+                writer->Append(e_phi, &BATCH.e_phi[2 * i], 2);
+                writer->Append(phistar, BATCH.phistar[i]);
+                writer->Append(reco_e_pt, &BATCH.smear_e_pt[2 * i], 2);
+                writer->Append(reco_e_eta, &BATCH.smear_e_eta[2 * i], 2);
+                writer->Append(reco_e_phi, &BATCH.smear_e_phi[2 * i], 2);
+                writer->Append(reco_phistar, BATCH.smear_phistar[i]);
+                writer->Append(reco_z_pt, BATCH.smear_z_pt[i]);
+                writer->EndRow();
+            }
+        }
+    };
+
+    void WriteHistogram(const toy_histogram& HISTOGRAM, const uint64_t N_EVENTS) {
+        TH1D histo(HISTOGRAM.name.c_str(), HISTOGRAM.name.c_str(), HISTOGRAM.edges.size() - 1, &HISTOGRAM.edges[0]);
+        for (size_t i = 0; i < HISTOGRAM.counts.size(); ++i) {
+            histo.SetBinContent(i, HISTOGRAM.counts[i]);
+        }
+        histo.SetEntries(N_EVENTS);
+        histo.Write();
+    }
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    toy_config config;
+    uint64_t n_events = 1000000;
+    int n_threads = 4;
+    std::string columnar_file;
+    int arg = 1;
+    while (arg + 1 < argc && argv[arg][0] == '-') {
+        const std::string OPTION = argv[arg];
+        const std::string VALUE = argv[arg + 1];
+        if (OPTION == "-n") {
+            n_events = static_cast<uint64_t>(atof(VALUE.c_str()));  // Allows 1e7
+        }
+        else if (OPTION == "-s") {
+            config.seed = strtoull(VALUE.c_str(), nullptr, 10);
+        }
+        else if (OPTION == "-j") {
+            n_threads = atoi(VALUE.c_str());
+        }
+        else if (OPTION == "-m") {
+            config.z_mass = atof(VALUE.c_str());
+        }
+        else if (OPTION == "-w") {
+            config.z_width = atof(VALUE.c_str());
+        }
+        else if (OPTION == "-a") {
+            config.pt_alpha = atof(VALUE.c_str());
+        }
+        else if (OPTION == "-b") {
+            config.pt_beta = atof(VALUE.c_str());
+        }
+        else if (OPTION == "-e") {
+            config.z_eta_max = atof(VALUE.c_str());
+        }
+        else if (OPTION == "-p") {
+            config.pt_smear = atof(VALUE.c_str());
+        }
+        else if (OPTION == "-t") {
+            config.eta_smear = atof(VALUE.c_str());
+        }
+        else if (OPTION == "-f") {
+            config.phi_smear = atof(VALUE.c_str());
+        }
+        else if (OPTION == "-c") {
+            columnar_file = VALUE;
+        }
+        else {
+            std::cout << "Unknown option " << OPTION << std::endl;
+            return EXIT_FAILURE;
+        }
+        arg += 2;
+    }
+    if (argc - arg != 1 || n_threads < 1 || config.pt_alpha <= 0) {
+        std::cout << "Not enough arguments." << std::endl;
+        std::cout << "Usage: make_toys.exe [-n EVENTS] [-s SEED] [-j N] [-m MASS] [-w WIDTH] [-a ALPHA] [-b BETA] [-e ETA] [-p PT_SMEAR] [-t ETA_SMEAR] [-f PHI_SMEAR] [-c COLUMNAR_FILE] output.root" << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::string OUTPUT_FILE = argv[arg];
+
+    zf::ColumnarWriter* writer = nullptr;
+    toy_columns* columns = nullptr;
+    if (!columnar_file.empty()) {
+        writer = new zf::ColumnarWriter();
+        columns = new toy_columns(writer);
+    }
+
+    // Each thread generates one batch at a time into its own buffer and
+    // fills its own histograms
+    std::vector<toy_batch> batches(n_threads);
+    std::vector<std::vector<toy_histogram> > thread_histograms(n_threads, MakeHistograms());
+    uint64_t next_event = 0;
+    while (next_event < n_events) {
+        std::vector<std::thread> threads;
+        int n_running = 0;
+        for (int i = 0; i < n_threads && next_event < n_events; ++i) {
+            batches[i].first_event = next_event;
+            batches[i].Resize(std::min<uint64_t>(BATCH_SIZE, n_events - next_event));
+            next_event += batches[i].size;
+            threads.push_back(std::thread(RunThread, std::cref(config), &batches[i], &thread_histograms[i]));
+            ++n_running;
+        }
+        for (auto& i_thread : threads) {
+            i_thread.join();
+        }
+        if (writer) {
+            for (int i = 0; i < n_running; ++i) {
+                columns->Append(batches[i], writer);
+            }
+        }
+    }
+
+    // Add the counts of the threads; they are whole numbers, so the sums
+    // are exact
+    std::vector<toy_histogram> histograms = MakeHistograms();
+    for (auto& i_thread : thread_histograms) {
+        for (size_t i_histo = 0; i_histo < histograms.size(); ++i_histo) {
+            for (size_t i_bin = 0; i_bin < histograms[i_histo].counts.size(); ++i_bin) {
+                histograms[i_histo].counts[i_bin] += i_thread[i_histo].counts[i_bin];
+            }
+        }
+    }
+
+    TFile* out_file = new TFile(OUTPUT_FILE.c_str(), "RECREATE");
+    if (!out_file || out_file->IsZombie()) {
+        throw std::runtime_error("Can not open " + OUTPUT_FILE);
+    }
+    out_file->cd();
+    for (auto& i_histo : histograms) {
+        WriteHistogram(i_histo, n_events);
+    }
+    out_file->Close();
+    delete out_file;
+
+    if (writer) {
+        writer->Write(columnar_file);
+        delete columns;
+        delete writer;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -22,6 +22,7 @@ Implementation:
 #include <memory>
 
 // standard library files
+#include <cmath>  // fabs
 #include <vector>  // std::vector
 #include <iostream>  // std::cout, std::endl
 
@@ -37,28 +38,12 @@ Implementation:
 // CMSSW
 #include "CommonTools/UtilAlgos/interface/TFileService.h" // TFileService
 #include "DataFormats/Common/interface/Handle.h"  // edm::Handle
-#include "DataFormats/EgammaCandidates/interface/PhotonFwd.h"  // reco::PhotonCollection
-#include "DataFormats/EgammaReco/interface/HFEMClusterShape.h"  // reco::HFEMClusterShape
-#include "DataFormats/EgammaReco/interface/HFEMClusterShapeAssociation.h"  // reco::HFEMClusterShapeAssociationCollection
-#include "DataFormats/EgammaReco/interface/HFEMClusterShapeFwd.h"  // reco::HFEMClusterShapeRef,
-#include "DataFormats/EgammaReco/interface/SuperClusterFwd.h"  // reco::SuperClusterCollection, reco::SuperClusterRef
-#include "DataFormats/HLTReco/interface/TriggerEvent.h" // trigger::TriggerEvent
-#include "DataFormats/RecoCandidate/interface/RecoEcalCandidateFwd.h"  // reco::RecoEcalCandidateCollection
-#include "EgammaAnalysis/ElectronTools/interface/EGammaCutBasedEleId.h"  // EgammaCutBasedEleId::PassWP, EgammaCutBasedEleId::*
+#include "DataFormats/Math/interface/LorentzVector.h"  // math::PtEtaPhiMLorentzVector
 #include "FWCore/ServiceRegistry/interface/Service.h" // edm::Service
-#include "SimDataFormats/GeneratorProducts/interface/GenEventInfoProduct.h"  // GenEventInfoProduct
-#include "SimDataFormats/PileupSummaryInfo/interface/PileupSummaryInfo.h"  // PileupSummaryInfo
+#include "FWCore/Utilities/interface/InputTag.h"  // edm::InputTag
 
-// L1
-#include "DataFormats/L1Trigger/interface/L1EmParticle.h"  // l1extra::L1EmParticle
-#include "DataFormats/L1Trigger/interface/L1EmParticleFwd.h"  // l1extra::L1EmParticleCollection
-
-// Electrons
-#include "DataFormats/EgammaCandidates/interface/GsfElectron.h"  // GsfElectron
-
-// Pileup reweighting
-#include "PhysicsTools/Utilities/interface/LumiReWeighting.h"  // edm::LumiReWeighting
-#include "ZFinder/Event/interface/PileupReweighting.h"  // RUN_2012_*_TRUE_PILEUP, SUMMER12_53X_MC_TRUE_PILEUP
+// ZFinder
+#include "ZFinder/Event/interface/CompactZFinderEvent.h"  // CompactZFinderEvent, CompactElectron
 
 // Scale Factors
 #include "ZFinder/Event/interface/ZEfficiencies.h"
@@ -93,15 +78,13 @@ class TrigEff : public edm::EDAnalyzer {
         TH2D* numerator_fine_;
         TH2D* denominator_;
         TH2D* denominator_fine_;
-        edm::InputTag ecal_electron_;
-        edm::LumiReWeighting* lumi_weights_;
+        edm::InputTag zfinder_event_;
         zf::ZEfficiencies scale_factors_;
 
         double MIN_MASS_;
         double MAX_MASS_;
         double MAX_ETA_;
         double MIN_PT_;
-        double MAX_DR_;
 
 };
 
@@ -125,7 +108,6 @@ TrigEff::TrigEff(const edm::ParameterSet& iConfig) {
     MAX_MASS_ = 120.;
     MAX_ETA_ = 2.1;
     MIN_PT_ = 30;
-    MAX_DR_ = 0.3;
 
     // Bins for the 2D histogram
     //const std::vector<double> ETA_BINS = {0., 0.8, 1.442, 1.556, 2.0, 2.1};
@@ -147,19 +129,12 @@ TrigEff::TrigEff(const edm::ParameterSet& iConfig) {
     denominator_fine_->GetXaxis()->SetTitle("Probe p_{T}");
 
     // Get config variables
-    ecal_electron_ = iConfig.getParameter<edm::InputTag>("ecalElectronsInputTag");
-
-    // Lumi reweighting
-    lumi_weights_ = new edm::LumiReWeighting(
-            zf::SUMMER12_53X_MC_TRUE_PILEUP,  // MC distribution
-            zf::RUN_2012_ABCD_TRUE_PILEUP     // Data distribution
-            );
+    zfinder_event_ = iConfig.getParameter<edm::InputTag>("zfinderEventInputTag");
 }
 
 TrigEff::~TrigEff() {
     // do anything here that needs to be done at desctruction time
     // (e.g. close files, deallocate resources etc.)
-    delete lumi_weights_;
 }
 
 
@@ -169,99 +144,40 @@ TrigEff::~TrigEff() {
 
 // ------------ method called for each event  ------------
 void TrigEff::analyze(const edm::Event& iEvent, const edm::EventSetup& iSetup) {
-
-
+    // The electrons, their IDs, and their trigger matches are computed once
+    // by ZFinderEventProducer
+    edm::Handle<zf::CompactZFinderEvent> zfe_h;
+    iEvent.getByLabel(zfinder_event_, zfe_h);
+    const zf::CompactZFinderEvent& zfe = *zfe_h;
+
+    // The event weight includes the pileup reweighting and the natural
+    // weight of the MC event
     double weight = 1;
-    if (!iEvent.isRealData()) {
-        // Find the lumi reweighting weight and the natural weight
-        edm::Handle<std::vector<PileupSummaryInfo> > pileup_info;
-        iEvent.getByLabel("addPileupInfo", pileup_info);
-
-        // Lumi Weight
-        float true_number_of_pileup = -1.;
-        std::vector<PileupSummaryInfo>::const_iterator PILEUP_ELEMENT;
-        for(PILEUP_ELEMENT = pileup_info->begin(); PILEUP_ELEMENT != pileup_info->end(); ++PILEUP_ELEMENT) {
-            const int BUNCH_CROSSING = PILEUP_ELEMENT->getBunchCrossing();
-            if (BUNCH_CROSSING == 0) {
-                true_number_of_pileup = PILEUP_ELEMENT->getTrueNumInteractions();
-                break;
-            }
-        }
-        weight = lumi_weights_->weight(true_number_of_pileup);
-
-        // Natural weight
-        edm::Handle<GenEventInfoProduct> gen_event_info;
-        iEvent.getByLabel("generator", gen_event_info);
-        weight *= gen_event_info->weight();
+    if (!zfe.is_real_data && !zfe.weights.empty()) {
+        weight = zfe.weights[0];
     }
 
-    // Get 2 good GSF electrons
-    edm::Handle<reco::GsfElectronCollection> els_h;
-    //iEvent.getByLabel("CalibratedElectrons", "calibratedGsfElectrons", els_h);
-    iEvent.getByLabel(ecal_electron_, els_h);
-
-    // conversions
-    edm::Handle<reco::ConversionCollection> conversions_h;
-    iEvent.getByLabel("allConversions", conversions_h);
-
-    // iso deposits
-    edm::Handle< edm::ValueMap<double> > IsoDepositVals_CH;
-    edm::Handle< edm::ValueMap<double> > IsoDepositVals_EM;
-    edm::Handle< edm::ValueMap<double> > IsoDepositVals_NH;
-    iEvent.getByLabel("elPFIsoValueCharged03PFIdPFIso", IsoDepositVals_CH);
-    iEvent.getByLabel("elPFIsoValueGamma03PFIdPFIso", IsoDepositVals_EM);
-    iEvent.getByLabel("elPFIsoValueNeutral03PFIdPFIso", IsoDepositVals_NH);
-
-    // beam spot
-    edm::Handle<reco::BeamSpot> beamspot_h;
-    iEvent.getByLabel("offlineBeamSpot", beamspot_h);
-    const reco::BeamSpot &beamSpot = *(beamspot_h.product());
-
-    // vertices
-    edm::Handle<reco::VertexCollection> vtx_h;
-    iEvent.getByLabel("offlinePrimaryVertices", vtx_h);
-
-    // rho for isolation
-    // The python uses:
-    // cms.InputTag("kt6PFJetsForIsolation", "rho")
-    edm::Handle<double> rho_iso_h;
-    iEvent.getByLabel("kt6PFJetsForIsolation", "rho", rho_iso_h);
-    const double RHO_ISO = *(rho_iso_h.product());
-
-    // loop on electrons
-    std::vector<reco::GsfElectron> our_electrons;
-    for (unsigned int i = 0; i < els_h->size(); ++i) {
-        // Get the electron and set put it into the electrons vector
-        reco::GsfElectron electron = els_h->at(i);
-
+    // Use only tight GSF electrons
+    std::vector<const zf::CompactElectron*> our_electrons;
+    for (auto& i_elec : zfe.reco_electrons) {
         // Check the pt and eta
-        if (electron.pt() < MIN_PT_ || fabs(electron.eta()) > MAX_ETA_) {
+        if (i_elec.pt < MIN_PT_ || fabs(i_elec.eta) > MAX_ETA_) {
             continue;
         }
-
-        // get reference to electron and the electron
-        reco::GsfElectronRef ele_ref(els_h, i);
-
-        // get particle flow isolation
-        const double ISO_CH = (*IsoDepositVals_CH)[ele_ref];
-        const double ISO_EM = (*IsoDepositVals_EM)[ele_ref];
-        const double ISO_NH = (*IsoDepositVals_NH)[ele_ref];
-
-        // Check ID working points
-        const bool TIGHT = EgammaCutBasedEleId::PassWP(EgammaCutBasedEleId::TIGHT, ele_ref, conversions_h, beamSpot, vtx_h, ISO_CH, ISO_EM, ISO_NH, RHO_ISO);
-
-        // Use only tight electrons
-        if (TIGHT) {
-            our_electrons.push_back(electron);
+        if (i_elec.CutPassed("type_gsf") == 1 && i_elec.CutPassed("eg_tight") == 1) {
+            our_electrons.push_back(&i_elec);
         }
     }
 
     // Number of electrons, reject if 3 or more
     if (our_electrons.size() == 2) {
+        const zf::CompactElectron& e0 = *our_electrons[0];
+        const zf::CompactElectron& e1 = *our_electrons[1];
+
         // Reject if the mass is outside our window
         const double ELECTRON_MASS = 5.109989e-4;
-        math::PtEtaPhiMLorentzVector e0lv(our_electrons[0].pt(), our_electrons[0].eta(), our_electrons[0].phi(), ELECTRON_MASS);
-        math::PtEtaPhiMLorentzVector e1lv(our_electrons[1].pt(), our_electrons[1].eta(), our_electrons[1].phi(), ELECTRON_MASS);
+        math::PtEtaPhiMLorentzVector e0lv(e0.pt, e0.eta, e0.phi, ELECTRON_MASS);
+        math::PtEtaPhiMLorentzVector e1lv(e1.pt, e1.eta, e1.phi, ELECTRON_MASS);
         math::PtEtaPhiMLorentzVector zlv;
         zlv = e0lv + e1lv;
         const double MASS = zlv.mass();
@@ -271,64 +187,35 @@ void TrigEff::analyze(const edm::Event& iEvent, const edm::EventSetup& iSetup) {
         }
 
         // Apply GSF scale factors to MC
-        if (!iEvent.isRealData()) {
+        if (!zfe.is_real_data) {
             const std::string GSF_STR = "type_gsf";
-            weight *= scale_factors_.GetEfficiency(GSF_STR, our_electrons[0].pt(), our_electrons[0].eta());
-            weight *= scale_factors_.GetEfficiency(GSF_STR, our_electrons[1].pt(), our_electrons[1].eta());
+            weight *= scale_factors_.GetEfficiency(GSF_STR, e0.pt, e0.eta);
+            weight *= scale_factors_.GetEfficiency(GSF_STR, e1.pt, e1.eta);
             const std::string EG_TIGHT = "eg_tight";
-            weight *= scale_factors_.GetEfficiency(EG_TIGHT, our_electrons[0].pt(), our_electrons[0].eta());
-            weight *= scale_factors_.GetEfficiency(EG_TIGHT, our_electrons[1].pt(), our_electrons[1].eta());
-        }
-
-        // Check how many trigger objects we have
-        edm::InputTag hltTrigInfoTag("hltTriggerSummaryAOD","","HLT");
-        edm::Handle<trigger::TriggerEvent> trig_event;
-
-        iEvent.getByLabel(hltTrigInfoTag, trig_event);
-        if (!trig_event.isValid() ){
-            std::cout << "No valid hltTriggerSummaryAOD." << std::endl;
-            return;
+            weight *= scale_factors_.GetEfficiency(EG_TIGHT, e0.pt, e0.eta);
+            weight *= scale_factors_.GetEfficiency(EG_TIGHT, e1.pt, e1.eta);
         }
 
-        // Match the electrons to the HLT
-        bool match_hlt_0 = false;
-        bool match_hlt_1 = false;
-        int trig_size = 0;
-        edm::InputTag filter_tag("hltEle27WP80TrackIsoFilter", "", "HLT");
-        trigger::size_type filter_index = trig_event->filterIndex(filter_tag);
-        if(filter_index < trig_event->sizeFilters()) { // Check that the filter is in triggerEvent
-            const trigger::Keys& trig_keys = trig_event->filterKeys(filter_index);
-            //std::cout << "Size: " << trig_keys.size() << std::endl;
-            trig_size = trig_keys.size();
-            const trigger::TriggerObjectCollection& trig_obj_collection(trig_event->getObjects());
-            for (auto& i_key : trig_keys) {
-                const trigger::TriggerObject* trig_obj = &trig_obj_collection[i_key];
-                const double DR_0 = deltaR(our_electrons[0].eta(), our_electrons[0].phi(), trig_obj->eta(), trig_obj->phi());
-                if (DR_0 < MAX_DR_) {
-                    match_hlt_0 = true;
-                }
-                const double DR_1 = deltaR(our_electrons[1].eta(), our_electrons[1].phi(), trig_obj->eta(), trig_obj->phi());
-                if (DR_1 < MAX_DR_) {
-                    match_hlt_1 = true;
-                }
-            }
-        }
+        // Match the electrons to the HLT. trig(single_ele) is the match to
+        // hltEle27WP80TrackIsoFilter within dR < 0.3.
+        const bool match_hlt_0 = (e0.CutPassed("trig(single_ele)") == 1);
+        const bool match_hlt_1 = (e1.CutPassed("trig(single_ele)") == 1);
 
         // Fill historgrams
         if (match_hlt_0) {
-            denominator_->Fill(our_electrons[1].pt(), our_electrons[1].eta(), weight);
-            denominator_fine_->Fill(our_electrons[1].pt(), our_electrons[1].eta(), weight);
+            denominator_->Fill(e1.pt, e1.eta, weight);
+            denominator_fine_->Fill(e1.pt, e1.eta, weight);
             if (match_hlt_1) {
-                numerator_->Fill(our_electrons[1].pt(), our_electrons[1].eta(), weight);
-                numerator_fine_->Fill(our_electrons[1].pt(), our_electrons[1].eta(), weight);
+                numerator_->Fill(e1.pt, e1.eta, weight);
+                numerator_fine_->Fill(e1.pt, e1.eta, weight);
             }
         }
         if (match_hlt_1) {
-            denominator_->Fill(our_electrons[0].pt(), our_electrons[0].eta(), weight);
-            denominator_fine_->Fill(our_electrons[0].pt(), our_electrons[0].eta(), weight);
+            denominator_->Fill(e0.pt, e0.eta, weight);
+            denominator_fine_->Fill(e0.pt, e0.eta, weight);
             if (match_hlt_0) {
-                numerator_->Fill(our_electrons[0].pt(), our_electrons[0].eta(), weight);
-                numerator_fine_->Fill(our_electrons[0].pt(), our_electrons[0].eta(), weight);
+                numerator_->Fill(e0.pt, e0.eta, weight);
+                numerator_fine_->Fill(e0.pt, e0.eta, weight);
             }
         }
     }
@@ -64,9 +64,15 @@ from CommonTools.ParticleFlow.Tools.pfIsolation import setupPFElectronIso
 process.eleIsoSequence = setupPFElectronIso(process, 'CalibratedElectrons:calibratedGsfElectrons')
 process.pfiso = cms.Sequence(process.pfParticleSelectionSequence + process.eleIsoSequence)
 
+# Build the electrons and their IDs once; the analyzer reads them from the event
+from ZFinder.Event.zfinder_cfi import ZFinderEventProducer
+process.ZFinderEventProducer = ZFinderEventProducer.clone(
+        ecalElectronsInputTag = cms.InputTag("CalibratedElectrons", "calibratedGsfElectrons"),
+        )
+
 # My analyzer
 process.trigeff = cms.EDAnalyzer('TrigEff',
-        ecalElectronsInputTag = cms.InputTag("CalibratedElectrons", "calibratedGsfElectrons"),
+        zfinderEventInputTag = cms.InputTag("ZFinderEventProducer"),
         )
 
 process.p = cms.Path(
@@ -74,5 +80,6 @@ process.p = cms.Path(
         * process.eleRegressionEnergy
         * process.CalibratedElectrons
         * process.pfiso
+        * process.ZFinderEventProducer
         * process.trigeff
         )